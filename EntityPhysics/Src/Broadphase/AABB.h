@@ -0,0 +1,68 @@
+#pragma once
+#include <DirectXMath.h>
+#include <algorithm>
+
+
+struct AABB
+{
+    DirectX::XMFLOAT3 Min{ 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 Max{ 0.0f, 0.0f, 0.0f };
+
+    bool Overlaps(const AABB& other) const
+    {
+        return Min.x <= other.Max.x && Max.x >= other.Min.x &&
+            Min.y <= other.Max.y && Max.y >= other.Min.y &&
+            Min.z <= other.Max.z && Max.z >= other.Min.z;
+    }
+
+    float GetMin(int axis) const { return (&Min.x)[axis]; }
+    float GetMax(int axis) const { return (&Max.x)[axis]; }
+    float GetCenter(int axis) const { return 0.5f * (GetMin(axis) + GetMax(axis)); }
+
+    bool Contains(const AABB& other) const
+    {
+        return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z &&
+            Max.x >= other.Max.x && Max.y >= other.Max.y && Max.z >= other.Max.z;
+    }
+
+    //~ Half of the surface area, enough for comparing insertion costs
+    float GetPerimeter() const
+    {
+        const float dx = Max.x - Min.x;
+        const float dy = Max.y - Min.y;
+        const float dz = Max.z - Min.z;
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    AABB Fattened(float margin) const
+    {
+        AABB box;
+        box.Min = { Min.x - margin, Min.y - margin, Min.z - margin };
+        box.Max = { Max.x + margin, Max.y + margin, Max.z + margin };
+        return box;
+    }
+
+    static AABB Union(const AABB& a, const AABB& b)
+    {
+        AABB box;
+        box.Min = { (std::min)(a.Min.x, b.Min.x), (std::min)(a.Min.y, b.Min.y), (std::min)(a.Min.z, b.Min.z) };
+        box.Max = { (std::max)(a.Max.x, b.Max.x), (std::max)(a.Max.y, b.Max.y), (std::max)(a.Max.z, b.Max.z) };
+        return box;
+    }
+
+    // Bounds of the box [-localHalfExtents, +localHalfExtents] after being moved by 'world'
+    static AABB FromTransform(const DirectX::XMMATRIX& world, const DirectX::XMVECTOR& localHalfExtents)
+    {
+        using namespace DirectX;
+
+        const XMVECTOR center = world.r[3];
+        XMVECTOR extent = XMVectorAbs(XMVectorScale(world.r[0], XMVectorGetX(localHalfExtents)));
+        extent = XMVectorAdd(extent, XMVectorAbs(XMVectorScale(world.r[1], XMVectorGetY(localHalfExtents))));
+        extent = XMVectorAdd(extent, XMVectorAbs(XMVectorScale(world.r[2], XMVectorGetZ(localHalfExtents))));
+
+        AABB box;
+        XMStoreFloat3(&box.Min, XMVectorSubtract(center, extent));
+        XMStoreFloat3(&box.Max, XMVectorAdd(center, extent));
+        return box;
+    }
+};
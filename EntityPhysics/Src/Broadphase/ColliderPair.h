@@ -0,0 +1,10 @@
+#pragma once
+
+class ICollider;
+
+// Candidate pair reported by a broadphase, to be confirmed by the narrowphase
+struct ColliderPair
+{
+    ICollider* A{ nullptr };
+    ICollider* B{ nullptr };
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+
+
+// Which collider layers can touch which, one 32 bit row per layer (ICollider::GetLayer).
+// A pair collides only when both rows allow it, so the matrix stays symmetric however the
+// rows were filled in. Every layer collides with every layer by default.
+class CollisionMatrix
+{
+public:
+    static constexpr uint8_t LayerCount = 32;
+    static constexpr uint32_t AllLayers = 0xFFFFFFFFu;
+
+    bool ShouldCollide(uint8_t layerA, uint8_t layerB) const
+    {
+        return ((m_Rows[layerA] >> layerB) & (m_Rows[layerB] >> layerA) & 1u) != 0;
+    }
+
+    void SetCollision(uint8_t layerA, uint8_t layerB, bool collides)
+    {
+        if (layerA >= LayerCount || layerB >= LayerCount) return;
+
+        if (collides)
+        {
+            m_Rows[layerA] |= 1u << layerB;
+            m_Rows[layerB] |= 1u << layerA;
+        }
+        else
+        {
+            m_Rows[layerA] &= ~(1u << layerB);
+            m_Rows[layerB] &= ~(1u << layerA);
+        }
+    }
+
+    //~ Raw row, the layers 'layer' is willing to collide with
+    uint32_t GetRow(uint8_t layer) const { return layer < LayerCount ? m_Rows[layer] : 0u; }
+    void SetRow(uint8_t layer, uint32_t mask) { if (layer < LayerCount) m_Rows[layer] = mask; }
+
+    //~ Layers that actually collide with 'layer' (both rows agree)
+    uint32_t GetMask(uint8_t layer) const
+    {
+        uint32_t mask = 0;
+        for (uint8_t other = 0; other < LayerCount; ++other)
+        {
+            if (ShouldCollide(layer, other)) mask |= 1u << other;
+        }
+        return mask;
+    }
+
+    void Reset()
+    {
+        for (uint32_t& row : m_Rows) row = AllLayers;
+    }
+
+private:
+    uint32_t m_Rows[LayerCount]{
+        AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers,
+        AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers,
+        AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers,
+        AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers, AllLayers,
+    };
+};
@@ -0,0 +1,299 @@
+#include "pch.h"
+#include "DynamicAABBTree.h"
+#include "Collision/ICollider.h"
+
+#include <algorithm>
+
+
+DynamicAABBTree::DynamicAABBTree(float fatMargin)
+    : m_FatMargin(fatMargin)
+{}
+
+bool DynamicAABBTree::Insert(ICollider* collider, const AABB& bounds)
+{
+    if (!collider || m_ColliderToLeaf.contains(collider)) return false;
+
+    const int32_t leaf = AllocateNode();
+    Node& node = m_Nodes[leaf];
+    node.Collider = collider;
+    node.TightBounds = bounds;
+    node.FatBounds = bounds.Fattened(m_FatMargin);
+    node.Height = 0;
+
+    InsertLeaf(leaf);
+    m_ColliderToLeaf[collider] = leaf;
+    return true;
+}
+
+bool DynamicAABBTree::Remove(const ICollider* collider)
+{
+    const auto it = m_ColliderToLeaf.find(collider);
+    if (it == m_ColliderToLeaf.end()) return false;
+
+    const int32_t leaf = it->second;
+    m_ColliderToLeaf.erase(it);
+
+    RemoveLeaf(leaf);
+    FreeNode(leaf);
+    return true;
+}
+
+void DynamicAABBTree::Clear()
+{
+    m_Nodes.clear();
+    m_ColliderToLeaf.clear();
+    m_Root = NullNode;
+    m_FreeList = NullNode;
+}
+
+bool DynamicAABBTree::Update(const ICollider* collider, const AABB& bounds)
+{
+    const auto it = m_ColliderToLeaf.find(collider);
+    if (it == m_ColliderToLeaf.end()) return false;
+
+    Node& node = m_Nodes[it->second];
+    node.TightBounds = bounds;
+    if (node.FatBounds.Contains(bounds)) return false;
+
+    MoveLeaf(it->second, bounds);
+    return true;
+}
+
+void DynamicAABBTree::Refit()
+{
+    // Leaves keep their node index through a reinsert, so indexing the node
+    // array stays valid while internal nodes get recycled underneath
+    for (int32_t i = 0; i < static_cast<int32_t>(m_Nodes.size()); ++i)
+    {
+        Node& node = m_Nodes[i];
+        if (node.Height != 0) continue;
+
+        node.TightBounds = node.Collider->GetBroadphaseAABB();
+        if (node.FatBounds.Contains(node.TightBounds)) continue;
+
+        MoveLeaf(i, node.TightBounds);
+    }
+}
+
+int32_t DynamicAABBTree::GetHeight() const
+{
+    if (m_Root == NullNode) return 0;
+    return m_Nodes[m_Root].Height;
+}
+
+int32_t DynamicAABBTree::AllocateNode()
+{
+    if (m_FreeList == NullNode)
+    {
+        m_Nodes.emplace_back();
+        return static_cast<int32_t>(m_Nodes.size()) - 1;
+    }
+
+    const int32_t index = m_FreeList;
+    m_FreeList = m_Nodes[index].Parent;
+    m_Nodes[index] = Node{};
+    return index;
+}
+
+void DynamicAABBTree::FreeNode(int32_t node)
+{
+    m_Nodes[node] = Node{};
+    m_Nodes[node].Parent = m_FreeList;
+    m_FreeList = node;
+}
+
+void DynamicAABBTree::InsertLeaf(int32_t leaf)
+{
+    if (m_Root == NullNode)
+    {
+        m_Root = leaf;
+        m_Nodes[leaf].Parent = NullNode;
+        return;
+    }
+
+    // Walk down picking the child that grows the least (surface area heuristic)
+    const AABB leafBounds = m_Nodes[leaf].FatBounds;
+    int32_t index = m_Root;
+    while (!m_Nodes[index].IsLeaf())
+    {
+        const Node& node = m_Nodes[index];
+
+        const float area = node.FatBounds.GetPerimeter();
+        const float combinedArea = AABB::Union(node.FatBounds, leafBounds).GetPerimeter();
+
+        //~ Cost of creating a new parent for this node and the leaf
+        const float cost = 2.0f * combinedArea;
+
+        //~ Minimum cost of pushing the leaf further down
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child)
+        {
+            const Node& c = m_Nodes[child];
+            const float unionArea = AABB::Union(leafBounds, c.FatBounds).GetPerimeter();
+            if (c.IsLeaf()) return unionArea + inheritanceCost;
+            return (unionArea - c.FatBounds.GetPerimeter()) + inheritanceCost;
+        };
+
+        const float cost1 = descendCost(node.Child1);
+        const float cost2 = descendCost(node.Child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.Child1 : node.Child2;
+    }
+
+    const int32_t sibling = index;
+    const int32_t oldParent = m_Nodes[sibling].Parent;
+    const int32_t newParent = AllocateNode();
+
+    Node& parent = m_Nodes[newParent];
+    parent.Parent = oldParent;
+    parent.FatBounds = AABB::Union(leafBounds, m_Nodes[sibling].FatBounds);
+    parent.Height = m_Nodes[sibling].Height + 1;
+    parent.Child1 = sibling;
+    parent.Child2 = leaf;
+
+    if (oldParent != NullNode)
+    {
+        if (m_Nodes[oldParent].Child1 == sibling) m_Nodes[oldParent].Child1 = newParent;
+        else m_Nodes[oldParent].Child2 = newParent;
+    }
+    else
+    {
+        m_Root = newParent;
+    }
+    m_Nodes[sibling].Parent = newParent;
+    m_Nodes[leaf].Parent = newParent;
+
+    FixUpwards(m_Nodes[leaf].Parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == m_Root)
+    {
+        m_Root = NullNode;
+        return;
+    }
+
+    const int32_t parent = m_Nodes[leaf].Parent;
+    const int32_t grandParent = m_Nodes[parent].Parent;
+    const int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+    if (grandParent != NullNode)
+    {
+        //~ Splice the sibling into the parent's slot
+        if (m_Nodes[grandParent].Child1 == parent) m_Nodes[grandParent].Child1 = sibling;
+        else m_Nodes[grandParent].Child2 = sibling;
+        m_Nodes[sibling].Parent = grandParent;
+        FreeNode(parent);
+
+        FixUpwards(grandParent);
+    }
+    else
+    {
+        m_Root = sibling;
+        m_Nodes[sibling].Parent = NullNode;
+        FreeNode(parent);
+    }
+    m_Nodes[leaf].Parent = NullNode;
+}
+
+void DynamicAABBTree::MoveLeaf(int32_t leaf, const AABB& bounds)
+{
+    const AABB fatBounds = bounds.Fattened(m_FatMargin);
+
+    //~ Large jump, the old spot in the tree is meaningless now
+    if (!m_Nodes[leaf].FatBounds.Overlaps(fatBounds))
+    {
+        RemoveLeaf(leaf);
+        m_Nodes[leaf].FatBounds = fatBounds;
+        InsertLeaf(leaf);
+        return;
+    }
+
+    //~ Small move, grow the ancestors until one already encloses the leaf
+    m_Nodes[leaf].FatBounds = fatBounds;
+    int32_t index = m_Nodes[leaf].Parent;
+    while (index != NullNode)
+    {
+        Node& node = m_Nodes[index];
+        if (node.FatBounds.Contains(fatBounds)) break;
+
+        node.FatBounds = AABB::Union(m_Nodes[node.Child1].FatBounds, m_Nodes[node.Child2].FatBounds);
+        index = node.Parent;
+    }
+}
+
+void DynamicAABBTree::FixUpwards(int32_t node)
+{
+    int32_t index = node;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        Node& current = m_Nodes[index];
+        const Node& child1 = m_Nodes[current.Child1];
+        const Node& child2 = m_Nodes[current.Child2];
+
+        current.Height = 1 + (std::max)(child1.Height, child2.Height);
+        current.FatBounds = AABB::Union(child1.FatBounds, child2.FatBounds);
+
+        index = current.Parent;
+    }
+}
+
+// Rotates 'a' with its taller child when the two subtrees differ in height by more than one.
+// Returns the index of the node that now sits where 'a' was.
+int32_t DynamicAABBTree::Balance(int32_t a)
+{
+    Node& nodeA = m_Nodes[a];
+    if (nodeA.IsLeaf() || nodeA.Height < 2) return a;
+
+    const int32_t b = nodeA.Child1;
+    const int32_t c = nodeA.Child2;
+    const int32_t balance = m_Nodes[c].Height - m_Nodes[b].Height;
+
+    //~ Promote 'up' (child of a) and demote a under it; 'up' keeps its taller child
+    auto rotate = [&](int32_t up, int32_t stay)
+    {
+        Node& nodeUp = m_Nodes[up];
+        const int32_t f = nodeUp.Child1;
+        const int32_t g = nodeUp.Child2;
+
+        nodeUp.Child1 = a;
+        nodeUp.Parent = nodeA.Parent;
+        nodeA.Parent = up;
+
+        if (nodeUp.Parent != NullNode)
+        {
+            if (m_Nodes[nodeUp.Parent].Child1 == a) m_Nodes[nodeUp.Parent].Child1 = up;
+            else m_Nodes[nodeUp.Parent].Child2 = up;
+        }
+        else
+        {
+            m_Root = up;
+        }
+
+        const bool keepF = m_Nodes[f].Height > m_Nodes[g].Height;
+        const int32_t kept = keepF ? f : g;
+        const int32_t moved = keepF ? g : f;
+
+        nodeUp.Child2 = kept;
+        if (nodeA.Child1 == up) nodeA.Child1 = moved;
+        else nodeA.Child2 = moved;
+        m_Nodes[moved].Parent = a;
+
+        const Node& stayNode = m_Nodes[stay];
+        nodeA.FatBounds = AABB::Union(stayNode.FatBounds, m_Nodes[moved].FatBounds);
+        nodeA.Height = 1 + (std::max)(stayNode.Height, m_Nodes[moved].Height);
+
+        nodeUp.FatBounds = AABB::Union(nodeA.FatBounds, m_Nodes[kept].FatBounds);
+        nodeUp.Height = 1 + (std::max)(nodeA.Height, m_Nodes[kept].Height);
+        return up;
+    };
+
+    if (balance > 1) return rotate(c, b);
+    if (balance < -1) return rotate(b, c);
+    return a;
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "AABB.h"
+
+
+class ICollider;
+
+// Bounding volume hierarchy over collider bounds, keyed by ICollider*.
+// Leaves store a fattened copy of the collider bounds, so small movements do not touch
+// the tree at all. A leaf whose bounds escape its fat box is refit in place when the move
+// is small and reinserted otherwise; every structural change rebalances the ancestors
+// with tree rotations.
+class DynamicAABBTree
+{
+public:
+    static constexpr int32_t NullNode = -1;
+
+    explicit DynamicAABBTree(float fatMargin = 0.1f);
+    ~DynamicAABBTree() = default;
+
+    DynamicAABBTree(const DynamicAABBTree&) = delete;
+    DynamicAABBTree(DynamicAABBTree&&) = default;
+    DynamicAABBTree& operator=(const DynamicAABBTree&) = delete;
+    DynamicAABBTree& operator=(DynamicAABBTree&&) = default;
+
+    bool Insert(ICollider* collider, const AABB& bounds);
+    bool Remove(const ICollider* collider);
+    bool Contains(const ICollider* collider) const { return m_ColliderToLeaf.contains(collider); }
+    void Clear();
+
+    //~ Move a single leaf, returns true if the tree had to change
+    bool Update(const ICollider* collider, const AABB& bounds);
+
+    //~ Pull bounds from every leaf collider and refit the leaves that escaped their fat box
+    void Refit();
+
+    //~ Calls fn(ICollider*) for every leaf whose tight bounds overlap 'bounds'
+    template<typename Fn>
+    void Query(const AABB& bounds, Fn&& fn) const;
+
+    //~ Calls fn(ICollider*, ICollider*) once for every overlapping pair inside this tree
+    template<typename Fn>
+    void QuerySelfPairs(Fn&& fn) const;
+
+    //~ Calls fn(ICollider* mine, ICollider* theirs) for every overlap between the two trees
+    template<typename Fn>
+    void QueryPairs(const DynamicAABBTree& other, Fn&& fn) const;
+
+    template<typename Fn>
+    void ForEachLeaf(Fn&& fn) const;
+
+    size_t GetLeafCount() const { return m_ColliderToLeaf.size(); }
+    int32_t GetHeight() const;
+    float GetFatMargin() const { return m_FatMargin; }
+
+private:
+    struct Node
+    {
+        AABB FatBounds;
+        AABB TightBounds;
+        ICollider* Collider{ nullptr };
+        int32_t Parent{ NullNode };     //~ next free node while on the free list
+        int32_t Child1{ NullNode };
+        int32_t Child2{ NullNode };
+        int32_t Height{ -1 };           //~ -1 = free, 0 = leaf
+
+        bool IsLeaf() const { return Child1 == NullNode; }
+    };
+
+    // Traversal stack that only touches the heap for degenerate trees
+    template<typename T>
+    class TraversalStack
+    {
+    public:
+        void Push(const T& value)
+        {
+            if (m_Count < m_Inline.size()) m_Inline[m_Count] = value;
+            else m_Overflow.push_back(value);
+            ++m_Count;
+        }
+
+        T Pop()
+        {
+            --m_Count;
+            if (m_Count < m_Inline.size()) return m_Inline[m_Count];
+            const T value = m_Overflow.back();
+            m_Overflow.pop_back();
+            return value;
+        }
+
+        bool IsEmpty() const { return m_Count == 0; }
+
+    private:
+        std::array<T, 128> m_Inline;
+        std::vector<T> m_Overflow{};
+        size_t m_Count{ 0 };
+    };
+
+    struct NodePair
+    {
+        int32_t A;
+        int32_t B;
+    };
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t node);
+
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    void MoveLeaf(int32_t leaf, const AABB& bounds);
+
+    int32_t Balance(int32_t node);
+    void FixUpwards(int32_t node);
+
+    template<typename Fn>
+    void QueryNodes(const AABB& bounds, Fn&& fn) const;
+
+    template<typename Fn>
+    void QueryNodePairs(const DynamicAABBTree& other, int32_t rootA, int32_t rootB, Fn&& fn) const;
+
+private:
+    std::vector<Node> m_Nodes{};
+    int32_t m_Root{ NullNode };
+    int32_t m_FreeList{ NullNode };
+    std::unordered_map<const ICollider*, int32_t> m_ColliderToLeaf{};
+    float m_FatMargin;
+};
+
+template <typename Fn>
+void DynamicAABBTree::QueryNodes(const AABB& bounds, Fn&& fn) const
+{
+    if (m_Root == NullNode) return;
+
+    TraversalStack<int32_t> stack;
+    stack.Push(m_Root);
+    while (!stack.IsEmpty())
+    {
+        const int32_t index = stack.Pop();
+        const Node& node = m_Nodes[index];
+        if (!node.FatBounds.Overlaps(bounds)) continue;
+
+        if (node.IsLeaf())
+        {
+            if (node.TightBounds.Overlaps(bounds)) fn(index);
+            continue;
+        }
+        stack.Push(node.Child1);
+        stack.Push(node.Child2);
+    }
+}
+
+template <typename Fn>
+void DynamicAABBTree::Query(const AABB& bounds, Fn&& fn) const
+{
+    QueryNodes(bounds, [&](int32_t leaf) { fn(m_Nodes[leaf].Collider); });
+}
+
+// Descends both hierarchies at once so whole subtrees that are apart get rejected with a
+// single box test. rootA == rootB walks a tree against itself, reporting each pair once.
+template <typename Fn>
+void DynamicAABBTree::QueryNodePairs(const DynamicAABBTree& other, int32_t rootA, int32_t rootB, Fn&& fn) const
+{
+    if (rootA == NullNode || rootB == NullNode) return;
+    const bool isSelf = this == &other;
+
+    TraversalStack<NodePair> stack;
+    stack.Push({ rootA, rootB });
+    while (!stack.IsEmpty())
+    {
+        const NodePair pair = stack.Pop();
+        const Node& a = m_Nodes[pair.A];
+        const Node& b = other.m_Nodes[pair.B];
+
+        if (isSelf && pair.A == pair.B)
+        {
+            if (a.IsLeaf()) continue;
+            stack.Push({ a.Child1, a.Child1 });
+            stack.Push({ a.Child2, a.Child2 });
+            stack.Push({ a.Child1, a.Child2 });
+            continue;
+        }
+
+        if (!a.FatBounds.Overlaps(b.FatBounds)) continue;
+
+        if (a.IsLeaf() && b.IsLeaf())
+        {
+            if (a.TightBounds.Overlaps(b.TightBounds)) fn(a.Collider, b.Collider);
+            continue;
+        }
+
+        //~ Split the bigger node (or the only internal one)
+        if (b.IsLeaf() || (!a.IsLeaf() && a.FatBounds.GetPerimeter() >= b.FatBounds.GetPerimeter()))
+        {
+            stack.Push({ a.Child1, pair.B });
+            stack.Push({ a.Child2, pair.B });
+        }
+        else
+        {
+            stack.Push({ pair.A, b.Child1 });
+            stack.Push({ pair.A, b.Child2 });
+        }
+    }
+}
+
+template <typename Fn>
+void DynamicAABBTree::QuerySelfPairs(Fn&& fn) const
+{
+    QueryNodePairs(*this, m_Root, m_Root, fn);
+}
+
+template <typename Fn>
+void DynamicAABBTree::QueryPairs(const DynamicAABBTree& other, Fn&& fn) const
+{
+    QueryNodePairs(other, m_Root, other.m_Root, fn);
+}
+
+template <typename Fn>
+void DynamicAABBTree::ForEachLeaf(Fn&& fn) const
+{
+    for (const Node& node : m_Nodes)
+    {
+        if (node.Height == 0) fn(node.Collider);
+    }
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "DynamicTreeBroadphase.h"
+#include "Collision/ICollider.h"
+
+
+DynamicTreeBroadphase::DynamicTreeBroadphase(float fatMargin)
+    : m_StaticTree(0.0f), m_DynamicTree(fatMargin)
+{}
+
+bool DynamicTreeBroadphase::AddCollider(ICollider* collider)
+{
+    if (!collider) return false;
+    if (m_StaticTree.Contains(collider) || m_DynamicTree.Contains(collider)) return false;
+
+    if (IsStatic(collider)) return m_StaticTree.Insert(collider, collider->GetBroadphaseAABB());
+    return m_DynamicTree.Insert(collider, collider->GetBroadphaseAABB());
+}
+
+bool DynamicTreeBroadphase::RemoveCollider(const ICollider* collider)
+{
+    if (m_DynamicTree.Remove(collider)) return true;
+    return m_StaticTree.Remove(collider);
+}
+
+void DynamicTreeBroadphase::Clear()
+{
+    m_StaticTree.Clear();
+    m_DynamicTree.Clear();
+    m_StateChanged.clear();
+}
+
+void DynamicTreeBroadphase::Update()
+{
+    m_StateChanged.clear();
+    m_StaticTree.ForEachLeaf([this](ICollider* collider)
+    {
+        if (!IsStatic(collider)) m_StateChanged.push_back(collider);
+    });
+    m_DynamicTree.ForEachLeaf([this](ICollider* collider)
+    {
+        if (IsStatic(collider)) m_StateChanged.push_back(collider);
+    });
+
+    for (ICollider* collider : m_StateChanged)
+    {
+        RemoveCollider(collider);
+        AddCollider(collider);
+    }
+
+    m_DynamicTree.Refit();
+}
+
+void DynamicTreeBroadphase::FindOverlappingPairs(std::vector<ColliderPair>& outPairs) const
+{
+    outPairs.clear();
+
+    m_DynamicTree.QuerySelfPairs([this, &outPairs](ICollider* a, ICollider* b)
+    {
+        if (ShouldCollide(a, b)) outPairs.push_back({ a, b });
+    });
+
+    m_DynamicTree.QueryPairs(m_StaticTree, [this, &outPairs](ICollider* dynamicCollider, ICollider* staticCollider)
+    {
+        if (ShouldCollide(dynamicCollider, staticCollider)) outPairs.push_back({ dynamicCollider, staticCollider });
+    });
+}
+
+void DynamicTreeBroadphase::QueryAABB(const AABB& bounds, std::vector<ICollider*>& outColliders) const
+{
+    outColliders.clear();
+
+    auto collect = [&outColliders](ICollider* collider) { outColliders.push_back(collider); };
+    m_StaticTree.Query(bounds, collect);
+    m_DynamicTree.Query(bounds, collect);
+}
+
+size_t DynamicTreeBroadphase::GetProxyCount() const
+{
+    return m_StaticTree.GetLeafCount() + m_DynamicTree.GetLeafCount();
+}
+
+bool DynamicTreeBroadphase::IsStatic(const ICollider* collider)
+{
+    return collider->GetColliderState() == ColliderState::Static;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+
+#include "DynamicAABBTree.h"
+#include "IBroadphase.h"
+
+
+// Broadphase over two bounding volume hierarchies.
+// Static colliders live in their own tree that is built once and never refit, dynamic
+// colliders (and triggers) live in a tree that is refit every update. Pairs are found by
+// querying the dynamic tree against itself and against the static tree, so static vs
+// static and static vs far away dynamic work never happens.
+class DynamicTreeBroadphase final : public IBroadphase
+{
+public:
+    explicit DynamicTreeBroadphase(float fatMargin = 0.1f);
+    ~DynamicTreeBroadphase() override = default;
+
+    DynamicTreeBroadphase(const DynamicTreeBroadphase&) = delete;
+    DynamicTreeBroadphase(DynamicTreeBroadphase&&) = default;
+    DynamicTreeBroadphase& operator=(const DynamicTreeBroadphase&) = delete;
+    DynamicTreeBroadphase& operator=(DynamicTreeBroadphase&&) = default;
+
+    bool AddCollider(ICollider* collider) override;
+    bool RemoveCollider(const ICollider* collider) override;
+    void Clear() override;
+
+    //~ Moves colliders whose state changed between the trees, then refits the dynamic tree
+    void Update() override;
+
+    void FindOverlappingPairs(std::vector<ColliderPair>& outPairs) const override;
+    void QueryAABB(const AABB& bounds, std::vector<ICollider*>& outColliders) const override;
+
+    size_t GetProxyCount() const override;
+
+    const DynamicAABBTree& GetStaticTree() const { return m_StaticTree; }
+    const DynamicAABBTree& GetDynamicTree() const { return m_DynamicTree; }
+
+private:
+    static bool IsStatic(const ICollider* collider);
+
+private:
+    DynamicAABBTree m_StaticTree;
+    DynamicAABBTree m_DynamicTree;
+    std::vector<ICollider*> m_StateChanged{};
+};
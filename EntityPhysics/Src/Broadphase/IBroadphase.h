@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "AABB.h"
+#include "ColliderPair.h"
+#include "CollisionMatrix.h"
+#include "Collision/ICollider.h"
+
+static_assert(CollisionMatrix::LayerCount == ICollider::LayerCount);
+
+
+enum class BroadphaseType : uint8_t
+{
+    SweepAndPrune,
+    DynamicTree,
+};
+
+// Culls collider pairs whose world bounds are apart before the narrowphase sees them
+class IBroadphase
+{
+public:
+    IBroadphase() = default;
+    virtual ~IBroadphase() = default;
+
+    IBroadphase(const IBroadphase&) = delete;
+    IBroadphase(IBroadphase&&) = default;
+    IBroadphase& operator=(const IBroadphase&) = delete;
+    IBroadphase& operator=(IBroadphase&&) = default;
+
+    virtual bool AddCollider(ICollider* collider)           = 0;
+    virtual bool RemoveCollider(const ICollider* collider)  = 0;
+    virtual void Clear()                                    = 0;
+
+    //~ Pull the latest bounds from the colliders
+    virtual void Update()                                   = 0;
+
+    //~ Every pair whose bounds overlap (static vs static pairs, and pairs of layers the
+    //~ collision matrix keeps apart, are skipped)
+    virtual void FindOverlappingPairs(std::vector<ColliderPair>& outPairs) const = 0;
+
+    //~ Every collider whose bounds overlap 'bounds', as of the last Update
+    virtual void QueryAABB(const AABB& bounds, std::vector<ICollider*>& outColliders) const = 0;
+
+    virtual size_t GetProxyCount() const                    = 0;
+
+    void SetCollisionMatrix(const CollisionMatrix& matrix) { m_CollisionMatrix = matrix; }
+    const CollisionMatrix& GetCollisionMatrix() const { return m_CollisionMatrix; }
+
+    //~ Layer filter, applied to every pair before it leaves the broadphase
+    bool ShouldCollide(const ICollider* a, const ICollider* b) const
+    {
+        return m_CollisionMatrix.ShouldCollide(a->GetLayer(), b->GetLayer());
+    }
+
+protected:
+    CollisionMatrix m_CollisionMatrix{};
+};
@@ -0,0 +1,282 @@
+#include "pch.h"
+#include "SweepAndPrune.h"
+#include "Collision/ICollider.h"
+
+#include <algorithm>
+#include <ranges>
+
+
+bool SweepAndPrune::AddCollider(ICollider* collider)
+{
+    if (!collider || m_ColliderToHandle.contains(collider)) return false;
+
+    uint32_t index;
+    if (!m_FreeHandles.empty())
+    {
+        index = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Handles.size());
+        m_Handles.emplace_back();
+    }
+
+    Handle& handle = m_Handles[index];
+    handle.Collider = collider;
+    handle.Bounds = collider->GetBroadphaseAABB();
+    handle.IsStatic = collider->GetColliderState() == ColliderState::Static;
+    m_ColliderToHandle[collider] = index;
+
+    // Inserting one by one would swap past O(n) endpoints each time, so batch
+    // additions into a single sort + sweep on the next update
+    m_NeedsRebuild = true;
+    return true;
+}
+
+bool SweepAndPrune::RemoveCollider(const ICollider* collider)
+{
+    const auto it = m_ColliderToHandle.find(collider);
+    if (it == m_ColliderToHandle.end()) return false;
+
+    const uint32_t index = it->second;
+    m_ColliderToHandle.erase(it);
+
+    RemovePairsOf(index);
+    for (auto& endpoints : m_Endpoints)
+    {
+        std::erase_if(endpoints, [index](const Endpoint& e) { return e.HandleIndex == index; });
+    }
+
+    m_Handles[index].Collider = nullptr;
+    m_FreeHandles.push_back(index);
+    return true;
+}
+
+void SweepAndPrune::Clear()
+{
+    m_Handles.clear();
+    m_FreeHandles.clear();
+    m_ColliderToHandle.clear();
+    for (auto& endpoints : m_Endpoints) endpoints.clear();
+    m_Pairs.clear();
+    m_PairLookup.clear();
+    m_NeedsRebuild = false;
+    m_LastSwapCount = 0;
+}
+
+void SweepAndPrune::Update()
+{
+    RefreshBounds();
+
+    if (m_NeedsRebuild)
+    {
+        RebuildFromScratch();
+        m_NeedsRebuild = false;
+        return;
+    }
+
+    m_LastSwapCount = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        SortAxis(axis);
+    }
+}
+
+void SweepAndPrune::FindOverlappingPairs(std::vector<ColliderPair>& outPairs) const
+{
+    outPairs.clear();
+    outPairs.reserve(m_Pairs.size());
+
+    for (const PairEntry& pair : m_Pairs)
+    {
+        const Handle& a = m_Handles[pair.HandleA];
+        const Handle& b = m_Handles[pair.HandleB];
+
+        // A collider may have been switched to static after the pair was created, and layers
+        // are filtered here rather than in CanPair so changing them needs no rebuild
+        if (a.IsStatic && b.IsStatic) continue;
+        if (!ShouldCollide(a.Collider, b.Collider)) continue;
+
+        outPairs.push_back({ a.Collider, b.Collider });
+    }
+}
+
+void SweepAndPrune::QueryAABB(const AABB& bounds, std::vector<ICollider*>& outColliders) const
+{
+    outColliders.clear();
+
+    for (const Handle& handle : m_Handles)
+    {
+        if (handle.Collider && handle.Bounds.Overlaps(bounds)) outColliders.push_back(handle.Collider);
+    }
+}
+
+void SweepAndPrune::RefreshBounds()
+{
+    for (Handle& handle : m_Handles)
+    {
+        if (!handle.Collider) continue;
+        handle.Bounds = handle.Collider->GetBroadphaseAABB();
+        handle.IsStatic = handle.Collider->GetColliderState() == ColliderState::Static;
+    }
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (Endpoint& endpoint : m_Endpoints[axis])
+        {
+            const AABB& bounds = m_Handles[endpoint.HandleIndex].Bounds;
+            endpoint.Value = endpoint.IsMax ? bounds.GetMax(axis) : bounds.GetMin(axis);
+        }
+    }
+}
+
+void SweepAndPrune::RebuildFromScratch()
+{
+    m_Pairs.clear();
+    m_PairLookup.clear();
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        auto& endpoints = m_Endpoints[axis];
+        endpoints.clear();
+        endpoints.reserve(m_ColliderToHandle.size() * 2);
+
+        for (const uint32_t index : m_ColliderToHandle | std::views::values)
+        {
+            const AABB& bounds = m_Handles[index].Bounds;
+            endpoints.push_back({ bounds.GetMin(axis), index, false });
+            endpoints.push_back({ bounds.GetMax(axis), index, true });
+        }
+        std::ranges::sort(endpoints, IsBefore);
+    }
+
+    // One classic sweep along X seeds the pair set, later frames only patch it
+    std::vector<uint32_t> active;
+    std::vector<uint32_t> activeSlot(m_Handles.size(), 0);
+
+    for (const Endpoint& endpoint : m_Endpoints[0])
+    {
+        const uint32_t index = endpoint.HandleIndex;
+        if (endpoint.IsMax)
+        {
+            // swap-remove from the active list
+            const uint32_t slot = activeSlot[index];
+            const uint32_t last = active.back();
+            active[slot] = last;
+            activeSlot[last] = slot;
+            active.pop_back();
+            continue;
+        }
+
+        const AABB& bounds = m_Handles[index].Bounds;
+        for (const uint32_t other : active)
+        {
+            if (CanPair(index, other) && bounds.Overlaps(m_Handles[other].Bounds))
+            {
+                AddPair(index, other);
+            }
+        }
+        activeSlot[index] = static_cast<uint32_t>(active.size());
+        active.push_back(index);
+    }
+    m_LastSwapCount = 0;
+}
+
+void SweepAndPrune::SortAxis(int axis)
+{
+    auto& endpoints = m_Endpoints[axis];
+
+    for (size_t i = 1; i < endpoints.size(); ++i)
+    {
+        if (!IsBefore(endpoints[i], endpoints[i - 1])) continue;
+
+        const Endpoint moving = endpoints[i];
+        size_t j = i;
+
+        while (j > 0 && IsBefore(moving, endpoints[j - 1]))
+        {
+            const Endpoint& passed = endpoints[j - 1];
+            ++m_LastSwapCount;
+
+            if (!moving.IsMax && passed.IsMax)
+            {
+                // min slid below another max: the pair may have started overlapping
+                const AABB& a = m_Handles[moving.HandleIndex].Bounds;
+                const AABB& b = m_Handles[passed.HandleIndex].Bounds;
+                if (CanPair(moving.HandleIndex, passed.HandleIndex) && a.Overlaps(b))
+                {
+                    AddPair(moving.HandleIndex, passed.HandleIndex);
+                }
+            }
+            else if (moving.IsMax && !passed.IsMax)
+            {
+                // max slid below another min: the pair is separated on this axis
+                RemovePair(moving.HandleIndex, passed.HandleIndex);
+            }
+
+            endpoints[j] = passed;
+            --j;
+        }
+        endpoints[j] = moving;
+    }
+}
+
+bool SweepAndPrune::CanPair(uint32_t a, uint32_t b) const
+{
+    if (a == b) return false;
+    return !(m_Handles[a].IsStatic && m_Handles[b].IsStatic);
+}
+
+void SweepAndPrune::AddPair(uint32_t a, uint32_t b)
+{
+    const uint64_t key = MakePairKey(a, b);
+    if (m_PairLookup.contains(key)) return;
+
+    m_PairLookup[key] = static_cast<uint32_t>(m_Pairs.size());
+    m_Pairs.push_back({ a, b });
+}
+
+void SweepAndPrune::RemovePair(uint32_t a, uint32_t b)
+{
+    const auto it = m_PairLookup.find(MakePairKey(a, b));
+    if (it == m_PairLookup.end()) return;
+
+    const uint32_t slot = it->second;
+    m_PairLookup.erase(it);
+
+    const uint32_t last = static_cast<uint32_t>(m_Pairs.size() - 1);
+    if (slot != last)
+    {
+        m_Pairs[slot] = m_Pairs[last];
+        m_PairLookup[MakePairKey(m_Pairs[slot].HandleA, m_Pairs[slot].HandleB)] = slot;
+    }
+    m_Pairs.pop_back();
+}
+
+void SweepAndPrune::RemovePairsOf(uint32_t handle)
+{
+    for (size_t i = 0; i < m_Pairs.size();)
+    {
+        const PairEntry pair = m_Pairs[i];
+        if (pair.HandleA == handle || pair.HandleB == handle)
+        {
+            RemovePair(pair.HandleA, pair.HandleB); // swaps a new pair into slot i
+            continue;
+        }
+        ++i;
+    }
+}
+
+uint64_t SweepAndPrune::MakePairKey(uint32_t a, uint32_t b)
+{
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+bool SweepAndPrune::IsBefore(const Endpoint& a, const Endpoint& b)
+{
+    // On ties mins go first so touching boxes count as overlapping (matches AABB::Overlaps)
+    if (a.Value != b.Value) return a.Value < b.Value;
+    return !a.IsMax && b.IsMax;
+}
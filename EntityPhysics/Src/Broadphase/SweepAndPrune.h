@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "AABB.h"
+#include "IBroadphase.h"
+
+
+class ICollider;
+
+// Incremental sweep-and-prune over the world AABBs of the registered colliders.
+// Each axis keeps a sorted list of min/max endpoints that persists between frames, so a
+// frame only costs an insertion sort over an almost ordered array. Overlapping pairs are
+// added/removed when a min endpoint crosses a max endpoint, which means the pair set is
+// maintained from the swaps instead of being recomputed by a sweep every frame.
+class SweepAndPrune final : public IBroadphase
+{
+public:
+    SweepAndPrune() = default;
+    ~SweepAndPrune() override = default;
+
+    SweepAndPrune(const SweepAndPrune&) = delete;
+    SweepAndPrune(SweepAndPrune&&) = default;
+    SweepAndPrune& operator=(const SweepAndPrune&) = delete;
+    SweepAndPrune& operator=(SweepAndPrune&&) = default;
+
+    bool AddCollider(ICollider* collider) override;
+    bool RemoveCollider(const ICollider* collider) override;
+    void Clear() override;
+
+    //~ Refresh bounds from the colliders and restore the sort order (updates the pair set)
+    void Update() override;
+
+    void FindOverlappingPairs(std::vector<ColliderPair>& outPairs) const override;
+
+    //~ Linear scan over the proxies, meant for the occasional query rather than every pair
+    void QueryAABB(const AABB& bounds, std::vector<ICollider*>& outColliders) const override;
+
+    size_t GetProxyCount() const override { return m_ColliderToHandle.size(); }
+    size_t GetPairCount() const { return m_Pairs.size(); }
+    size_t GetLastSwapCount() const { return m_LastSwapCount; }
+
+private:
+    struct Handle
+    {
+        AABB Bounds;
+        ICollider* Collider;
+        bool IsStatic;
+    };
+
+    struct Endpoint
+    {
+        float Value;
+        uint32_t HandleIndex;
+        bool IsMax;
+    };
+
+    struct PairEntry
+    {
+        uint32_t HandleA;
+        uint32_t HandleB;
+    };
+
+    void RefreshBounds();
+    void RebuildFromScratch();
+    void SortAxis(int axis);
+
+    bool CanPair(uint32_t a, uint32_t b) const;
+    void AddPair(uint32_t a, uint32_t b);
+    void RemovePair(uint32_t a, uint32_t b);
+    void RemovePairsOf(uint32_t handle);
+
+    static uint64_t MakePairKey(uint32_t a, uint32_t b);
+    static bool IsBefore(const Endpoint& a, const Endpoint& b);
+
+private:
+    std::vector<Handle> m_Handles{};
+    std::vector<uint32_t> m_FreeHandles{};
+    std::unordered_map<const ICollider*, uint32_t> m_ColliderToHandle{};
+
+    std::vector<Endpoint> m_Endpoints[3]{};
+
+    std::vector<PairEntry> m_Pairs{};
+    std::unordered_map<uint64_t, uint32_t> m_PairLookup{};
+
+    bool m_NeedsRebuild{ false };
+    size_t m_LastSwapCount{ 0 };
+};
@@ -0,0 +1,231 @@
+#include "pch.h"
+#include "CapsuleCollider.h"
+#include "Collision/Contact.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/Sphere/SphereCollider.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+CapsuleCollider::CapsuleCollider(RigidBody* body)
+    : ICollider(body, ColliderType::Capsule)
+{
+    UpdateInertia();
+}
+
+void CapsuleCollider::SetScale(const DirectX::XMVECTOR& vector)
+{
+    using namespace DirectX;
+
+    m_Scale = vector;
+    XMFLOAT3 scale; XMStoreFloat3(&scale, XMVectorAbs(m_Scale));
+    m_Radius = (std::max)(scale.x, scale.z);
+    m_HalfSegment = (std::max)(scale.y - m_Radius, 0.0f);
+    UpdateInertia();
+}
+
+DirectX::XMVECTOR CapsuleCollider::GetScale() const
+{
+    return m_Scale;
+}
+
+void CapsuleCollider::SetDimensions(float radius, float halfSegment)
+{
+    SetScale(DirectX::XMVectorSet(radius, halfSegment + radius, radius, 0.0f));
+}
+
+AABB CapsuleCollider::GetWorldAABB() const
+{
+    using namespace DirectX;
+
+    XMVECTOR start, end;
+    GetSegment(start, end);
+    const XMVECTOR radius = XMVectorReplicate(m_Radius);
+
+    AABB box;
+    XMStoreFloat3(&box.Min, XMVectorSubtract(XMVectorMin(start, end), radius));
+    XMStoreFloat3(&box.Max, XMVectorAdd(XMVectorMax(start, end), radius));
+    return box;
+}
+
+void CapsuleCollider::GetSegment(DirectX::XMVECTOR& outStart, DirectX::XMVECTOR& outEnd) const
+{
+    using namespace DirectX;
+
+    const XMVECTOR center = m_RigidBody->GetPosition();
+    const XMVECTOR up = XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), m_RigidBody->GetOrientation().ToXmVector());
+    const XMVECTOR offset = XMVectorScale(up, m_HalfSegment);
+
+    outStart = XMVectorSubtract(center, offset);
+    outEnd = XMVectorAdd(center, offset);
+}
+
+void CapsuleCollider::UpdateInertia()
+{
+    m_RigidBody->ComputeInverseInertiaTensorCapsule(m_Radius, 2.0f * m_HalfSegment);
+}
+
+bool CapsuleCollider::CollideCapsuleSphere(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    //~ The dispatch table only sends (capsule, sphere) here
+    const CapsuleCollider* A = static_cast<const CapsuleCollider*>(a);
+    const SphereCollider* B = static_cast<const SphereCollider*>(b);
+
+    XMVECTOR start, end;
+    A->GetSegment(start, end);
+    const XMVECTOR centerB = B->GetCenter();
+    const XMVECTOR closest = ClosestPointOnSegment(centerB, start, end);
+
+    Contact contact;
+    if (!SphereCollider::CollideSpherePoints(a, b, closest, A->GetRadius(), centerB, B->GetRadius(),
+        XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), 0, contact, outManifold.SpeculativeMargin))
+    {
+        return false;
+    }
+    outManifold.AddPoint(contact);
+    return true;
+}
+
+// Two contacts when the segments run side by side (so a capsule can lie on another one),
+// otherwise the single pair of closest points
+bool CapsuleCollider::CollideCapsules(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    //~ The dispatch table only sends capsules here
+    const CapsuleCollider* A = static_cast<const CapsuleCollider*>(a);
+    const CapsuleCollider* B = static_cast<const CapsuleCollider*>(b);
+
+    XMVECTOR startA, endA, startB, endB;
+    A->GetSegment(startA, endA);
+    B->GetSegment(startB, endB);
+
+    const XMVECTOR directionA = XMVectorSubtract(endA, startA);
+    const XMVECTOR directionB = XMVectorSubtract(endB, startB);
+    const float lengthA = XMVectorGetX(XMVector3Length(directionA));
+    const float lengthB = XMVectorGetX(XMVector3Length(directionB));
+    const XMVECTOR fallback = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+
+    if (lengthA > 1e-4f && lengthB > 1e-4f)
+    {
+        const XMVECTOR axisA = XMVectorScale(directionA, 1.0f / lengthA);
+        const XMVECTOR axisB = XMVectorScale(directionB, 1.0f / lengthB);
+        const float sinSq = XMVectorGetX(XMVector3LengthSq(XMVector3Cross(axisA, axisB)));
+
+        if (sinSq < 1e-4f)
+        {
+            //~ Overlap of B's segment with A's, measured along A
+            const float t0 = XMVectorGetX(XMVector3Dot(XMVectorSubtract(startB, startA), axisA));
+            const float t1 = XMVectorGetX(XMVector3Dot(XMVectorSubtract(endB, startA), axisA));
+            const float lower = (std::max)((std::min)(t0, t1), 0.0f);
+            const float upper = (std::min)((std::max)(t0, t1), lengthA);
+
+            if (upper - lower > 1e-3f)
+            {
+                const float ends[2] = { lower, upper };
+                for (uint32_t i = 0; i < 2; ++i)
+                {
+                    const XMVECTOR pointA = XMVectorAdd(startA, XMVectorScale(axisA, ends[i]));
+                    const XMVECTOR pointB = ClosestPointOnSegment(pointA, startB, endB);
+
+                    Contact contact;
+                    if (SphereCollider::CollideSpherePoints(a, b, pointA, A->GetRadius(), pointB, B->GetRadius(),
+                        fallback, i + 1, contact, outManifold.SpeculativeMargin))
+                    {
+                        outManifold.AddPoint(contact);
+                    }
+                }
+                return outManifold.PointCount > 0;
+            }
+        }
+    }
+
+    XMVECTOR pointA, pointB;
+    ClosestPointsBetweenSegments(startA, endA, startB, endB, pointA, pointB);
+
+    Contact contact;
+    if (!SphereCollider::CollideSpherePoints(a, b, pointA, A->GetRadius(), pointB, B->GetRadius(), fallback, 0, contact,
+        outManifold.SpeculativeMargin))
+    {
+        return false;
+    }
+    outManifold.AddPoint(contact);
+    return true;
+}
+
+DirectX::XMVECTOR CapsuleCollider::ClosestPointOnSegment(const DirectX::XMVECTOR& point,
+    const DirectX::XMVECTOR& start, const DirectX::XMVECTOR& end)
+{
+    using namespace DirectX;
+
+    const XMVECTOR direction = XMVectorSubtract(end, start);
+    const float lengthSq = XMVectorGetX(XMVector3LengthSq(direction));
+    if (lengthSq < 1e-12f) return start;
+
+    float t = XMVectorGetX(XMVector3Dot(XMVectorSubtract(point, start), direction)) / lengthSq;
+    t = std::clamp(t, 0.0f, 1.0f);
+    return XMVectorAdd(start, XMVectorScale(direction, t));
+}
+
+// Real-Time Collision Detection (Ericson), 5.1.9
+void CapsuleCollider::ClosestPointsBetweenSegments(
+    const DirectX::XMVECTOR& startA, const DirectX::XMVECTOR& endA,
+    const DirectX::XMVECTOR& startB, const DirectX::XMVECTOR& endB,
+    DirectX::XMVECTOR& outPointA, DirectX::XMVECTOR& outPointB)
+{
+    using namespace DirectX;
+
+    const XMVECTOR d1 = XMVectorSubtract(endA, startA);
+    const XMVECTOR d2 = XMVectorSubtract(endB, startB);
+    const XMVECTOR r = XMVectorSubtract(startA, startB);
+    const float a = XMVectorGetX(XMVector3LengthSq(d1));
+    const float e = XMVectorGetX(XMVector3LengthSq(d2));
+    const float f = XMVectorGetX(XMVector3Dot(d2, r));
+    constexpr float epsilon = 1e-12f;
+
+    float s = 0.0f;
+    float t = 0.0f;
+
+    if (a <= epsilon && e <= epsilon)
+    {
+        //~ Both segments are points
+    }
+    else if (a <= epsilon)
+    {
+        t = std::clamp(f / e, 0.0f, 1.0f);
+    }
+    else
+    {
+        const float c = XMVectorGetX(XMVector3Dot(d1, r));
+        if (e <= epsilon)
+        {
+            s = std::clamp(-c / a, 0.0f, 1.0f);
+        }
+        else
+        {
+            const float b = XMVectorGetX(XMVector3Dot(d1, d2));
+            const float denom = a * e - b * b;
+
+            //~ Parallel segments pick any s, 0 is as good as any
+            if (denom > epsilon) s = std::clamp((b * f - c * e) / denom, 0.0f, 1.0f);
+
+            t = (b * s + f) / e;
+            if (t < 0.0f)
+            {
+                t = 0.0f;
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            }
+            else if (t > 1.0f)
+            {
+                t = 1.0f;
+                s = std::clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+
+    outPointA = XMVectorAdd(startA, XMVectorScale(d1, s));
+    outPointB = XMVectorAdd(startB, XMVectorScale(d2, t));
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Collision/ICollider.h"
+
+
+// Capsule along the local Y axis of the body. The scale is the half extent of the box the
+// capsule fits in: the radius is the larger of scale x and z, and the segment between the
+// two cap centres is what is left of scale y.
+class CapsuleCollider final : public ICollider
+{
+public:
+	CapsuleCollider(RigidBody* body);
+	~CapsuleCollider() override = default;
+
+	CapsuleCollider(const CapsuleCollider&) = default;
+	CapsuleCollider(CapsuleCollider&&) = default;
+	CapsuleCollider& operator=(const CapsuleCollider&) = default;
+	CapsuleCollider& operator=(CapsuleCollider&&) = default;
+
+	//~ Collision Interface
+	void SetScale(const DirectX::XMVECTOR& vector) override;
+	DirectX::XMVECTOR GetScale() const override;
+	AABB GetWorldAABB() const override;
+
+	//~ CollisionDispatcher table entries
+	static bool CollideCapsules(ICollider* a, ICollider* b, ContactManifold& outManifold);
+	static bool CollideCapsuleSphere(ICollider* a, ICollider* b, ContactManifold& outManifold);
+
+	//~ Capsule Specifics
+	void SetDimensions(float radius, float halfSegment);
+	float GetRadius() const { return m_Radius; }
+	float GetHalfSegment() const { return m_HalfSegment; }
+	void GetSegment(DirectX::XMVECTOR& outStart, DirectX::XMVECTOR& outEnd) const;
+
+	//~ Helpers
+	static DirectX::XMVECTOR ClosestPointOnSegment(const DirectX::XMVECTOR& point,
+		const DirectX::XMVECTOR& start, const DirectX::XMVECTOR& end);
+	static void ClosestPointsBetweenSegments(
+		const DirectX::XMVECTOR& startA, const DirectX::XMVECTOR& endA,
+		const DirectX::XMVECTOR& startB, const DirectX::XMVECTOR& endB,
+		DirectX::XMVECTOR& outPointA, DirectX::XMVECTOR& outPointB);
+
+private:
+	void UpdateInertia();
+
+private:
+	DirectX::XMVECTOR m_Scale{ 0.5f, 1.0f, 0.5f };
+	float m_Radius{ 0.5f };
+	float m_HalfSegment{ 0.5f };
+};
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "CollisionDispatcher.h"
+#include "ContactManifold.h"
+#include "Capsule/CapsuleCollider.h"
+#include "Cube/CubeCollider.h"
+#include "Plane/PlaneCollider.h"
+#include "Sphere/SphereCollider.h"
+
+#include <array>
+
+
+namespace
+{
+    using ManifoldFn = CollisionDispatcher::ManifoldFn;
+
+    constexpr size_t TypeCount = static_cast<size_t>(ColliderType::Count);
+    using DispatchTable = std::array<std::array<ManifoldFn, TypeCount>, TypeCount>;
+
+    template<ManifoldFn Fn>
+    bool Swapped(ICollider* a, ICollider* b, ContactManifold& outManifold)
+    {
+        outManifold.Reset(b, a);
+        const bool touching = Fn(b, a, outManifold);
+        outManifold.Flip();
+        return touching;
+    }
+
+    template<ColliderType A, ColliderType B, ManifoldFn Fn>
+    constexpr void Register(DispatchTable& table)
+    {
+        table[static_cast<size_t>(A)][static_cast<size_t>(B)] = Fn;
+        if constexpr (A != B)
+        {
+            table[static_cast<size_t>(B)][static_cast<size_t>(A)] = &Swapped<Fn>;
+        }
+    }
+
+    //~ One line per pair of types, the mirrored entry comes for free.
+    //~ Plane vs plane has no entry, two infinite planes never resolve to anything useful.
+    constexpr DispatchTable BuildTable()
+    {
+        DispatchTable table{};
+        Register<ColliderType::Cube, ColliderType::Cube, &CubeCollider::CollideCubes>(table);
+        Register<ColliderType::Cube, ColliderType::Sphere, &CubeCollider::CollideCubeSphere>(table);
+        Register<ColliderType::Cube, ColliderType::Capsule, &CubeCollider::CollideCubeCapsule>(table);
+        Register<ColliderType::Cube, ColliderType::Plane, &CubeCollider::CollideCubePlane>(table);
+        Register<ColliderType::Sphere, ColliderType::Sphere, &SphereCollider::CollideSpheres>(table);
+        Register<ColliderType::Capsule, ColliderType::Sphere, &CapsuleCollider::CollideCapsuleSphere>(table);
+        Register<ColliderType::Capsule, ColliderType::Capsule, &CapsuleCollider::CollideCapsules>(table);
+        Register<ColliderType::Plane, ColliderType::Sphere, &PlaneCollider::CollidePlaneSphere>(table);
+        Register<ColliderType::Plane, ColliderType::Capsule, &PlaneCollider::CollidePlaneCapsule>(table);
+        return table;
+    }
+
+    constexpr DispatchTable Table = BuildTable();
+}
+
+bool CollisionDispatcher::GenerateManifold(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    outManifold.Reset(a, b);
+    if (!a || !b) return false;
+    if (a->IsImmovable() && b->IsImmovable()) return false;
+
+    const ManifoldFn fn = Table[static_cast<size_t>(a->GetColliderType())][static_cast<size_t>(b->GetColliderType())];
+    if (!fn) return false;
+    return fn(a, b, outManifold);
+}
+
+bool CollisionDispatcher::HasHandler(ColliderType a, ColliderType b)
+{
+    return Table[static_cast<size_t>(a)][static_cast<size_t>(b)] != nullptr;
+}
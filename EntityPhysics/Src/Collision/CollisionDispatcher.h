@@ -0,0 +1,18 @@
+#pragma once
+#include "ICollider.h"
+
+
+// Narrowphase entry point for one collider pair.
+// Every pair of ColliderTypes has one function in a table that is built at compile time.
+// Registering (A, B) also fills (B, A) with a wrapper that swaps the colliders and flips the
+// manifold, so a pair costs one indexed load and one direct call: no RTTI, no virtual call.
+class CollisionDispatcher
+{
+public:
+    using ManifoldFn = bool(*)(ICollider* a, ICollider* b, ContactManifold& outManifold);
+
+    //~ Resets 'outManifold' to (a, b) and fills it, false when the pair does not touch
+    static bool GenerateManifold(ICollider* a, ICollider* b, ContactManifold& outManifold);
+
+    static bool HasHandler(ColliderType a, ColliderType b);
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <DirectXMath.h>
 #include "ICollider.h"
 
@@ -7,7 +8,7 @@ struct Contact
     DirectX::XMFLOAT3 ContactPoint;
     // Normal pointing from Body[0] to Body[1]
     DirectX::XMFLOAT3 ContactNormal;
-    // How deep the objects are penetrating
+    // How deep the objects are penetrating, negative for a speculative point (minus the gap)
     float PenetrationDepth = 0.0f;
     // Colliders involved
     ICollider* Colliders[2]{ nullptr, nullptr };
@@ -16,4 +17,11 @@ struct Contact
     float Friction = 0.5f;
     float Elasticity = 1.0f;
     float NormalImpulseMagnitude = 0.0f;
+    // Accumulated friction impulse along the two tangents of ContactNormal
+    float TangentImpulseMagnitude[2]{ 0.0f, 0.0f };
+    // Which pair of features produced the point (0 = unknown). Points that share neither this
+    // nor their position with last step split the impulses of the points that went away.
+    uint32_t FeatureId = 0;
+    // ContactPoint in Body[0] space, used to recognise the point again next step
+    DirectX::XMFLOAT3 LocalPoint{ 0.0f, 0.0f, 0.0f };
 };
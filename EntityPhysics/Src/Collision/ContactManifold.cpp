@@ -0,0 +1,96 @@
+#include "pch.h"
+#include "ContactManifold.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+
+namespace
+{
+    constexpr float DepthTolerance = 0.02f;
+}
+
+void ContactManifold::AddReduced(const Contact* candidates, uint32_t count)
+{
+    using namespace DirectX;
+
+    if (count <= MaxPoints)
+    {
+        for (uint32_t i = 0; i < count; ++i) AddPoint(candidates[i]);
+        return;
+    }
+
+    auto point = [&](uint32_t i) { return XMLoadFloat3(&candidates[i].ContactPoint); };
+    const XMVECTOR normal = XMLoadFloat3(&candidates[0].ContactNormal);
+
+    //~ 1. Deepest point, it carries most of the load. Resting faces have almost equal depths, so
+    //~ among the near deepest the lowest feature wins, or the kept points would swap every step
+    //~ and lose their warm start.
+    float maxDepth = candidates[0].PenetrationDepth;
+    for (uint32_t i = 1; i < count; ++i) maxDepth = (std::max)(maxDepth, candidates[i].PenetrationDepth);
+
+    uint32_t first = count;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (candidates[i].PenetrationDepth < maxDepth - DepthTolerance) continue;
+        if (first == count || candidates[i].FeatureId < candidates[first].FeatureId) first = i;
+    }
+
+    //~ 2. Farthest from the first
+    uint32_t second = first;
+    float best = -1.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float distSq = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(point(i), point(first))));
+        if (distSq > best) { best = distSq; second = i; }
+    }
+
+    //~ 3. Largest triangle with the first two, keeping the winding around the normal
+    const XMVECTOR p0 = point(first);
+    const XMVECTOR p1 = point(second);
+    uint32_t third = first;
+    float bestArea = 0.0f;
+    float winding = 1.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const XMVECTOR cross = XMVector3Cross(XMVectorSubtract(p0, point(i)), XMVectorSubtract(p1, point(i)));
+        const float area = XMVectorGetX(XMVector3Dot(cross, normal));
+        if (fabsf(area) > fabsf(bestArea)) { bestArea = area; third = i; }
+    }
+    if (bestArea < 0.0f) winding = -1.0f;
+
+    //~ 4. The point that adds the most area on the far side of the triangle edges
+    const XMVECTOR p2 = point(third);
+    const XMVECTOR triangle[3] = { p0, p1, p2 };
+    uint32_t fourth = first;
+    float bestGain = 0.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (i == first || i == second || i == third) continue;
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            const XMVECTOR a = triangle[edge];
+            const XMVECTOR b = triangle[(edge + 1) % 3];
+            const XMVECTOR cross = XMVector3Cross(XMVectorSubtract(a, point(i)), XMVectorSubtract(b, point(i)));
+            const float gain = -winding * XMVectorGetX(XMVector3Dot(cross, normal));
+            if (gain > bestGain) { bestGain = gain; fourth = i; }
+        }
+    }
+
+    AddPoint(candidates[first]);
+    if (second != first) AddPoint(candidates[second]);
+    if (third != first && third != second) AddPoint(candidates[third]);
+    if (fourth != first && fourth != second && fourth != third) AddPoint(candidates[fourth]);
+}
+
+void ContactManifold::Flip()
+{
+    std::swap(Colliders[0], Colliders[1]);
+    for (uint32_t i = 0; i < PointCount; ++i)
+    {
+        Contact& point = Points[i];
+        std::swap(point.Colliders[0], point.Colliders[1]);
+        point.ContactNormal = { -point.ContactNormal.x, -point.ContactNormal.y, -point.ContactNormal.z };
+    }
+}
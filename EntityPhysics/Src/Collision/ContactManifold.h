@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include "Contact.h"
+
+
+// Up to four contact points shared by one collider pair. Every point uses the same normal;
+// the accumulated impulses stored in each Contact survive from one step to the next through
+// ContactManifoldCache, which is what lets the solver warm start.
+struct ContactManifold
+{
+    static constexpr uint32_t MaxPoints = 4;
+    static constexpr uint8_t NoAxis = 0xFF;
+
+    ICollider* Colliders[2]{ nullptr, nullptr };
+    Contact Points[MaxPoints]{};
+    uint32_t PointCount{ 0 };
+
+    //~ Box vs box SAT hint, survives Reset: in = the axis that separated the pair last step,
+    //~ out = the axis that separates it now (NoAxis while touching)
+    uint8_t SeparatingAxis{ NoAxis };
+
+    //~ In, survives Reset: how far apart the pair may still be and get points. Points closer than
+    //~ this but not touching are speculative, their PenetrationDepth is minus the gap.
+    float SpeculativeMargin{ 0.0f };
+
+    void Reset(ICollider* a, ICollider* b)
+    {
+        Colliders[0] = a;
+        Colliders[1] = b;
+        PointCount = 0;
+    }
+
+    //~ Returns false once the manifold is full
+    bool AddPoint(const Contact& contact)
+    {
+        if (PointCount >= MaxPoints) return false;
+        Points[PointCount++] = contact;
+        return true;
+    }
+
+    //~ Keeps the deepest point plus the three that span the largest area
+    void AddReduced(const Contact* candidates, uint32_t count);
+
+    //~ Swaps the two colliders, so every normal turns around to keep pointing from [0] to [1]
+    void Flip();
+};
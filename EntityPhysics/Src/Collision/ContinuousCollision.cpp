@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "ContinuousCollision.h"
+#include "ContactManifold.h"
+#include "Broadphase/IBroadphase.h"
+#include "Capsule/CapsuleCollider.h"
+#include "Cube/CubeCollider.h"
+#include "Sphere/SphereCollider.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+void ContinuousCollision::Track(ICollider* collider)
+{
+    if (!collider || collider->GetColliderState() != ColliderState::Dynamic) return;
+
+    RigidBody* body = collider->GetRigidBody();
+    if (!body->IsContinuousCollision() || body->IsKinematic() || !body->IsSimulated() || body->GetRestingState()) return;
+
+    Sweep sweep{ collider };
+    DirectX::XMStoreFloat3(&sweep.Start, body->GetPosition());
+    m_Sweeps.push_back(sweep);
+}
+
+uint32_t ContinuousCollision::Resolve(const IBroadphase& broadphase)
+{
+    using namespace DirectX;
+
+    uint32_t stopped = 0;
+    for (const Sweep& sweep : m_Sweeps)
+    {
+        ICollider* collider = sweep.Collider;
+        RigidBody* body = collider->GetRigidBody();
+
+        const XMVECTOR start = XMLoadFloat3(&sweep.Start);
+        const XMVECTOR end = body->GetPosition();
+        const XMVECTOR motion = XMVectorSubtract(end, start);
+        const float distance = XMVectorGetX(XMVector3Length(motion));
+        const float thickness = GetMinHalfExtent(collider);
+
+        //~ Moved less than its own half thickness, the discrete step cannot have missed anything
+        if (thickness <= 0.0f || distance <= thickness) continue;
+
+        //~ Bounds over the whole motion (the orientation is the integrated one throughout)
+        const AABB endBounds = collider->GetWorldAABB();
+        AABB startBounds = endBounds;
+        XMStoreFloat3(&startBounds.Min, XMVectorSubtract(XMLoadFloat3(&endBounds.Min), motion));
+        XMStoreFloat3(&startBounds.Max, XMVectorSubtract(XMLoadFloat3(&endBounds.Max), motion));
+        broadphase.QueryAABB(AABB::Union(startBounds, endBounds), m_Candidates);
+
+        //~ Whatever already touches at the start is the discrete narrowphase's business,
+        //~ sweeping against it would pin a body sliding along the floor where it started
+        body->SetPosition(start);
+        std::erase_if(m_Candidates, [collider, body, &broadphase](ICollider* other)
+        {
+            if (other == collider || other->GetRigidBody() == body) return true;
+            if (other->GetColliderState() == ColliderState::Trigger) return true;
+            if (!broadphase.ShouldCollide(collider, other)) return true;
+
+            ContactManifold manifold;
+            return collider->GenerateManifold(other, manifold);
+        });
+
+        float timeOfImpact = 1.0f;
+        if (!m_Candidates.empty())
+        {
+            const uint32_t samples = (std::min)(MaxSamples, static_cast<uint32_t>(std::ceil(distance / thickness)));
+            timeOfImpact = FindTimeOfImpact(collider, start, motion, samples);
+        }
+
+        body->SetPosition(XMVectorMultiplyAdd(motion, XMVectorReplicate(timeOfImpact), start));
+        if (timeOfImpact < 1.0f) ++stopped;
+    }
+
+    m_Sweeps.clear();
+    return stopped;
+}
+
+void ContinuousCollision::Clear()
+{
+    m_Sweeps.clear();
+    m_Candidates.clear();
+}
+
+float ContinuousCollision::GetMinHalfExtent(const ICollider* collider)
+{
+    using namespace DirectX;
+
+    switch (collider->GetColliderType())
+    {
+    case ColliderType::Cube:
+    {
+        XMFLOAT3 halfExtents;
+        XMStoreFloat3(&halfExtents, static_cast<const CubeCollider*>(collider)->GetHalfExtents());
+        return (std::min)({ halfExtents.x, halfExtents.y, halfExtents.z });
+    }
+    case ColliderType::Sphere:  return static_cast<const SphereCollider*>(collider)->GetRadius();
+    case ColliderType::Capsule: return static_cast<const CapsuleCollider*>(collider)->GetRadius();
+    default:                    return 0.0f;    //~ planes do not move through anything
+    }
+}
+
+float ContinuousCollision::FindTimeOfImpact(ICollider* collider, const DirectX::XMVECTOR& start,
+    const DirectX::XMVECTOR& motion, uint32_t samples) const
+{
+    using namespace DirectX;
+
+    RigidBody* body = collider->GetRigidBody();
+    auto touchesAt = [&](float t)
+    {
+        body->SetPosition(XMVectorMultiplyAdd(motion, XMVectorReplicate(t), start));
+        return TouchesCandidate(collider);
+    };
+
+    float free = 0.0f;
+    float hit = 1.0f;
+    bool found = false;
+    for (uint32_t i = 1; i <= samples && !found; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(samples);
+        if (touchesAt(t))
+        {
+            hit = t;
+            found = true;
+        }
+        else free = t;
+    }
+    if (!found) return 1.0f;
+
+    //~ Narrow the bracket but stay on the touching side, so the narrowphase sees the contact
+    for (uint32_t i = 0; i < BisectionSteps; ++i)
+    {
+        const float mid = 0.5f * (free + hit);
+        if (touchesAt(mid)) hit = mid;
+        else free = mid;
+    }
+    return hit;
+}
+
+bool ContinuousCollision::TouchesCandidate(ICollider* collider) const
+{
+    for (ICollider* other : m_Candidates)
+    {
+        ContactManifold manifold;
+        if (collider->GenerateManifold(other, manifold)) return true;
+    }
+    return false;
+}
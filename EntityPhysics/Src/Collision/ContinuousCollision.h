@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "ICollider.h"
+
+class IBroadphase;
+
+
+// Opt-in continuous collision for fast bodies (RigidBody::SetContinuousCollision).
+// Track records where a flagged body starts the step. After integration, Resolve grows its
+// bounds over the whole motion, asks the broadphase what that swept box touches and samples
+// the motion in steps no longer than the body is thick, then bisects down to the first
+// time of impact. The body is put back at that time, just touching, so the regular
+// narrowphase and solver handle the contact this step instead of the body passing through.
+// Only the translation is swept; the body keeps its integrated orientation throughout.
+class ContinuousCollision
+{
+public:
+    static constexpr uint32_t MaxSamples = 64;
+    static constexpr uint32_t BisectionSteps = 8;
+
+    //~ Call before integrating, ignores colliders whose body did not ask for CCD
+    void Track(ICollider* collider);
+
+    //~ Sweeps every tracked collider to its integrated pose and forgets them.
+    //~ Returns how many bodies were stopped at a time of impact.
+    uint32_t Resolve(const IBroadphase& broadphase);
+
+    void Clear();
+
+    size_t GetTrackedCount() const { return m_Sweeps.size(); }
+
+    //~ Half of the thinnest dimension, the longest move that cannot skip over anything
+    static float GetMinHalfExtent(const ICollider* collider);
+
+private:
+    struct Sweep
+    {
+        ICollider* Collider{ nullptr };
+        DirectX::XMFLOAT3 Start{ 0.0f, 0.0f, 0.0f };
+    };
+
+    //~ Fraction of 'motion' (0..1] where the collider first touches a candidate, 1 when it never does
+    float FindTimeOfImpact(ICollider* collider, const DirectX::XMVECTOR& start,
+        const DirectX::XMVECTOR& motion, uint32_t samples) const;
+    bool TouchesCandidate(ICollider* collider) const;
+
+private:
+    std::vector<Sweep> m_Sweeps{};
+    std::vector<ICollider*> m_Candidates{};
+};
@@ -1,43 +1,308 @@
 #include "pch.h"
 #include "CubeCollider.h"
 #include "Collision/Contact.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/Capsule/CapsuleCollider.h"
+#include "Collision/Plane/PlaneCollider.h"
+#include "Collision/Sphere/SphereCollider.h"
 
 #include <algorithm>
 #include <cmath>
 
 
+namespace
+{
+    //~ Per thread so the narrowphase workers never share the counter
+    thread_local uint64_t t_AxesTested = 0;
+}
+
 CubeCollider::CubeCollider(RigidBody* body)
-    : ICollider(body)
+    : ICollider(body, ColliderType::Cube)
 {
-    DirectX::XMFLOAT3 scale; DirectX::XMStoreFloat3(&scale, m_Scale);
-    m_RigidBody->ComputeInverseInertiaTensorBox(scale.x, scale.y, scale.z);
+    UpdateInertia();
 }
 
-bool CubeCollider::CheckCollision(ICollider* other, Contact& outContact)
+bool CubeCollider::CollideCubes(ICollider* a, ICollider* b, ContactManifold& outManifold)
 {
-    if (!other) return false;
-    if (m_ColliderState == ColliderState::Static && other->GetColliderState() == ColliderState::Static) return false;
+    using namespace DirectX;
+
+    //~ The dispatch table only sends cubes here
+    const CubeCollider* A = static_cast<const CubeCollider*>(a);
+    const CubeCollider* B = static_cast<const CubeCollider*>(b);
+
+    const BoxFrame boxA = A->GetBoxFrame();
+    const BoxFrame boxB = B->GetBoxFrame();
+
+    float penetration;
+    uint8_t axis;
+    XMVECTOR normal;
+    if (!TestOBBs(boxA, boxB, outManifold.SpeculativeMargin, outManifold.SeparatingAxis, axis, penetration, normal)) return false;
+
+    AddCubeContacts(a, b, boxA, boxB, axis, normal, penetration, outManifold);
+    return true;
+}
+
+// Face axes: the face of the reference box (the one the axis belongs to) that faces the other
+// box is clipped against the most anti-parallel face of the incident box (Sutherland-Hodgman
+// over the four side planes of the reference face). Every clipped vertex below the reference
+// face (or less than the speculative margin above it) is a point, so a resting box keeps four
+// stable corners instead of one rocking point.
+// Edge axes: the closest points between the two support edges. Feature ids name the faces,
+// edges and incident corner or clip crossing, so the cache can warm start them.
+void CubeCollider::AddCubeContacts(ICollider* a, ICollider* b, const BoxFrame& boxA, const BoxFrame& boxB,
+    uint8_t axis, const DirectX::XMVECTOR& normal, float penetration, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    if (axis >= 6)
+    {
+        const uint32_t i = (axis - 6) / 3;
+        const uint32_t j = (axis - 6) % 3;
+
+        XMVECTOR startA, endA, startB, endB;
+        const uint32_t edgeA = GetSupportEdge(boxA, i, normal, startA, endA);
+        const uint32_t edgeB = GetSupportEdge(boxB, j, XMVectorNegate(normal), startB, endB);
+
+        XMVECTOR pointA, pointB;
+        CapsuleCollider::ClosestPointsBetweenSegments(startA, endA, startB, endB, pointA, pointB);
+        const XMVECTOR midPoint = XMVectorScale(XMVectorAdd(pointA, pointB), 0.5f);
+        outManifold.AddPoint(MakeContact(a, b, normal, penetration, midPoint, 0x3000000u | (edgeA << 8) | edgeB));
+        return;
+    }
+
+    const bool referenceIsA = axis < 3;
+    const BoxFrame& reference = referenceIsA ? boxA : boxB;
+    const BoxFrame& incident = referenceIsA ? boxB : boxA;
+
+    //~ Outward normal of the reference face, towards the incident box
+    const XMVECTOR faceNormal = referenceIsA ? normal : XMVectorNegate(normal);
+    const uint32_t refAxis = referenceIsA ? axis : axis - 3;
+    const float refSign = XMVectorGetX(XMVector3Dot(reference.Axes[refAxis], faceNormal)) < 0.0f ? -1.0f : 1.0f;
+    const XMVECTOR refCenter = XMVectorAdd(reference.Center,
+        XMVectorScale(reference.Axes[refAxis], refSign * reference.HalfExtents[refAxis]));
+
+    //~ Incident face: the one whose outward normal points most against the reference face
+    uint32_t incAxis = 0;
+    float incDot = 0.0f;
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        const float d = XMVectorGetX(XMVector3Dot(incident.Axes[k], faceNormal));
+        if (fabsf(d) > fabsf(incDot))
+        {
+            incDot = d;
+            incAxis = k;
+        }
+    }
+    const float incSign = incDot > 0.0f ? -1.0f : 1.0f;
+
+    //~ Its corners in winding order, ids are GetVertex indices (bit k = positive side along axis k)
+    const uint32_t k1 = (incAxis + 1) % 3;
+    const uint32_t k2 = (incAxis + 2) % 3;
+    const float windingSigns[4][2] = { { 1.0f, 1.0f }, { -1.0f, 1.0f }, { -1.0f, -1.0f }, { 1.0f, -1.0f } };
+    const XMVECTOR incCenter = XMVectorAdd(incident.Center,
+        XMVectorScale(incident.Axes[incAxis], incSign * incident.HalfExtents[incAxis]));
+
+    ClipVertex polygon[MaxClipVertices];
+    ClipVertex clipped[MaxClipVertices];
+    uint32_t count = 4;
+    for (uint32_t v = 0; v < 4; ++v)
+    {
+        const float s1 = windingSigns[v][0];
+        const float s2 = windingSigns[v][1];
+        XMVECTOR position = XMVectorAdd(incCenter, XMVectorScale(incident.Axes[k1], s1 * incident.HalfExtents[k1]));
+        position = XMVectorAdd(position, XMVectorScale(incident.Axes[k2], s2 * incident.HalfExtents[k2]));
+
+        uint32_t corner = 0;
+        if (incSign > 0.0f) corner |= 1u << incAxis;
+        if (s1 > 0.0f) corner |= 1u << k1;
+        if (s2 > 0.0f) corner |= 1u << k2;
+        polygon[v] = { position, corner };
+    }
+
+    //~ Side planes of the reference face
+    const uint32_t sideAxes[2] = { (refAxis + 1) % 3, (refAxis + 2) % 3 };
+    uint32_t plane = 0;
+    for (const uint32_t side : sideAxes)
+    {
+        const float centerDistance = XMVectorGetX(XMVector3Dot(reference.Center, reference.Axes[side]));
+        for (const float sign : { 1.0f, -1.0f })
+        {
+            const XMVECTOR planeNormal = XMVectorScale(reference.Axes[side], sign);
+            const float offset = sign * centerDistance + reference.HalfExtents[side];
+            count = ClipPolygon(polygon, count, planeNormal, offset, plane++, clipped);
+            std::copy(clipped, clipped + count, polygon);
+        }
+    }
+
+    const uint32_t faceId = ((referenceIsA ? 1u : 2u) << 24) |
+        ((refAxis * 2 + (refSign > 0.0f ? 1u : 0u)) << 16) |
+        ((incAxis * 2 + (incSign > 0.0f ? 1u : 0u)) << 8);
+    const float refOffset = XMVectorGetX(XMVector3Dot(refCenter, faceNormal));
 
-    if (other->GetColliderType() == ColliderType::Cube)
+    Contact candidates[MaxClipVertices];
+    uint32_t pointCount = 0;
+    for (uint32_t v = 0; v < count; ++v)
     {
-        Contact contact = GenerateContactWithCube(other->As<CubeCollider>());
-        outContact = contact;
+        const float depth = refOffset - XMVectorGetX(XMVector3Dot(polygon[v].Position, faceNormal));
+        if (depth <= -outManifold.SpeculativeMargin) continue;
+
+        //~ Halfway between the incident vertex and the reference face
+        const XMVECTOR point = XMVectorAdd(polygon[v].Position, XMVectorScale(faceNormal, 0.5f * depth));
+        candidates[pointCount++] = MakeContact(a, b, normal, (std::min)(depth, penetration), point, faceId | polygon[v].Id);
+    }
 
-        return contact.PenetrationDepth > 0.0f;
+    if (pointCount > 0)
+    {
+        outManifold.AddReduced(candidates, pointCount);
+        return;
     }
-    return false;
+
+    //~ Round-off left nothing below the face, keep an approximate point between the centres
+    const XMVECTOR midPoint = XMVectorScale(XMVectorAdd(boxA.Center, boxB.Center), 0.5f);
+    outManifold.AddPoint(MakeContact(a, b, normal, penetration, midPoint));
 }
 
-ColliderType CubeCollider::GetColliderType() const
+uint32_t CubeCollider::ClipPolygon(const ClipVertex* in, uint32_t count, const DirectX::XMVECTOR& planeNormal,
+    float planeOffset, uint32_t plane, ClipVertex* out)
 {
-    return ColliderType::Cube;
+    using namespace DirectX;
+
+    uint32_t outCount = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const ClipVertex& start = in[(i + count - 1) % count];
+        const ClipVertex& end = in[i];
+        const float startDistance = XMVectorGetX(XMVector3Dot(start.Position, planeNormal)) - planeOffset;
+        const float endDistance = XMVectorGetX(XMVector3Dot(end.Position, planeNormal)) - planeOffset;
+
+        //~ Edge crosses the plane: add the crossing, named after the plane and the edge start
+        if ((startDistance <= 0.0f) != (endDistance <= 0.0f) && outCount < MaxClipVertices)
+        {
+            const float t = startDistance / (startDistance - endDistance);
+            const XMVECTOR position = XMVectorLerp(start.Position, end.Position, t);
+            out[outCount++] = { position, 0x10u | (plane << 5) | (start.Id & 0x0Fu) };
+        }
+        if (endDistance <= 0.0f && outCount < MaxClipVertices) out[outCount++] = end;
+    }
+    return outCount;
+}
+
+uint32_t CubeCollider::GetSupportEdge(const BoxFrame& box, uint32_t axis, const DirectX::XMVECTOR& direction,
+    DirectX::XMVECTOR& outStart, DirectX::XMVECTOR& outEnd)
+{
+    using namespace DirectX;
+
+    XMVECTOR center = box.Center;
+    uint32_t side = 0;
+    for (uint32_t k = 1; k < 3; ++k)
+    {
+        const uint32_t other = (axis + k) % 3;
+        const bool positive = XMVectorGetX(XMVector3Dot(box.Axes[other], direction)) >= 0.0f;
+        center = XMVectorAdd(center, XMVectorScale(box.Axes[other], positive ? box.HalfExtents[other] : -box.HalfExtents[other]));
+        if (positive) side |= k;
+    }
+
+    const XMVECTOR halfEdge = XMVectorScale(box.Axes[axis], box.HalfExtents[axis]);
+    outStart = XMVectorSubtract(center, halfEdge);
+    outEnd = XMVectorAdd(center, halfEdge);
+    return axis * 4 + side;
+}
+
+bool CubeCollider::CollideCubeSphere(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    //~ The dispatch table only sends (cube, sphere) here
+    const CubeCollider* A = static_cast<const CubeCollider*>(a);
+    const SphereCollider* B = static_cast<const SphereCollider*>(b);
+
+    Contact contact;
+    if (!CollideBoxSphere(a, b, A->GetBoxFrame(), B->GetCenter(), B->GetRadius(), 0, contact,
+        outManifold.SpeculativeMargin)) return false;
+
+    outManifold.AddPoint(contact);
+    return true;
+}
+
+// Both caps are tested as spheres, which covers a capsule resting on a face. When neither
+// touches, the closest point of the segment (a few rounds of projecting between the box and
+// the segment) covers a capsule lying across an edge.
+bool CubeCollider::CollideCubeCapsule(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    //~ The dispatch table only sends (cube, capsule) here
+    const CubeCollider* A = static_cast<const CubeCollider*>(a);
+    const CapsuleCollider* B = static_cast<const CapsuleCollider*>(b);
+
+    const BoxFrame box = A->GetBoxFrame();
+    XMVECTOR start, end;
+    B->GetSegment(start, end);
+
+    const XMVECTOR caps[2] = { start, end };
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Contact contact;
+        if (CollideBoxSphere(a, b, box, caps[i], B->GetRadius(), i + 1, contact, outManifold.SpeculativeMargin))
+        {
+            outManifold.AddPoint(contact);
+        }
+    }
+    if (outManifold.PointCount > 0) return true;
+
+    XMVECTOR closest = XMVectorScale(XMVectorAdd(start, end), 0.5f);
+    for (int i = 0; i < 4; ++i)
+    {
+        closest = CapsuleCollider::ClosestPointOnSegment(ClosestPointOnBox(box, closest), start, end);
+    }
+
+    Contact contact;
+    if (!CollideBoxSphere(a, b, box, closest, B->GetRadius(), 0, contact, outManifold.SpeculativeMargin)) return false;
+
+    outManifold.AddPoint(contact);
+    return true;
+}
+
+//~ Every corner behind the plane (or within the speculative margin of it), reduced to the four
+//~ that span the most area
+bool CubeCollider::CollideCubePlane(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    //~ The dispatch table only sends (cube, plane) here
+    const CubeCollider* A = static_cast<const CubeCollider*>(a);
+    const PlaneCollider* B = static_cast<const PlaneCollider*>(b);
+
+    const BoxFrame box = A->GetBoxFrame();
+    const XMVECTOR planeNormal = B->GetNormal();
+    const XMVECTOR normal = XMVectorNegate(planeNormal);
+
+    Contact candidates[8];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        const XMVECTOR vertex = GetVertex(box, i);
+        const float depth = -B->GetDistance(vertex);
+        if (depth <= -outManifold.SpeculativeMargin) continue;
+
+        const XMVECTOR point = XMVectorAdd(vertex, XMVectorScale(planeNormal, 0.5f * depth));
+        candidates[count++] = MakeContact(a, b, normal, depth, point, 0x100u | i);
+    }
+
+    if (count == 0) return false;
+    outManifold.AddReduced(candidates, count);
+    return true;
 }
 
 void CubeCollider::SetScale(const DirectX::XMVECTOR& vector)
 {
     m_Scale = vector;
-    DirectX::XMFLOAT3 scale; DirectX::XMStoreFloat3(&scale, m_Scale);
-    m_RigidBody->ComputeInverseInertiaTensorBox(scale.x, scale.y, scale.z);
+    UpdateInertia();
+}
+
+void CubeCollider::UpdateInertia()
+{
+    //~ The tensor wants full widths, the scale is the half extent
+    DirectX::XMFLOAT3 scale; DirectX::XMStoreFloat3(&scale, DirectX::XMVectorAbs(m_Scale));
+    m_RigidBody->ComputeInverseInertiaTensorBox(2.0f * scale.x, 2.0f * scale.y, 2.0f * scale.z);
 }
 
 DirectX::XMVECTOR CubeCollider::GetScale() const
@@ -46,10 +311,15 @@ DirectX::XMVECTOR CubeCollider::GetScale() const
     return scale;
 }
 
+AABB CubeCollider::GetWorldAABB() const
+{
+    //~ The scale is the half extent, so the unit box under the world matrix is the collider
+    return AABB::FromTransform(GetWorldMatrix(), DirectX::XMVectorSplatOne());
+}
+
 DirectX::XMVECTOR CubeCollider::GetHalfExtents() const
 {
-    DirectX::XMVECTOR scale = GetScale();
-    return DirectX::XMVectorScale(scale, 0.5f);
+    return DirectX::XMVectorAbs(m_Scale);
 }
 
 void CubeCollider::ComputeWorldAxes(DirectX::XMVECTOR outAxes[3]) const
@@ -63,7 +333,7 @@ void CubeCollider::ComputeWorldAxes(DirectX::XMVECTOR outAxes[3]) const
     };
 
     const Quaternion orientation = m_RigidBody->GetOrientation();
-    const XMVECTOR halfScale = XMVectorScale(m_Scale, 1.0f); // Convert full size to half extents
+    const XMVECTOR halfScale = GetHalfExtents();
 
     for (int i = 0; i < 3; ++i)
     {
@@ -91,11 +361,11 @@ DirectX::XMVECTOR CubeCollider::GetClosestPoint(DirectX::XMVECTOR point) const
     // Step 2: Transform the point into the cube's local space
     XMVECTOR localPoint = XMVector3TransformCoord(point, invWorld);
 
-    // Step 3: Clamp the point to the cube's local AABB [-0.5, 0.5] in each axis
+    // Step 3: Clamp the point to the cube's local AABB [-1, 1] in each axis (the world matrix carries the half extents)
     XMVECTOR clamped = XMVectorClamp(
         localPoint,
-        XMVectorSet(-0.5f, -0.5f, -0.5f, 0.0f),
-        XMVectorSet(0.5f, 0.5f, 0.5f, 0.0f)
+        XMVectorSet(-1.0f, -1.0f, -1.0f, 0.0f),
+        XMVectorSet(1.0f, 1.0f, 1.0f, 0.0f)
     );
 
     // Step 4: Transform the clamped point back to world space
@@ -103,300 +373,260 @@ DirectX::XMVECTOR CubeCollider::GetClosestPoint(DirectX::XMVECTOR point) const
     return worldClosestPoint;
 }
 
-void CubeCollider::GetOBBAxes(const Quaternion& q, DirectX::XMVECTOR axes[3])
+CubeCollider::BoxFrame CubeCollider::GetBoxFrame() const
 {
     using namespace DirectX;
-    XMMATRIX rotMat = q.ToRotationMatrix();
-    axes[0] = rotMat.r[0]; // Right (local X)
-    axes[1] = rotMat.r[1]; // Up    (local Y)
-    axes[2] = rotMat.r[2]; // Forward (local Z)
+
+    //~ Rows of the rotation matrix are the unit axes, no per axis rotate or normalise
+    const XMMATRIX rotation = XMMatrixRotationQuaternion(m_RigidBody->GetOrientation().ToXmVector());
+    XMFLOAT3 halfExtents; XMStoreFloat3(&halfExtents, GetHalfExtents());
+
+    BoxFrame box{};
+    box.Center = GetCenter();
+    box.Axes[0] = rotation.r[0];
+    box.Axes[1] = rotation.r[1];
+    box.Axes[2] = rotation.r[2];
+    box.HalfExtents[0] = halfExtents.x;
+    box.HalfExtents[1] = halfExtents.y;
+    box.HalfExtents[2] = halfExtents.z;
+    return box;
 }
 
-float CubeCollider::ProjectOBB(const DirectX::XMVECTOR& axis, const DirectX::XMVECTOR axes[3], const DirectX::XMVECTOR& halfExtents)
+float CubeCollider::GetSupport(const BoxFrame& box, const DirectX::XMVECTOR& direction)
 {
     using namespace DirectX;
-    return fabsf(XMVectorGetX(XMVector3Dot(axes[0], axis))) * XMVectorGetX(halfExtents) +
-        fabsf(XMVectorGetX(XMVector3Dot(axes[1], axis))) * XMVectorGetY(halfExtents) +
-        fabsf(XMVectorGetX(XMVector3Dot(axes[2], axis))) * XMVectorGetZ(halfExtents);
+
+    float support = XMVectorGetX(XMVector3Dot(box.Center, direction));
+    for (int i = 0; i < 3; ++i)
+    {
+        support += fabsf(XMVectorGetX(XMVector3Dot(box.Axes[i], direction))) * box.HalfExtents[i];
+    }
+    return support;
 }
 
-bool CubeCollider::TryNormalize(DirectX::XMVECTOR& axis)
+//~ Bit i of 'index' picks the sign along axis i
+DirectX::XMVECTOR CubeCollider::GetVertex(const BoxFrame& box, uint32_t index)
 {
     using namespace DirectX;
-    if (XMVector3LengthSq(axis).m128_f32[0] < 1e-6f) return false;
-    axis = XMVector3Normalize(axis);
-    return true;
+
+    XMVECTOR vertex = box.Center;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        const float sign = (index & (1u << i)) ? 1.0f : -1.0f;
+        vertex = XMVectorAdd(vertex, XMVectorScale(box.Axes[i], sign * box.HalfExtents[i]));
+    }
+    return vertex;
 }
 
-void CubeCollider::BuildSATTestAxes(const DirectX::XMVECTOR axesA[3], const DirectX::XMVECTOR axesB[3],
-    std::vector<DirectX::XMVECTOR>& outAxes)
+bool CubeCollider::ContainsPoint(const BoxFrame& box, const DirectX::XMVECTOR& point, float tolerance)
 {
     using namespace DirectX;
-    outAxes.clear();
-    outAxes.reserve(15);
 
-    // === 3 Axes from A ===
+    const XMVECTOR offset = XMVectorSubtract(point, box.Center);
     for (int i = 0; i < 3; ++i)
     {
-        XMVECTOR axis = XMVector3Normalize(axesA[i]);
-        outAxes.push_back(axis);
+        if (fabsf(XMVectorGetX(XMVector3Dot(offset, box.Axes[i]))) > box.HalfExtents[i] + tolerance) return false;
     }
+    return true;
+}
 
-    // === 3 Axes from B ===
-    for (int i = 0; i < 3; ++i)
-    {
-        XMVECTOR axis = XMVector3Normalize(axesB[i]);
-        outAxes.push_back(axis);
-    }
+DirectX::XMVECTOR CubeCollider::ClosestPointOnBox(const BoxFrame& box, const DirectX::XMVECTOR& point)
+{
+    using namespace DirectX;
 
-    // === 9 Cross Product Axes ===
+    const XMVECTOR offset = XMVectorSubtract(point, box.Center);
+    XMVECTOR closest = box.Center;
     for (int i = 0; i < 3; ++i)
     {
-        for (int j = 0; j < 3; ++j)
-        {
-            XMVECTOR cross = XMVector3Cross(axesA[i], axesB[j]);
-            float lengthSq = XMVectorGetX(XMVector3LengthSq(cross));
-
-            if (lengthSq > 1e-6f) // Ignore near-zero axes due to collinearity
-            {
-                outAxes.push_back(XMVector3Normalize(cross));
-            }
-        }
+        const float distance = std::clamp(XMVectorGetX(XMVector3Dot(offset, box.Axes[i])), -box.HalfExtents[i], box.HalfExtents[i]);
+        closest = XMVectorAdd(closest, XMVectorScale(box.Axes[i], distance));
     }
+    return closest;
 }
 
-bool CubeCollider::TestOBBsWithSAT(const CubeCollider* boxA, const CubeCollider* boxB,
-    const std::vector<DirectX::XMVECTOR>& axes, float& minPenetrationDepth, DirectX::XMVECTOR& outCollisionNormal)
+bool CubeCollider::CollideBoxSphere(ICollider* a, ICollider* b, const BoxFrame& box,
+    const DirectX::XMVECTOR& center, float radius, uint32_t featureId, Contact& outContact, float margin)
 {
     using namespace DirectX;
 
-    const XMVECTOR centerA = boxA->GetCenter();
-    const XMVECTOR centerB = boxB->GetCenter();
-
-    XMVECTOR axesA[3], axesB[3];
-    boxA->ComputeWorldAxes(axesA);
-    boxB->ComputeWorldAxes(axesB);
-
-    const XMVECTOR centerOffset = XMVectorSubtract(centerB, centerA);
-
-    minPenetrationDepth = FLT_MAX;
-    outCollisionNormal = XMVectorZero();
-
-    for (const auto& axis : axes)
+    const XMVECTOR offset = XMVectorSubtract(center, box.Center);
+    float distances[3];
+    bool inside = true;
+    for (int i = 0; i < 3; ++i)
     {
-        if (XMVector3Equal(axis, XMVectorZero())) continue;
-
-        XMVECTOR normalizedAxis = XMVector3Normalize(axis);
-
-        // === Projection of box A onto axis ===
-        float projectionA = 0.0f;
-        for (int i = 0; i < 3; ++i)
-        {
-            projectionA += abs(XMVectorGetX(XMVector3Dot(normalizedAxis, axesA[i])));
-        }
-
-        // === Projection of box B onto axis ===
-        float projectionB = 0.0f;
-        for (int i = 0; i < 3; ++i)
-        {
-            projectionB += abs(XMVectorGetX(XMVector3Dot(normalizedAxis, axesB[i])));
-        }
-
-        // === Distance between centers on this axis ===
-        float centerDistance = abs(XMVectorGetX(XMVector3Dot(normalizedAxis, centerOffset)));
-
-        float totalProjection = projectionA + projectionB;
+        distances[i] = XMVectorGetX(XMVector3Dot(offset, box.Axes[i]));
+        inside &= fabsf(distances[i]) <= box.HalfExtents[i];
+    }
 
-        if (centerDistance > totalProjection)
-        {
-            // Found a separating axis
-            return false;
-        }
+    if (!inside)
+    {
+        //~ The closest point on the box is a sphere of radius zero
+        const XMVECTOR closest = ClosestPointOnBox(box, center);
+        return SphereCollider::CollideSpherePoints(a, b, closest, 0.0f, center, radius,
+            XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), featureId, outContact, margin);
+    }
 
-        float overlap = totalProjection - centerDistance;
-        if (overlap < minPenetrationDepth)
+    //~ Centre inside the box, push out through the nearest face
+    int face = 0;
+    float faceDistance = FLT_MAX;
+    for (int i = 0; i < 3; ++i)
+    {
+        const float distance = box.HalfExtents[i] - fabsf(distances[i]);
+        if (distance < faceDistance)
         {
-            minPenetrationDepth = overlap;
-            outCollisionNormal = normalizedAxis;
-
-            // Ensure normal always points from A to B
-            if (XMVectorGetX(XMVector3Dot(normalizedAxis, centerOffset)) < 0)
-            {
-                outCollisionNormal = XMVectorNegate(normalizedAxis);
-            }
+            faceDistance = distance;
+            face = i;
         }
     }
 
+    const XMVECTOR normal = XMVectorScale(box.Axes[face], distances[face] < 0.0f ? -1.0f : 1.0f);
+    const float depth = faceDistance + radius;
+    const XMVECTOR point = XMVectorAdd(center, XMVectorScale(normal, faceDistance - 0.5f * depth));
+    outContact = MakeContact(a, b, normal, depth, point, featureId);
     return true;
 }
 
-bool CubeCollider::CheckCollisionWithCube(ICollider* other, Contact& outContact)
+// Everything is expressed in A's frame: R[i][j] = Ai . Bj and t = (cB - cA) in A's axes, so each
+// of the 15 axes costs a handful of multiply-adds on precomputed scalars. A small epsilon on
+// |R| keeps the edge axes of near parallel boxes from reporting separation through round-off.
+bool CubeCollider::TestOBBs(const BoxFrame& boxA, const BoxFrame& boxB, float margin, uint8_t& ioAxis,
+    uint8_t& outContactAxis, float& outDepth, DirectX::XMVECTOR& outNormal)
 {
     using namespace DirectX;
 
-    // === STEP 1: Type check & cast ===
-    if (!other || other->GetColliderType() != ColliderType::Cube) return false;
-    const CubeCollider* B = other->As<CubeCollider>();
-    if (!B) return false;
-
-    // === STEP 2: Get transforms and OBB axes ===
-    const XMVECTOR posA = m_RigidBody->GetPosition();
-    const XMVECTOR posB = B->GetRigidBody()->GetPosition();
-
-    const XMVECTOR halfA = GetHalfExtents();
-    const XMVECTOR halfB = B->GetHalfExtents();
-
-    const Quaternion qA = m_RigidBody->GetOrientation();
-    const Quaternion qB = B->GetRigidBody()->GetOrientation();
+    constexpr float parallelEpsilon = 1e-5f;
 
-    XMVECTOR axesA[3];
-    XMVECTOR axesB[3];
-
-    GetOBBAxes(qA, axesA);
-    GetOBBAxes(qB, axesB);
-
-    const XMVECTOR toCenter = posB - posA;
-
-    float minOverlap = FLT_MAX;
-    XMVECTOR bestAxis = XMVectorZero();
-
-    // === STEP 3: Test all 15 axes ===
+    SATFrame frame;
     for (int i = 0; i < 3; ++i)
     {
-        XMVECTOR axis = axesA[i];
-        if (!TryNormalize(axis)) continue;
-
-        float projA = ProjectOBB(axis, axesA, halfA);
-        float projB = ProjectOBB(axis, axesB, halfB);
-        float dist = fabsf(XMVectorGetX(XMVector3Dot(toCenter, axis)));
-        float overlap = projA + projB - dist;
-
-        if (overlap < 0) return false; // Separating axis found
-
-        if (overlap < minOverlap)
+        for (int j = 0; j < 3; ++j)
         {
-            minOverlap = overlap;
-            bestAxis = axis;
-            if (XMVectorGetX(XMVector3Dot(toCenter, axis)) < 0)
-                bestAxis = -axis;
+            frame.R[i][j] = XMVectorGetX(XMVector3Dot(boxA.Axes[i], boxB.Axes[j]));
+            frame.AbsR[i][j] = fabsf(frame.R[i][j]) + parallelEpsilon;
         }
+        frame.HalfA[i] = boxA.HalfExtents[i];
+        frame.HalfB[i] = boxB.HalfExtents[i];
     }
 
+    const XMVECTOR offset = XMVectorSubtract(boxB.Center, boxA.Center);
     for (int i = 0; i < 3; ++i)
     {
-        XMVECTOR axis = axesB[i];
-        if (!TryNormalize(axis)) continue;
-
-        float projA = ProjectOBB(axis, axesA, halfA);
-        float projB = ProjectOBB(axis, axesB, halfB);
-        float dist = fabsf(XMVectorGetX(XMVector3Dot(toCenter, axis)));
-        float overlap = projA + projB - dist;
+        frame.T[i] = XMVectorGetX(XMVector3Dot(offset, boxA.Axes[i]));
+    }
 
-        if (overlap < 0) return false;
+    //~ Temporal coherence: last step's separating axis usually still separates
+    float distance, length;
+    if (ioAxis < SATAxisCount)
+    {
+        ++t_AxesTested;
+        if (GetAxisOverlap(frame, ioAxis, distance, length) < -margin * length) return false;
+    }
 
-        if (overlap < minOverlap)
+    //~ Least penetration per group: faces of A, faces of B, edges
+    float groupDepth[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float groupDistance[3] = { 0.0f, 0.0f, 0.0f };
+    uint8_t groupAxis[3] = { 0, 3, 6 };
+    for (uint8_t axis = 0; axis < SATAxisCount; ++axis)
+    {
+        const float overlap = GetAxisOverlap(frame, axis, distance, length);
+        ++t_AxesTested;
+        if (overlap < -margin * length)
         {
-            minOverlap = overlap;
-            bestAxis = axis;
-            if (XMVectorGetX(XMVector3Dot(toCenter, axis)) < 0)
-                bestAxis = -axis;
+            ioAxis = axis;
+            return false;
         }
-    }
 
-    for (int i = 0; i < 3; ++i)
-    {
-        for (int j = 0; j < 3; ++j)
+        const int group = axis < 3 ? 0 : (axis < 6 ? 1 : 2);
+        const float depth = overlap / length;
+        if (depth < groupDepth[group])
         {
-            XMVECTOR axis = XMVector3Cross(axesA[i], axesB[j]);
-            if (!TryNormalize(axis)) continue;
-
-            float projA = ProjectOBB(axis, axesA, halfA);
-            float projB = ProjectOBB(axis, axesB, halfB);
-            float dist = fabsf(XMVectorGetX(XMVector3Dot(toCenter, axis)));
-            float overlap = projA + projB - dist;
-
-            if (overlap < 0) return false;
-
-            if (overlap < minOverlap)
-            {
-                minOverlap = overlap;
-                bestAxis = axis;
-                if (XMVectorGetX(XMVector3Dot(toCenter, axis)) < 0)
-                    bestAxis = -axis;
-            }
+            groupDepth[group] = depth;
+            groupDistance[group] = distance;
+            groupAxis[group] = axis;
         }
     }
 
-    // === STEP 4: Fill out contact data ===
-    outContact.Colliders[0] = this;
-    outContact.Colliders[1] = other;
-
-    XMStoreFloat3(&outContact.ContactNormal, bestAxis);
-    outContact.PenetrationDepth = minOverlap;
-
-    // Approximate center point between boxes (improve later via clipping or contact manifold)
-    XMVECTOR midpoint = 0.5f * (posA + posB);
-    XMStoreFloat3(&outContact.ContactPoint, midpoint);
-
-    outContact.Restitution = 0.5f * (
-        m_RigidBody->GetRestitution() + B->GetRigidBody()->GetRestitution());
-    outContact.Friction = 0.5f * (
-        m_RigidBody->GetFriction() + B->GetRigidBody()->GetFriction());
-    outContact.Elasticity = 0.5f * (
-        m_RigidBody->GetElasticity() + B->GetRigidBody()->GetElasticity());
+    //~ A later group has to be clearly shallower to win (or clearly further apart, for a speculative gap)
+    int best = 0;
+    for (int group = 1; group < 3; ++group)
+    {
+        const float relative = groupDepth[best] >= 0.0f ? AxisRelativeTolerance : 2.0f - AxisRelativeTolerance;
+        if (groupDepth[group] < groupDepth[best] * relative - AxisAbsoluteTolerance) best = group;
+    }
 
+    outNormal = GetAxisNormal(boxA, boxB, groupAxis[best], groupDistance[best]);
+    outDepth = groupDepth[best];
+    outContactAxis = groupAxis[best];
+    ioAxis = ContactManifold::NoAxis;
     return true;
 }
 
-Contact CubeCollider::GenerateContactWithCube(CubeCollider* other)
+uint64_t CubeCollider::GetAxesTested()
 {
-    using namespace DirectX;
-
-    Contact contact{};
-
-    // Step 1: Compute axes
-    XMVECTOR axesA[3];
-    XMVECTOR axesB[3];
-    this->ComputeWorldAxes(axesA);
-    other->ComputeWorldAxes(axesB);
-
-    // Step 2: Build SAT test axes
-    std::vector<XMVECTOR> testAxes;
-    BuildSATTestAxes(axesA, axesB, testAxes);
-
-    // Step 3: Run SAT test
-    float penetration;
-    XMVECTOR normal;
-    bool collided = TestOBBsWithSAT(this, other, testAxes, penetration, normal);
-
-    if (!collided)
-        return contact; // No collision
+    return t_AxesTested;
+}
 
-    // Step 4: Ensure normal points from A to B
-    XMVECTOR centerA = this->GetCenter();
-    XMVECTOR centerB = other->GetCenter();
-    XMVECTOR centerDelta = XMVectorSubtract(centerB, centerA);
+bool CubeCollider::OverlapOBBs(const BoxFrame& boxA, const BoxFrame& boxB)
+{
+    uint8_t axis = ContactManifold::NoAxis;
+    uint8_t contactAxis;
+    float depth;
+    DirectX::XMVECTOR normal;
+    return TestOBBs(boxA, boxB, 0.0f, axis, contactAxis, depth, normal);
+}
 
-    if (XMVectorGetX(XMVector3Dot(centerDelta, normal)) < 0.0f)
+float CubeCollider::GetAxisOverlap(const SATFrame& frame, uint8_t axis, float& outDistance, float& outLength)
+{
+    const float* ha = frame.HalfA;
+    const float* hb = frame.HalfB;
+    const float* t = frame.T;
+    const auto& R = frame.R;
+    const auto& absR = frame.AbsR;
+
+    float ra, rb;
+    outLength = 1.0f;
+    if (axis < 3)
     {
-        normal = XMVectorNegate(normal);
+        const int i = axis;
+        ra = ha[i];
+        rb = hb[0] * absR[i][0] + hb[1] * absR[i][1] + hb[2] * absR[i][2];
+        outDistance = t[i];
     }
+    else if (axis < 6)
+    {
+        const int j = axis - 3;
+        ra = ha[0] * absR[0][j] + ha[1] * absR[1][j] + ha[2] * absR[2][j];
+        rb = hb[j];
+        outDistance = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+    }
+    else
+    {
+        const int i = (axis - 6) / 3;
+        const int j = (axis - 6) % 3;
+        const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+
+        ra = ha[i1] * absR[i2][j] + ha[i2] * absR[i1][j];
+        rb = hb[j1] * absR[i][j2] + hb[j2] * absR[i][j1];
+        outDistance = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+
+        //~ |Ai x Bj| = sin of the angle between them; parallel edges add nothing the faces miss
+        const float sinSq = 1.0f - R[i][j] * R[i][j];
+        if (sinSq < 1e-6f) return FLT_MAX;
+        outLength = std::sqrt(sinSq);
+    }
+    return ra + rb - fabsf(outDistance);
+}
 
-    // Step 5: Fill out contact
-    XMStoreFloat3(&contact.ContactNormal, normal);
-    contact.PenetrationDepth = penetration;
-
-    // Approximate contact point: midpoint between centers
-    XMVECTOR midPoint = XMVectorScale(XMVectorAdd(centerA, centerB), 0.5f);
-    XMStoreFloat3(&contact.ContactPoint, midPoint);
-
-    contact.Colliders[0] = this;
-    contact.Colliders[1] = other;
+DirectX::XMVECTOR CubeCollider::GetAxisNormal(const BoxFrame& boxA, const BoxFrame& boxB, uint8_t axis, float distance)
+{
+    using namespace DirectX;
 
-    // Transfer physical properties
-    contact.Restitution = Min(m_RigidBody->GetRestitution(), other->GetRigidBody()->GetRestitution());
-    contact.Friction = std::sqrt(m_RigidBody->GetFriction() * other->GetRigidBody()->GetFriction());
-    contact.Elasticity = Min(m_RigidBody->GetElasticity(), other->GetRigidBody()->GetElasticity());
+    XMVECTOR normal;
+    if (axis < 3) normal = boxA.Axes[axis];
+    else if (axis < 6) normal = boxB.Axes[axis - 3];
+    else normal = XMVector3Normalize(XMVector3Cross(boxA.Axes[(axis - 6) / 3], boxB.Axes[(axis - 6) % 3]));
 
-    return contact;
+    //~ Point from A to B
+    return distance < 0.0f ? XMVectorNegate(normal) : normal;
 }
@@ -1,8 +1,9 @@
 #pragma once
-#include <vector>
 #include "Collision/ICollider.h"
 
 
+// Oriented box around the body position. The scale is the half extent along each local
+// axis (the cube mesh spans [-1, 1]), for the SAT, the bounds and the inertia alike.
 class CubeCollider final : public ICollider
 {
 public:
@@ -15,10 +16,15 @@ public:
 	CubeCollider& operator=(CubeCollider&&) = default;
 
 	//~ Collision Interface
-	bool CheckCollision(ICollider* other, Contact& outContact) override;
-	ColliderType GetColliderType() const override;
 	void SetScale(const DirectX::XMVECTOR& vector) override;
 	DirectX::XMVECTOR GetScale() const override;
+	AABB GetWorldAABB() const override;
+
+	//~ CollisionDispatcher table entries, 'a' is always the cube
+	static bool CollideCubes(ICollider* a, ICollider* b, ContactManifold& outManifold);
+	static bool CollideCubeSphere(ICollider* a, ICollider* b, ContactManifold& outManifold);
+	static bool CollideCubeCapsule(ICollider* a, ICollider* b, ContactManifold& outManifold);
+	static bool CollideCubePlane(ICollider* a, ICollider* b, ContactManifold& outManifold);
 
 	//~ Cube Collision Specifics
 	DirectX::XMVECTOR GetHalfExtents() const;
@@ -26,25 +32,86 @@ public:
 	DirectX::XMVECTOR GetCenter() const;
 	DirectX::XMVECTOR GetClosestPoint(DirectX::XMVECTOR point) const;
 
-	//~ Helpers
-	static void GetOBBAxes(const Quaternion& q, DirectX::XMVECTOR axes[3]);
-	static float ProjectOBB(const DirectX::XMVECTOR& axis, const DirectX::XMVECTOR axes[3], const DirectX::XMVECTOR& halfExtents);
-	static bool TryNormalize(DirectX::XMVECTOR& axis);
-	static void BuildSATTestAxes(const DirectX::XMVECTOR axesA[3],
-		const DirectX::XMVECTOR axesB[3],
-		std::vector<DirectX::XMVECTOR>& outAxes);
-	static bool TestOBBsWithSAT(
-		const CubeCollider* boxA,
-		const CubeCollider* boxB,
-		const std::vector<DirectX::XMVECTOR>& axes,
-		float& minPenetrationDepth,
-		DirectX::XMVECTOR& outCollisionNormal
-	);
+	//~ SAT axis indices: 0-2 faces of A, 3-5 faces of B, 6 + 3i + j edge of A axis i x B axis j
+	static constexpr uint8_t SATAxisCount = 15;
+
+	//~ World space box with unit axes, also used by the QueryWorld for boxes that are not colliders
+	struct BoxFrame
+	{
+		DirectX::XMVECTOR Center;
+		DirectX::XMVECTOR Axes[3];
+		float HalfExtents[3];
+	};
+	BoxFrame GetBoxFrame() const;
+	static float GetSupport(const BoxFrame& box, const DirectX::XMVECTOR& direction);
+	static DirectX::XMVECTOR ClosestPointOnBox(const BoxFrame& box, const DirectX::XMVECTOR& point);
+
+	//~ True when the boxes overlap, the cheap yes/no form of the SAT below
+	static bool OverlapOBBs(const BoxFrame& boxA, const BoxFrame& boxB);
+
+	//~ SAT axes evaluated on the calling thread so far. For profiling: read it before and after
+	//~ a piece of work on the same thread.
+	static uint64_t GetAxesTested();
 
 private:
-	//~ Cube Collision Check
-	bool CheckCollisionWithCube(ICollider* other, Contact& outContact);
-	Contact GenerateContactWithCube(CubeCollider* other);
+	static DirectX::XMVECTOR GetVertex(const BoxFrame& box, uint32_t index);
+	static bool ContainsPoint(const BoxFrame& box, const DirectX::XMVECTOR& point, float tolerance);
+
+	//~ B relative to A: R[i][j] = Ai . Bj, t = (cB - cA) in A's axes
+	struct SATFrame
+	{
+		float R[3][3];
+		float AbsR[3][3];
+		float T[3];
+		float HalfA[3];
+		float HalfB[3];
+	};
+
+	//~ Overlap along 'axis' (negative = separated) and the signed distance of B along it.
+	//~ Edge axes are unnormalised, 'outLength' scales both back to world units.
+	static float GetAxisOverlap(const SATFrame& frame, uint8_t axis, float& outDistance, float& outLength);
+
+	//~ World space normal of 'axis', pointing from A to B
+	static DirectX::XMVECTOR GetAxisNormal(const BoxFrame& boxA, const BoxFrame& boxB, uint8_t axis, float distance);
+
+	//~ Separating axis test in A's frame (Gottschalk). 'ioAxis' is tried first and receives the
+	//~ separating axis when there is one; otherwise outputs the contact axis, the one of least
+	//~ penetration with faces of A, then faces of B, preferred over near ties. Boxes less than
+	//~ 'margin' apart count as touching, with a negative depth (the gap along the contact axis).
+	static bool TestOBBs(const BoxFrame& boxA, const BoxFrame& boxB, float margin, uint8_t& ioAxis,
+		uint8_t& outContactAxis, float& outDepth, DirectX::XMVECTOR& outNormal);
+
+	//~ Relative and absolute tolerance a later axis group must beat to be picked as contact axis,
+	//~ keeps the reference face from flipping between frames for nearly equal depths
+	static constexpr float AxisRelativeTolerance = 0.95f;
+	static constexpr float AxisAbsoluteTolerance = 0.005f;
+
+	//~ Contact points of two boxes once the SAT found them touching along 'axis' (or within the
+	//~ manifold's speculative margin)
+	static void AddCubeContacts(ICollider* a, ICollider* b, const BoxFrame& boxA, const BoxFrame& boxB,
+		uint8_t axis, const DirectX::XMVECTOR& normal, float penetration, ContactManifold& outManifold);
+
+	//~ Polygon vertex while clipping, 'Id' names the incident corner or edge/plane crossing it came from
+	struct ClipVertex
+	{
+		DirectX::XMVECTOR Position;
+		uint32_t Id;
+	};
+	static constexpr uint32_t MaxClipVertices = 8;
+
+	//~ Sutherland-Hodgman against the plane dot(n, p) <= offset, returns the vertex count in 'out'
+	static uint32_t ClipPolygon(const ClipVertex* in, uint32_t count, const DirectX::XMVECTOR& planeNormal,
+		float planeOffset, uint32_t plane, ClipVertex* out);
+
+	//~ Support edge of 'box' along axis 'axis' in 'direction', with an id from the axis and the side
+	static uint32_t GetSupportEdge(const BoxFrame& box, uint32_t axis, const DirectX::XMVECTOR& direction,
+		DirectX::XMVECTOR& outStart, DirectX::XMVECTOR& outEnd);
+
+	//~ Box against a sphere at 'center', also used for every sample along a capsule
+	static bool CollideBoxSphere(ICollider* a, ICollider* b, const BoxFrame& box,
+		const DirectX::XMVECTOR& center, float radius, uint32_t featureId, Contact& outContact, float margin);
+
+	void UpdateInertia();
 
 private:
 	DirectX::XMVECTOR m_Scale{ 1.0f, 1.0f, 1.0f };
@@ -1,10 +1,13 @@
 #include "pch.h"
 #include "ICollider.h"
 #include "Contact.h"
+#include "ContactManifold.h"
+#include "CollisionDispatcher.h"
+#include <cmath>
 #include <ranges>
 
-ICollider::ICollider(RigidBody* attachBody)
-	: m_RigidBody(attachBody)
+ICollider::ICollider(RigidBody* attachBody, ColliderType type)
+	: m_ColliderType(type), m_RigidBody(attachBody)
 {}
 
 ColliderState ICollider::GetColliderState() const
@@ -12,16 +15,30 @@ ColliderState ICollider::GetColliderState() const
 	return m_ColliderState;
 }
 
+bool ICollider::IsImmovable() const
+{
+	if (m_ColliderState == ColliderState::Static) return true;
+	return m_ColliderState == ColliderState::Dynamic && m_RigidBody->IsKinematic();
+}
+
 void ICollider::SetColliderState(ColliderState state)
 {
 	m_ColliderState = state;
 }
 
+void ICollider::SetLayer(uint8_t layer)
+{
+	if (layer < LayerCount) m_Layer = layer;
+}
+
 const char* ICollider::ToString() const
 {
 	switch (GetColliderType())
 	{
 	case ColliderType::Cube:    return "Cube";
+	case ColliderType::Sphere:  return "Sphere";
+	case ColliderType::Capsule: return "Capsule";
+	case ColliderType::Plane:   return "Plane";
 	default:                    return "Unknown";
 	}
 	return "null";
@@ -32,10 +49,52 @@ const char* ICollider::GetColliderTypeName() const
 	switch (GetColliderType())
 	{
 	case ColliderType::Cube: return "Cube";
+	case ColliderType::Sphere: return "Sphere";
+	case ColliderType::Capsule: return "Capsule";
+	case ColliderType::Plane: return "Plane";
 	default: return "Unknown";
 	}
 }
 
+bool ICollider::GenerateManifold(ICollider* other, ContactManifold& outManifold)
+{
+	return CollisionDispatcher::GenerateManifold(this, other, outManifold);
+}
+
+bool ICollider::CheckCollision(ICollider* other, Contact& outContact)
+{
+	ContactManifold manifold;
+	if (!CollisionDispatcher::GenerateManifold(this, other, manifold) || manifold.PointCount == 0) return false;
+
+	uint32_t deepest = 0;
+	for (uint32_t i = 1; i < manifold.PointCount; ++i)
+	{
+		if (manifold.Points[i].PenetrationDepth > manifold.Points[deepest].PenetrationDepth) deepest = i;
+	}
+	outContact = manifold.Points[deepest];
+	return true;
+}
+
+Contact ICollider::MakeContact(ICollider* a, ICollider* b, const DirectX::XMVECTOR& normal,
+	float depth, const DirectX::XMVECTOR& point, uint32_t featureId)
+{
+	const RigidBody* bodyA = a->GetRigidBody();
+	const RigidBody* bodyB = b->GetRigidBody();
+
+	Contact contact{};
+	contact.Colliders[0] = a;
+	contact.Colliders[1] = b;
+	DirectX::XMStoreFloat3(&contact.ContactNormal, normal);
+	DirectX::XMStoreFloat3(&contact.ContactPoint, point);
+	contact.PenetrationDepth = depth;
+	contact.FeatureId = featureId;
+
+	contact.Restitution = Min(bodyA->GetRestitution(), bodyB->GetRestitution());
+	contact.Friction = std::sqrt(bodyA->GetFriction() * bodyB->GetFriction());
+	contact.Elasticity = Min(bodyA->GetElasticity(), bodyB->GetElasticity());
+	return contact;
+}
+
 DirectX::XMMATRIX ICollider::GetTransformationMatrix() const
 {
 	return m_TransformationMatrix;
@@ -47,64 +106,49 @@ void ICollider::Update(float deltaTime)
 		DirectX::XMMatrixScalingFromVector(GetScale()) *
 		DirectX::XMMatrixRotationQuaternion(m_RigidBody->GetOrientation().ToXmVector()) *
 		DirectX::XMMatrixTranslationFromVector(m_RigidBody->GetPosition());
+}
 
-	for (auto& [collider, info] : m_CollidersInfo)
+void ICollider::UpdateSpeculativeDistance(float deltaTime, float margin)
+{
+	//~ Rotation is not swept, the margin covers what a spinning corner adds over one step
+	if (margin <= 0.0f || m_ColliderState != ColliderState::Dynamic)
 	{
-		if (info.HasEntered)
-		{
-			Contact filler;
-			if (!CheckCollision(collider, filler))
-			{
-				if (info.m_OnTriggerExitCallbackFn) info.m_OnTriggerExitCallbackFn();
-				info.HasEntered = false;
-			}
-		}
+		m_SpeculativeDistance = 0.0f;
+		return;
 	}
+
+	const float speed = DirectX::XMVectorGetX(DirectX::XMVector3Length(m_RigidBody->GetVelocity()));
+	m_SpeculativeDistance = margin + speed * deltaTime;
 }
 
 void ICollider::SetTriggerTarget(const TRIGGER_COLLISION_INFO& triggerCollisionInfo)
 {
-	if (!m_CollidersInfo.contains(triggerCollisionInfo.TargetCollider))
+	for (const TRIGGER_COLLISION_INFO& target : m_TriggerTargets)
 	{
-		ColliderInfo info{};
-		info.HasExited = false;
-		info.HasEntered = false;
-		info.m_OnTriggerEnterCallbackFn = triggerCollisionInfo.m_OnTriggerEnterCallbackFn;
-		info.m_OnTriggerExitCallbackFn = triggerCollisionInfo.m_OnTriggerExitCallbackFn;
-		m_CollidersInfo[triggerCollisionInfo.TargetCollider] = std::move(info);
+		if (target.TargetCollider == triggerCollisionInfo.TargetCollider) return;
 	}
+	m_TriggerTargets.push_back(triggerCollisionInfo);
 }
 
-
-void ICollider::RegisterCollision(ICollider* other)
+void ICollider::OnTriggerEvent(const ICollider* other, TriggerEventType type) const
 {
-	// Skip trigger vs trigger collisions
-	if (other->GetColliderState() == ColliderState::Trigger && m_ColliderState == ColliderState::Trigger) return;
-
-	// Let the trigger handle it
-	if (other->GetColliderState() == ColliderState::Trigger)
+	for (const TRIGGER_COLLISION_INFO& target : m_TriggerTargets)
 	{
-		other->RegisterCollision(this);
-		return;
-	}
+		if (target.TargetCollider != other) continue;
 
-	// This is the trigger
-	if (m_ColliderState == ColliderState::Trigger)
-	{
-		auto it = m_CollidersInfo.find(other);
-		if (it != m_CollidersInfo.end())
+		switch (type)
 		{
-			ColliderInfo& info = it->second;
-
-			if (!info.HasEntered)
-			{
-				info.HasEntered = true;
-				info.HasExited = false;
-
-				if (info.m_OnTriggerEnterCallbackFn)
-					info.m_OnTriggerEnterCallbackFn();
-			}
+		case TriggerEventType::Enter:
+			if (target.m_OnTriggerEnterCallbackFn) target.m_OnTriggerEnterCallbackFn();
+			break;
+		case TriggerEventType::Stay:
+			if (target.m_OnTriggerStayCallbackFn) target.m_OnTriggerStayCallbackFn();
+			break;
+		case TriggerEventType::Exit:
+			if (target.m_OnTriggerExitCallbackFn) target.m_OnTriggerExitCallbackFn();
+			break;
 		}
+		return;
 	}
 }
 
@@ -1,17 +1,23 @@
 #pragma once
 
 #include <DirectXMath.h>
-#include <unordered_map>
 #include <functional>
+#include <vector>
 
 #include "RigidBody/RigidBody.h"
+#include "Broadphase/AABB.h"
 
 
 struct Contact;
+struct ContactManifold;
 
 enum class ColliderType : uint8_t
 {
     Cube,
+    Sphere,
+    Capsule,
+    Plane,
+    Count,  //~ number of collider types, sizes the narrowphase table
 };
 
 enum class ColliderState : uint8_t
@@ -21,6 +27,13 @@ enum class ColliderState : uint8_t
     Trigger,
 };
 
+enum class TriggerEventType : uint8_t
+{
+    Enter,
+    Stay,
+    Exit,
+};
+
 class ICollider;
 
 typedef struct TRIGGER_COLLISION_INFO
@@ -28,13 +41,18 @@ typedef struct TRIGGER_COLLISION_INFO
     ICollider* TargetCollider;
     std::function<void()> m_OnTriggerEnterCallbackFn;
     std::function<void()> m_OnTriggerExitCallbackFn;
+    std::function<void()> m_OnTriggerStayCallbackFn;    //~ optional, every step while inside
 
 }TRIGGER_COLLISION_INFO;
 
 class ICollider
 {
 public:
-    ICollider(RigidBody* attachBody);
+    //~ Layers are bit indices into 32 bit masks, used by the broadphase CollisionMatrix and to filter queries
+    static constexpr uint8_t LayerCount = 32;
+    static constexpr uint32_t AllLayers = 0xFFFFFFFFu;
+
+    ICollider(RigidBody* attachBody, ColliderType type);
     virtual ~ICollider() = default;
 
     ICollider(const ICollider&) = default;
@@ -44,25 +62,53 @@ public:
 
     void Update(float deltaTime);
 
+    //~ Callbacks for this trigger and one target, run by the PhysicsSystem after each step
     void SetTriggerTarget(const TRIGGER_COLLISION_INFO& triggerCollisionInfo);
 
+    //~ Runs the callback registered for 'other' (if any), see TriggerPairCache
+    void OnTriggerEvent(const ICollider* other, TriggerEventType type) const;
+
     // Collision interface
-    void RegisterCollision(ICollider* other);
-    virtual bool CheckCollision(ICollider* other, Contact& outContact)  = 0;
-    virtual ColliderType GetColliderType() const                        = 0;
     virtual void SetScale(const DirectX::XMVECTOR& vector)              = 0;
     virtual DirectX::XMVECTOR GetScale() const                          = 0;
+    virtual AABB GetWorldAABB() const                                   = 0;
+
+    //~ How far ahead this collider looks for contacts: 'margin' plus the distance its body
+    //~ travels in 'deltaTime' at the current velocity. Zero for static colliders and triggers.
+    void UpdateSpeculativeDistance(float deltaTime, float margin);
+    float GetSpeculativeDistance() const { return m_SpeculativeDistance; }
+
+    //~ World bounds grown by the speculative distance, what the broadphase pairs on
+    AABB GetBroadphaseAABB() const { return GetWorldAABB().Fattened(m_SpeculativeDistance); }
+
+    //~ Every contact point of the pair, through the CollisionDispatcher table
+    bool GenerateManifold(ICollider* other, ContactManifold& outManifold);
+
+    //~ Deepest point of the manifold, for callers that only need a yes/no and a normal
+    bool CheckCollision(ICollider* other, Contact& outContact);
+
+    ColliderType GetColliderType() const { return m_ColliderType; }
+
+    //~ Contact point between a and b with the combined materials of both bodies
+    static Contact MakeContact(ICollider* a, ICollider* b, const DirectX::XMVECTOR& normal,
+        float depth, const DirectX::XMVECTOR& point, uint32_t featureId = 0);
 
     // Getters
     RigidBody* GetRigidBody() const { return m_RigidBody; }
     ColliderState GetColliderState() const;
+    //~ Static, or dynamic on a kinematic body: contacts cannot move it, a pair of two gets no response
+    bool IsImmovable() const;
     const char* ToString() const;
     const char* GetColliderTypeName() const;
     DirectX::XMMATRIX GetTransformationMatrix() const;
     DirectX::XMMATRIX GetWorldMatrix() const;
 
+    uint8_t GetLayer() const { return m_Layer; }
+    uint32_t GetLayerMask() const { return 1u << m_Layer; }
+
     // Setters
     void SetColliderState(ColliderState state);
+    void SetLayer(uint8_t layer);   //~ 0..LayerCount-1, anything else is ignored
 
     // For type-safe down casting
     template<typename T>
@@ -75,19 +121,14 @@ public:
     static constexpr const T& Min(const T& a, const T& b);
 
 protected:
-    //~ Callback on Collision
-
-    struct ColliderInfo
-    {
-        bool HasEntered;
-        bool HasExited;
-        std::function<void()> m_OnTriggerEnterCallbackFn;
-        std::function<void()> m_OnTriggerExitCallbackFn;
-    };
-    std::unordered_map<ICollider*, ColliderInfo> m_CollidersInfo{};
+    //~ Callback on Collision (a handful per trigger, searched linearly)
+    std::vector<TRIGGER_COLLISION_INFO> m_TriggerTargets{};
 
     DirectX::XMMATRIX m_TransformationMatrix{};
     ColliderState m_ColliderState{ ColliderState::Static };
+    ColliderType m_ColliderType;
+    uint8_t m_Layer{ 0 };
+    float m_SpeculativeDistance{ 0.0f };
     RigidBody* m_RigidBody;
 };
 
@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "PlaneCollider.h"
+#include "Collision/Contact.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/Capsule/CapsuleCollider.h"
+#include "Collision/Sphere/SphereCollider.h"
+
+
+PlaneCollider::PlaneCollider(RigidBody* body)
+    : ICollider(body, ColliderType::Plane)
+{}
+
+void PlaneCollider::SetScale(const DirectX::XMVECTOR& vector)
+{
+    m_Scale = vector;
+}
+
+DirectX::XMVECTOR PlaneCollider::GetScale() const
+{
+    return m_Scale;
+}
+
+AABB PlaneCollider::GetWorldAABB() const
+{
+    using namespace DirectX;
+
+    // Slab of BroadphaseExtent behind the surface, so a level aligned plane only
+    // pairs with what is at or below it
+    const XMMATRIX rotation = XMMatrixRotationQuaternion(m_RigidBody->GetOrientation().ToXmVector());
+    const XMVECTOR center = XMVectorSubtract(GetPoint(), XMVectorScale(GetNormal(), 0.5f * BroadphaseExtent));
+    const XMMATRIX world = rotation * XMMatrixTranslationFromVector(center);
+
+    return AABB::FromTransform(world, XMVectorSet(BroadphaseExtent, 0.5f * BroadphaseExtent, BroadphaseExtent, 0.0f));
+}
+
+DirectX::XMVECTOR PlaneCollider::GetNormal() const
+{
+    using namespace DirectX;
+    return XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), m_RigidBody->GetOrientation().ToXmVector());
+}
+
+DirectX::XMVECTOR PlaneCollider::GetPoint() const
+{
+    return m_RigidBody->GetPosition();
+}
+
+float PlaneCollider::GetDistance(const DirectX::XMVECTOR& point) const
+{
+    using namespace DirectX;
+    return XMVectorGetX(XMVector3Dot(XMVectorSubtract(point, GetPoint()), GetNormal()));
+}
+
+bool PlaneCollider::CollidePlaneSphere(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    //~ The dispatch table only sends (plane, sphere) here
+    const PlaneCollider* A = static_cast<const PlaneCollider*>(a);
+    const SphereCollider* B = static_cast<const SphereCollider*>(b);
+
+    const XMVECTOR center = B->GetCenter();
+    const float depth = B->GetRadius() - A->GetDistance(center);
+    if (depth <= -outManifold.SpeculativeMargin) return false;
+
+    const XMVECTOR normal = A->GetNormal();
+    const XMVECTOR deepest = XMVectorSubtract(center, XMVectorScale(normal, B->GetRadius()));
+    outManifold.AddPoint(MakeContact(a, b, normal, depth, XMVectorAdd(deepest, XMVectorScale(normal, 0.5f * depth))));
+    return true;
+}
+
+//~ Each cap is a sphere against the plane, so a capsule lying flat gets two points
+bool PlaneCollider::CollidePlaneCapsule(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    using namespace DirectX;
+
+    //~ The dispatch table only sends (plane, capsule) here
+    const PlaneCollider* A = static_cast<const PlaneCollider*>(a);
+    const CapsuleCollider* B = static_cast<const CapsuleCollider*>(b);
+
+    XMVECTOR caps[2];
+    B->GetSegment(caps[0], caps[1]);
+    const XMVECTOR normal = A->GetNormal();
+    const float radius = B->GetRadius();
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        const float depth = radius - A->GetDistance(caps[i]);
+        if (depth <= -outManifold.SpeculativeMargin) continue;
+
+        const XMVECTOR deepest = XMVectorSubtract(caps[i], XMVectorScale(normal, radius));
+        outManifold.AddPoint(MakeContact(a, b, normal, depth, XMVectorAdd(deepest, XMVectorScale(normal, 0.5f * depth)), i + 1));
+    }
+    return outManifold.PointCount > 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Collision/ICollider.h"
+
+
+// Infinite plane through the body position, facing along the body's local +Y axis.
+// Everything behind the surface counts as inside, so thin ground boxes no longer tunnel.
+// Meant for static level geometry: it has no volume to give a moving body inertia.
+class PlaneCollider final : public ICollider
+{
+public:
+	//~ How far the broadphase bounds reach along and behind the surface
+	static constexpr float BroadphaseExtent = 1.0e4f;
+
+	PlaneCollider(RigidBody* body);
+	~PlaneCollider() override = default;
+
+	PlaneCollider(const PlaneCollider&) = default;
+	PlaneCollider(PlaneCollider&&) = default;
+	PlaneCollider& operator=(const PlaneCollider&) = default;
+	PlaneCollider& operator=(PlaneCollider&&) = default;
+
+	//~ Collision Interface
+	void SetScale(const DirectX::XMVECTOR& vector) override;
+	DirectX::XMVECTOR GetScale() const override;
+	AABB GetWorldAABB() const override;
+
+	//~ CollisionDispatcher table entries
+	static bool CollidePlaneSphere(ICollider* a, ICollider* b, ContactManifold& outManifold);
+	static bool CollidePlaneCapsule(ICollider* a, ICollider* b, ContactManifold& outManifold);
+
+	//~ Plane Specifics
+	DirectX::XMVECTOR GetNormal() const;
+	DirectX::XMVECTOR GetPoint() const;
+
+	//~ Signed distance of 'point' from the surface, negative behind it
+	float GetDistance(const DirectX::XMVECTOR& point) const;
+
+private:
+	DirectX::XMVECTOR m_Scale{ 1.0f, 1.0f, 1.0f };	//~ kept for the debug draw only
+};
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "SphereCollider.h"
+#include "Collision/Contact.h"
+#include "Collision/ContactManifold.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+SphereCollider::SphereCollider(RigidBody* body)
+    : ICollider(body, ColliderType::Sphere)
+{
+    m_RigidBody->ComputeInverseInertiaTensorSphere(m_Radius);
+}
+
+void SphereCollider::SetScale(const DirectX::XMVECTOR& vector)
+{
+    using namespace DirectX;
+
+    m_Scale = vector;
+    XMFLOAT3 scale; XMStoreFloat3(&scale, XMVectorAbs(m_Scale));
+    m_Radius = (std::max)({ scale.x, scale.y, scale.z });
+    m_RigidBody->ComputeInverseInertiaTensorSphere(m_Radius);
+}
+
+DirectX::XMVECTOR SphereCollider::GetScale() const
+{
+    return m_Scale;
+}
+
+void SphereCollider::SetRadius(float radius)
+{
+    SetScale(DirectX::XMVectorReplicate(radius));
+}
+
+AABB SphereCollider::GetWorldAABB() const
+{
+    using namespace DirectX;
+
+    const XMVECTOR center = GetCenter();
+    const XMVECTOR extent = XMVectorReplicate(m_Radius);
+
+    AABB box;
+    XMStoreFloat3(&box.Min, XMVectorSubtract(center, extent));
+    XMStoreFloat3(&box.Max, XMVectorAdd(center, extent));
+    return box;
+}
+
+DirectX::XMVECTOR SphereCollider::GetCenter() const
+{
+    return m_RigidBody->GetPosition();
+}
+
+bool SphereCollider::CollideSpheres(ICollider* a, ICollider* b, ContactManifold& outManifold)
+{
+    //~ The dispatch table only sends spheres here
+    const SphereCollider* A = static_cast<const SphereCollider*>(a);
+    const SphereCollider* B = static_cast<const SphereCollider*>(b);
+
+    Contact contact;
+    if (!CollideSpherePoints(a, b, A->GetCenter(), A->GetRadius(), B->GetCenter(), B->GetRadius(),
+        DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), 0, contact, outManifold.SpeculativeMargin))
+    {
+        return false;
+    }
+    outManifold.AddPoint(contact);
+    return true;
+}
+
+bool SphereCollider::CollideSpherePoints(ICollider* a, ICollider* b,
+    const DirectX::XMVECTOR& centerA, float radiusA,
+    const DirectX::XMVECTOR& centerB, float radiusB,
+    const DirectX::XMVECTOR& fallbackNormal, uint32_t featureId, Contact& outContact, float margin)
+{
+    using namespace DirectX;
+
+    const XMVECTOR offset = XMVectorSubtract(centerB, centerA);
+    const float distanceSq = XMVectorGetX(XMVector3LengthSq(offset));
+    const float radii = radiusA + radiusB;
+    const float reach = radii + margin;
+    if (distanceSq >= reach * reach) return false;
+
+    const float distance = std::sqrt(distanceSq);
+    const XMVECTOR normal = distance > 1e-6f ? XMVectorScale(offset, 1.0f / distance) : fallbackNormal;
+    const float depth = radii - distance;
+
+    //~ Halfway between the two surfaces (across the gap for a speculative contact)
+    const XMVECTOR point = XMVectorAdd(centerA, XMVectorScale(normal, radiusA - 0.5f * depth));
+    outContact = MakeContact(a, b, normal, depth, point, featureId);
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "Collision/ICollider.h"
+
+
+// Sphere around the body position. Like the cube, the scale is the half extent: the radius
+// is the largest scale component, so a sphere fits the cube of the same scale.
+class SphereCollider final : public ICollider
+{
+public:
+	SphereCollider(RigidBody* body);
+	~SphereCollider() override = default;
+
+	SphereCollider(const SphereCollider&) = default;
+	SphereCollider(SphereCollider&&) = default;
+	SphereCollider& operator=(const SphereCollider&) = default;
+	SphereCollider& operator=(SphereCollider&&) = default;
+
+	//~ Collision Interface
+	void SetScale(const DirectX::XMVECTOR& vector) override;
+	DirectX::XMVECTOR GetScale() const override;
+	AABB GetWorldAABB() const override;
+
+	//~ Sphere vs sphere entry of the CollisionDispatcher table
+	static bool CollideSpheres(ICollider* a, ICollider* b, ContactManifold& outManifold);
+
+	//~ Sphere Specifics
+	void SetRadius(float radius);
+	float GetRadius() const { return m_Radius; }
+	DirectX::XMVECTOR GetCenter() const;
+
+	//~ Shared by every pair that reduces to two spheres (capsule segments, box closest points).
+	//~ The normal points from centerA to centerB, falls back to 'fallbackNormal' when they meet.
+	//~ Surfaces up to 'margin' apart still give a (speculative) contact.
+	static bool CollideSpherePoints(ICollider* a, ICollider* b,
+		const DirectX::XMVECTOR& centerA, float radiusA,
+		const DirectX::XMVECTOR& centerB, float radiusB,
+		const DirectX::XMVECTOR& fallbackNormal, uint32_t featureId, Contact& outContact, float margin = 0.0f);
+
+private:
+	DirectX::XMVECTOR m_Scale{ 1.0f, 1.0f, 1.0f };
+	float m_Radius{ 1.0f };
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+
+class ICollider;
+
+// Order independent key for a pair of colliders, the lower address always goes first
+struct ColliderPairKey
+{
+    const ICollider* A;
+    const ICollider* B;
+
+    static ColliderPairKey Make(const ICollider* a, const ICollider* b)
+    {
+        if (std::less<const ICollider*>{}(b, a)) return { b, a };
+        return { a, b };
+    }
+
+    bool Contains(const ICollider* collider) const { return A == collider || B == collider; }
+    bool operator==(const ColliderPairKey& other) const { return A == other.A && B == other.B; }
+};
+
+struct ColliderPairKeyHash
+{
+    size_t operator()(const ColliderPairKey& key) const
+    {
+        const size_t a = std::hash<const ICollider*>{}(key.A);
+        const size_t b = std::hash<const ICollider*>{}(key.B);
+        return a ^ (b + 0x9e3779b9 + (a << 6) + (a >> 2));
+    }
+};
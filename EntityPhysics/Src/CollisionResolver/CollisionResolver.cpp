@@ -2,7 +2,6 @@
 #include "CollisionResolver.h"
 
 #include <algorithm>
-#include <random>
 
 void CollisionResolver::ResolveContact(Contact& contact, float deltaTime)
 {
@@ -86,13 +85,20 @@ void CollisionResolver::ResolvePenetration(Contact& contact, float deltaTime)
 
         XMVECTOR correction = XMVectorScale(normal, (penetration * percent) / totalInvMass);
 
-        XMVECTOR posA = bodyA->GetPosition();
-        posA = XMVectorSubtract(posA, XMVectorScale(correction, invMassA));
-        bodyA->SetPosition(posA);
+        //~ Immovable bodies may be shared by islands solved on other threads, leave them untouched
+        if (invMassA > 0.0f)
+        {
+            XMVECTOR posA = bodyA->GetPosition();
+            posA = XMVectorSubtract(posA, XMVectorScale(correction, invMassA));
+            bodyA->SetPosition(posA);
+        }
 
-        XMVECTOR posB = bodyB->GetPosition();
-        posB = XMVectorAdd(posB, XMVectorScale(correction, invMassB));
-        bodyB->SetPosition(posB);
+        if (invMassB > 0.0f)
+        {
+            XMVECTOR posB = bodyB->GetPosition();
+            posB = XMVectorAdd(posB, XMVectorScale(correction, invMassB));
+            bodyB->SetPosition(posB);
+        }
     }
 }
 
@@ -213,7 +219,7 @@ void CollisionResolver::ResolveFrictionWithCubeVsCube(Contact& contact, float de
     XMVECTOR vTangent = XMVectorSubtract(vRel, vRelNormal);
 
     // Skip if no tangent movement
-    if (XMVector3LengthSq(vTangent).m128_f32[0] < 1e-6f)
+    if (XMVectorGetX(XMVector3LengthSq(vTangent)) < 1e-6f)
         return;
 
     XMVECTOR tangent = XMVector3Normalize(vTangent);
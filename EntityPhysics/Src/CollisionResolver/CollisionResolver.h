@@ -11,10 +11,12 @@ public:
     // Resolve a batch of contacts (e.g. from PhysicsManager)
     static void ResolveContacts(std::vector<Contact>& contacts, float deltaTime);
 
+    // Positional correction along the contact normal, split by inverse mass
+    static void ResolvePenetration(Contact& contact, float deltaTime);
+
 private:
     //~ Cube vs Cube
     static void ResolveContactWithCubeVsCube(Contact& contact, float deltaTime);
-    static void ResolvePenetration(Contact& contact, float deltaTime);
     static void ResolveVelocityWithCubeVsCube(Contact& contact, float deltaTime);
     static void ResolveFrictionWithCubeVsCube(Contact& contact, float deltaTime);
     static void ResolveAngularDampingWithCubeVsCube(Contact& contact, float deltaTime);
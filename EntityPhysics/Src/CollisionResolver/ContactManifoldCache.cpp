@@ -0,0 +1,150 @@
+#include "pch.h"
+#include <cstdlib>
+#include "ContactManifoldCache.h"
+#include "State/StateBuffer.h"
+
+
+ContactManifold& ContactManifoldCache::Update(const ContactManifold& manifold)
+{
+    using namespace DirectX;
+
+    Entry& entry = m_Manifolds[ColliderPairKey::Make(manifold.Colliders[0], manifold.Colliders[1])];
+    const ContactManifold previous = entry.Manifold;
+
+    entry.Manifold = manifold;
+    entry.Touched = true;
+
+    ContactManifold& current = entry.Manifold;
+    if (current.PointCount == 0) return current;
+
+    RigidBody* bodyA = current.Colliders[0]->GetRigidBody();
+    const XMVECTOR position = bodyA->GetPosition();
+    const XMVECTOR orientation = bodyA->GetOrientation().ToXmVector();
+
+    for (uint32_t i = 0; i < current.PointCount; ++i)
+    {
+        Contact& point = current.Points[i];
+        const XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&point.ContactPoint), position);
+        XMStoreFloat3(&point.LocalPoint, XMVector3InverseRotate(offset, orientation));
+    }
+
+    //~ Impulses only carry over when the pair and its normal are still the same way round
+    if (previous.PointCount == 0 || previous.Colliders[0] != current.Colliders[0]) return current;
+
+    const XMVECTOR oldNormal = XMLoadFloat3(&previous.Points[0].ContactNormal);
+    const XMVECTOR newNormal = XMLoadFloat3(&current.Points[0].ContactNormal);
+    if (XMVectorGetX(XMVector3Dot(oldNormal, newNormal)) < 0.95f) return current;
+
+    const float matchDistanceSq = 0.05f * 0.05f;
+    bool oldMatched[ContactManifold::MaxPoints]{};
+    bool newMatched[ContactManifold::MaxPoints]{};
+    for (uint32_t i = 0; i < current.PointCount; ++i)
+    {
+        Contact& point = current.Points[i];
+        const XMVECTOR local = XMLoadFloat3(&point.LocalPoint);
+
+        for (uint32_t j = 0; j < previous.PointCount; ++j)
+        {
+            const Contact& old = previous.Points[j];
+            if (oldMatched[j]) continue;
+
+            //~ Faces lying flush swap clip features on rounding alone, so a point that stayed put
+            //~ still counts as the same one
+            const bool matches = (point.FeatureId != 0 && old.FeatureId == point.FeatureId) ||
+                XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(local, XMLoadFloat3(&old.LocalPoint)))) < matchDistanceSq;
+            if (!matches) continue;
+
+            point.NormalImpulseMagnitude = old.NormalImpulseMagnitude;
+            point.TangentImpulseMagnitude[0] = old.TangentImpulseMagnitude[0];
+            point.TangentImpulseMagnitude[1] = old.TangentImpulseMagnitude[1];
+            oldMatched[j] = newMatched[i] = true;
+            break;
+        }
+    }
+
+    //~ When a face contact swaps some points for others the load the old ones carried is shared
+    //~ by the new ones, so a resting body keeps its support instead of dropping for a step
+    float normalImpulse = 0.0f;
+    float tangentImpulse[2]{ 0.0f, 0.0f };
+    uint32_t unmatched = 0;
+    for (uint32_t j = 0; j < previous.PointCount; ++j)
+    {
+        if (oldMatched[j]) continue;
+        normalImpulse += previous.Points[j].NormalImpulseMagnitude;
+        tangentImpulse[0] += previous.Points[j].TangentImpulseMagnitude[0];
+        tangentImpulse[1] += previous.Points[j].TangentImpulseMagnitude[1];
+    }
+    for (uint32_t i = 0; i < current.PointCount; ++i) unmatched += newMatched[i] ? 0 : 1;
+    if (unmatched == 0 || normalImpulse <= 0.0f) return current;
+
+    const float share = 1.0f / static_cast<float>(unmatched);
+    for (uint32_t i = 0; i < current.PointCount; ++i)
+    {
+        if (newMatched[i]) continue;
+        current.Points[i].NormalImpulseMagnitude = normalImpulse * share;
+        current.Points[i].TangentImpulseMagnitude[0] = tangentImpulse[0] * share;
+        current.Points[i].TangentImpulseMagnitude[1] = tangentImpulse[1] * share;
+    }
+    return current;
+}
+
+void ContactManifoldCache::Keep(const ICollider* a, const ICollider* b)
+{
+    const auto it = m_Manifolds.find(ColliderPairKey::Make(a, b));
+    if (it != m_Manifolds.end()) it->second.Touched = true;
+}
+
+void ContactManifoldCache::Prune()
+{
+    for (auto it = m_Manifolds.begin(); it != m_Manifolds.end();)
+    {
+        if (!it->second.Touched)
+        {
+            it = m_Manifolds.erase(it);
+            continue;
+        }
+        it->second.Touched = false;
+        ++it;
+    }
+}
+
+void ContactManifoldCache::RemoveCollider(const ICollider* collider)
+{
+    std::erase_if(m_Manifolds, [collider](const auto& item)
+    {
+        return item.first.Contains(collider);
+    });
+}
+
+void ContactManifoldCache::Clear()
+{
+    m_Manifolds.clear();
+}
+
+void ContactManifoldCache::SaveState(StateWriter& writer) const
+{
+    writer.Write(static_cast<uint64_t>(m_Manifolds.size()));
+    for (const auto& [key, entry] : m_Manifolds)
+    {
+        writer.Write(key);
+        writer.Write(entry.Manifold);
+        writer.Write(entry.Touched);
+    }
+}
+
+bool ContactManifoldCache::RestoreState(StateReader& reader)
+{
+    uint64_t count = 0;
+    if (!reader.Read(count)) return false;
+
+    m_Manifolds.clear();
+    m_Manifolds.reserve(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        ColliderPairKey key{};
+        Entry entry{};
+        if (!reader.Read(key) || !reader.Read(entry.Manifold) || !reader.Read(entry.Touched)) return false;
+        m_Manifolds.emplace(key, entry);
+    }
+    return true;
+}
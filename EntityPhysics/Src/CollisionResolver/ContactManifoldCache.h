@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <unordered_map>
+#include "Collision/ContactManifold.h"
+#include "ColliderPairKey.h"
+
+class StateReader;
+class StateWriter;
+
+// Keeps one manifold per touching collider pair across steps. Each step the narrowphase
+// result replaces the stored points, but points that match an old one (same feature id, or
+// close enough in Body[0] space when the feature is unknown) inherit its accumulated
+// impulses so the solver can start from last step's answer.
+class ContactManifoldCache
+{
+public:
+    //~ Merges this step's manifold into the pair's stored one; the reference stays valid until Prune
+    ContactManifold& Update(const ContactManifold& manifold);
+
+    //~ Keeps a pair that was not tested this step (both asleep) alive through Prune
+    void Keep(const ICollider* a, const ICollider* b);
+
+    //~ Forgets every pair that was not updated since the previous Prune
+    void Prune();
+
+    void RemoveCollider(const ICollider* collider);
+    void Clear();
+
+    //~ Stored manifolds with their accumulated impulses, so a rollback warm starts the same way
+    void SaveState(StateWriter& writer) const;
+    bool RestoreState(StateReader& reader);
+
+    size_t GetManifoldCount() const { return m_Manifolds.size(); }
+
+private:
+    struct Entry
+    {
+        ContactManifold Manifold{};
+        bool Touched{ false };
+    };
+
+private:
+    std::unordered_map<ColliderPairKey, Entry, ColliderPairKeyHash> m_Manifolds{};
+};
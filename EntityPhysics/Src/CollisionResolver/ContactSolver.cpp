@@ -0,0 +1,301 @@
+#include "pch.h"
+#include "ContactSolver.h"
+#include "Constraint/Constraint.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+void ContactSolver::Solve(const std::vector<ContactManifold*>& manifolds, const std::vector<Constraint*>& constraints,
+    float deltaTime)
+{
+    if (deltaTime <= 0.0f) return;
+
+    m_Bodies.clear();
+    m_Points.clear();
+    m_Constraints.clear();
+    m_BodyLookup.clear();
+
+    PrepareContacts(manifolds, deltaTime);
+    PrepareConstraints(constraints, deltaTime);
+    if (m_Points.empty() && m_Constraints.empty()) return;
+
+    WarmStart();
+    for (uint32_t i = 0; i < m_Iterations; ++i)
+    {
+        SolveVelocities(i >= m_Iterations / 2);
+    }
+    m_IterationsRun += m_Iterations;
+    StoreResults();
+
+    for (uint32_t i = 0; i < m_Iterations; ++i)
+    {
+        SolvePositions();
+    }
+    CorrectPositions(deltaTime);
+}
+
+uint32_t ContactSolver::GetSolverBody(const ICollider* collider)
+{
+    //~ Static colliders act as infinite mass whatever their body says. Kinematic bodies have zero
+    //~ inverse mass but keep their velocity here, which resting contacts then pick up.
+    RigidBody* body = collider->GetRigidBody();
+    return GetSolverBody(body, collider->GetColliderState() == ColliderState::Static || !body->HasFiniteMass());
+}
+
+uint32_t ContactSolver::GetSolverBody(RigidBody* body, bool isStatic)
+{
+    using namespace DirectX;
+
+    const auto it = m_BodyLookup.find(body);
+    if (it != m_BodyLookup.end()) return it->second;
+
+    SolverBody solverBody{};
+    solverBody.Body = body;
+    solverBody.LinearVelocity = body ? body->GetVelocity() : XMVectorZero();
+    solverBody.AngularVelocity = body ? body->GetAngularVelocity() : XMVectorZero();
+    solverBody.InverseMass = isStatic ? 0.0f : body->GetInverseMass();
+    solverBody.InverseInertia = isStatic ? XMMATRIX(XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero())
+                                         : body->GetInverseInertiaTensorWorld();
+
+    const uint32_t index = static_cast<uint32_t>(m_Bodies.size());
+    m_Bodies.push_back(solverBody);
+    m_BodyLookup.emplace(body, index);
+    return index;
+}
+
+void ContactSolver::PrepareContacts(const std::vector<ContactManifold*>& manifolds, float deltaTime)
+{
+    using namespace DirectX;
+
+    for (ContactManifold* manifold : manifolds)
+    {
+        const ICollider* colliderA = manifold->Colliders[0];
+        const ICollider* colliderB = manifold->Colliders[1];
+        if (!colliderA || !colliderB || manifold->PointCount == 0) continue;
+
+        if (colliderA->GetColliderState() == ColliderState::Trigger ||
+            colliderB->GetColliderState() == ColliderState::Trigger) continue;
+        if (colliderA->IsImmovable() && colliderB->IsImmovable()) continue;
+
+        const uint32_t bodyA = GetSolverBody(colliderA);
+        const uint32_t bodyB = GetSolverBody(colliderB);
+        if (m_Bodies[bodyA].InverseMass + m_Bodies[bodyB].InverseMass <= 0.0f) continue;
+
+        const XMVECTOR centerA = m_Bodies[bodyA].Body->GetPosition();
+        const XMVECTOR centerB = m_Bodies[bodyB].Body->GetPosition();
+
+        for (uint32_t i = 0; i < manifold->PointCount; ++i)
+        {
+            Contact& contact = manifold->Points[i];
+            const XMVECTOR contactPoint = XMLoadFloat3(&contact.ContactPoint);
+
+            SolverPoint point{};
+            point.Source = &contact;
+            point.BodyA = bodyA;
+            point.BodyB = bodyB;
+            point.Normal = XMVector3Normalize(XMLoadFloat3(&contact.ContactNormal));
+            ComputeTangents(point.Normal, point.Tangents);
+            point.RelativeA = XMVectorSubtract(contactPoint, centerA);
+            point.RelativeB = XMVectorSubtract(contactPoint, centerB);
+            point.Friction = contact.Friction;
+
+            const float normalMass = GetEffectiveMass(point, point.Normal);
+            point.NormalMass = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+            for (int t = 0; t < 2; ++t)
+            {
+                const float tangentMass = GetEffectiveMass(point, point.Tangents[t]);
+                point.TangentMass[t] = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+            }
+
+            //~ Points bounce only when the bodies hit hard enough, resting contacts just stop.
+            //~ A speculative point lets the pair close at most its gap this step, and bounces off
+            //~ the pre-solve speed once that speed would close the gap within the step.
+            const float closingSpeed = XMVectorGetX(XMVector3Dot(GetRelativeVelocity(point), point.Normal));
+            const bool speculative = contact.PenetrationDepth < 0.0f && deltaTime > 0.0f;
+            const bool closes = !speculative || closingSpeed * deltaTime <= contact.PenetrationDepth;
+
+            point.Bias = speculative ? contact.PenetrationDepth / deltaTime : 0.0f;
+            if (closes && closingSpeed < -m_RestitutionThreshold)
+            {
+                point.Bias = (std::max)(point.Bias, -contact.Restitution * contact.Elasticity * closingSpeed);
+            }
+            point.PenetrationBias = m_PenetrationFactor * (std::max)(contact.PenetrationDepth - m_PenetrationSlop, 0.0f) / deltaTime;
+
+            m_Points.push_back(point);
+        }
+    }
+}
+
+// The world (a null body) and bodies without finite mass stay put
+void ContactSolver::PrepareConstraints(const std::vector<Constraint*>& constraints, float deltaTime)
+{
+    auto isStatic = [](const RigidBody* body) { return !body || !body->HasFiniteMass(); };
+
+    for (Constraint* constraint : constraints)
+    {
+        RigidBody* bodyA = constraint->GetBodyA();
+        RigidBody* bodyB = constraint->GetBodyB();
+
+        const uint32_t a = GetSolverBody(bodyA, isStatic(bodyA));
+        const uint32_t b = GetSolverBody(bodyB, isStatic(bodyB));
+        if (m_Bodies[a].InverseMass + m_Bodies[b].InverseMass <= 0.0f) continue;
+
+        constraint->Prepare(m_Bodies[a], m_Bodies[b], deltaTime);
+        m_Constraints.push_back({ constraint, a, b });
+    }
+}
+
+void ContactSolver::WarmStart()
+{
+    using namespace DirectX;
+
+    for (const SolverConstraint& constraint : m_Constraints)
+    {
+        constraint.Source->WarmStart(m_Bodies[constraint.BodyA], m_Bodies[constraint.BodyB]);
+    }
+
+    for (const SolverPoint& point : m_Points)
+    {
+        const Contact& contact = *point.Source;
+
+        XMVECTOR impulse = XMVectorScale(point.Normal, contact.NormalImpulseMagnitude);
+        impulse = XMVectorAdd(impulse, XMVectorScale(point.Tangents[0], contact.TangentImpulseMagnitude[0]));
+        impulse = XMVectorAdd(impulse, XMVectorScale(point.Tangents[1], contact.TangentImpulseMagnitude[1]));
+        ApplyImpulse(point, impulse);
+    }
+}
+
+void ContactSolver::SolveVelocities(bool backwards)
+{
+    using namespace DirectX;
+
+    for (const SolverConstraint& constraint : m_Constraints)
+    {
+        constraint.Source->SolveVelocities(m_Bodies[constraint.BodyA], m_Bodies[constraint.BodyB]);
+    }
+
+    const size_t count = m_Points.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        SolverPoint& point = m_Points[backwards ? count - 1 - i : i];
+        Contact& contact = *point.Source;
+
+        //~ Friction first so the normal constraint has the last word
+        const float maxFriction = point.Friction * contact.NormalImpulseMagnitude;
+        for (int t = 0; t < 2; ++t)
+        {
+            const float speed = XMVectorGetX(XMVector3Dot(GetRelativeVelocity(point), point.Tangents[t]));
+            const float previous = contact.TangentImpulseMagnitude[t];
+            contact.TangentImpulseMagnitude[t] = std::clamp(previous - speed * point.TangentMass[t], -maxFriction, maxFriction);
+
+            ApplyImpulse(point, XMVectorScale(point.Tangents[t], contact.TangentImpulseMagnitude[t] - previous));
+        }
+
+        //~ Accumulated normal impulse may only push
+        const float speed = XMVectorGetX(XMVector3Dot(GetRelativeVelocity(point), point.Normal));
+        const float previous = contact.NormalImpulseMagnitude;
+        contact.NormalImpulseMagnitude = (std::max)(0.0f, previous + (point.Bias - speed) * point.NormalMass);
+
+        ApplyImpulse(point, XMVectorScale(point.Normal, contact.NormalImpulseMagnitude - previous));
+    }
+}
+
+void ContactSolver::StoreResults()
+{
+    for (const SolverBody& body : m_Bodies)
+    {
+        if (body.InverseMass <= 0.0f) continue;
+
+        body.Body->SetVelocity(body.LinearVelocity);
+        body.Body->SetAngularVelocity(body.AngularVelocity);
+    }
+}
+
+// Normal constraints only, on the pseudo velocities, and only where the bodies overlap
+void ContactSolver::SolvePositions()
+{
+    using namespace DirectX;
+
+    for (SolverPoint& point : m_Points)
+    {
+        if (point.PenetrationBias <= 0.0f) continue;
+
+        SolverBody& a = m_Bodies[point.BodyA];
+        SolverBody& b = m_Bodies[point.BodyB];
+        const XMVECTOR velocity = XMVectorSubtract(b.GetPseudoPointVelocity(point.RelativeB), a.GetPseudoPointVelocity(point.RelativeA));
+        const float speed = XMVectorGetX(XMVector3Dot(velocity, point.Normal));
+        const float previous = point.PseudoImpulse;
+        point.PseudoImpulse = (std::max)(0.0f, previous + (point.PenetrationBias - speed) * point.NormalMass);
+
+        const XMVECTOR impulse = XMVectorScale(point.Normal, point.PseudoImpulse - previous);
+        a.ApplyPseudoImpulse(XMVectorNegate(impulse), point.RelativeA);
+        b.ApplyPseudoImpulse(impulse, point.RelativeB);
+    }
+}
+
+// Moves and turns every body by its pseudo velocities, which are then dropped
+void ContactSolver::CorrectPositions(float deltaTime)
+{
+    using namespace DirectX;
+
+    for (const SolverBody& body : m_Bodies)
+    {
+        if (body.InverseMass <= 0.0f) continue;
+
+        if (!XMVector3Equal(body.PseudoLinearVelocity, XMVectorZero()))
+        {
+            body.Body->SetPosition(XMVectorMultiplyAdd(body.PseudoLinearVelocity, XMVectorReplicate(deltaTime), body.Body->GetPosition()));
+        }
+        if (!XMVector3Equal(body.PseudoAngularVelocity, XMVectorZero()))
+        {
+            //~ The pseudo velocity is in world space, so q += (0, w) * q * dt / 2. AddScaledVector
+            //~ turns about the body axes instead, which tips a yawed body the wrong way.
+            const XMVECTOR orientation = body.Body->GetOrientation().ToXmVector();
+            const XMVECTOR spin = XMQuaternionMultiply(orientation,
+                XMVectorSetW(XMVectorScale(body.PseudoAngularVelocity, deltaTime), 0.0f));
+            body.Body->SetOrientation(Quaternion(XMVectorMultiplyAdd(spin, XMVectorReplicate(0.5f), orientation)));
+        }
+    }
+}
+
+// Impulse acts on B along +normal and on A along -normal
+void ContactSolver::ApplyImpulse(const SolverPoint& point, const DirectX::XMVECTOR& impulse)
+{
+    m_Bodies[point.BodyA].ApplyImpulse(DirectX::XMVectorNegate(impulse), point.RelativeA);
+    m_Bodies[point.BodyB].ApplyImpulse(impulse, point.RelativeB);
+}
+
+//~ Velocity of B's contact point relative to A's
+DirectX::XMVECTOR ContactSolver::GetRelativeVelocity(const SolverPoint& point) const
+{
+    return DirectX::XMVectorSubtract(m_Bodies[point.BodyB].GetPointVelocity(point.RelativeB),
+        m_Bodies[point.BodyA].GetPointVelocity(point.RelativeA));
+}
+
+float ContactSolver::GetEffectiveMass(const SolverPoint& point, const DirectX::XMVECTOR& direction) const
+{
+    using namespace DirectX;
+
+    const SolverBody& a = m_Bodies[point.BodyA];
+    const SolverBody& b = m_Bodies[point.BodyB];
+    return a.InverseMass + b.InverseMass
+        + a.GetAngularMass(XMVector3Cross(point.RelativeA, direction))
+        + b.GetAngularMass(XMVector3Cross(point.RelativeB, direction));
+}
+
+// Fixed basis built from the normal alone, so last step's tangent impulses still point the same way
+void ContactSolver::ComputeTangents(const DirectX::XMVECTOR& normal, DirectX::XMVECTOR outTangents[2])
+{
+    using namespace DirectX;
+
+    XMFLOAT3 n;
+    XMStoreFloat3(&n, normal);
+
+    XMVECTOR tangent;
+    if (fabsf(n.x) >= 0.57735f) tangent = XMVectorSet(n.y, -n.x, 0.0f, 0.0f);
+    else tangent = XMVectorSet(0.0f, n.z, -n.y, 0.0f);
+
+    outTangents[0] = XMVector3Normalize(tangent);
+    outTangents[1] = XMVector3Cross(normal, outTangents[0]);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "Collision/ContactManifold.h"
+#include "SolverBody.h"
+
+class Constraint;
+
+
+// Sequential impulse solver over contact manifolds.
+// Every point gets a normal constraint and two friction constraints. The impulses
+// accumulated last step (stored in the Contact by ContactManifoldCache) are applied up
+// front, so a resting stack starts from an almost converged state and only needs a few
+// iterations. The second half of the iterations walks the points backwards, which spreads
+// the load through a tall stack much faster than always starting from the same end.
+// Overlap beyond a small slop is pushed apart by split impulses: the normal constraints run
+// again on pseudo velocities that only move and turn the bodies, so removing penetration
+// never adds energy to the real velocities and a stack can come to rest.
+// Constraints (joints) between the bodies of the island run in the same iterations, before
+// the contacts so those have the last word, and are warm started from their own impulses.
+class ContactSolver
+{
+public:
+    ContactSolver() = default;
+    ~ContactSolver() = default;
+
+    ContactSolver(const ContactSolver&) = delete;
+    ContactSolver(ContactSolver&&) = default;
+    ContactSolver& operator=(const ContactSolver&) = delete;
+    ContactSolver& operator=(ContactSolver&&) = default;
+
+    //~ Solves every manifold and constraint, and writes the final impulses back into them
+    void Solve(const std::vector<ContactManifold*>& manifolds, const std::vector<Constraint*>& constraints,
+        float deltaTime);
+
+    void SetIterations(uint32_t iterations) { m_Iterations = iterations; }
+    uint32_t GetIterations() const { return m_Iterations; }
+
+    //~ Velocity iterations run since the last reset, summed over every Solve call that had work
+    uint32_t GetIterationsRun() const { return m_IterationsRun; }
+    void ResetIterationsRun() { m_IterationsRun = 0; }
+
+private:
+    struct SolverPoint
+    {
+        Contact* Source;
+        uint32_t BodyA;
+        uint32_t BodyB;
+        DirectX::XMVECTOR Normal;
+        DirectX::XMVECTOR Tangents[2];
+        DirectX::XMVECTOR RelativeA;    //~ contact point - centre of A
+        DirectX::XMVECTOR RelativeB;
+        float NormalMass;
+        float TangentMass[2];
+        float Bias;                     //~ target separating speed (restitution, else minus gap/dt when speculative)
+        float PenetrationBias;          //~ pseudo speed that removes the overlap beyond the slop
+        float PseudoImpulse;
+        float Friction;
+    };
+
+    struct SolverConstraint
+    {
+        Constraint* Source;
+        uint32_t BodyA;
+        uint32_t BodyB;
+    };
+
+    uint32_t GetSolverBody(const ICollider* collider);
+    uint32_t GetSolverBody(RigidBody* body, bool isStatic);
+    void PrepareContacts(const std::vector<ContactManifold*>& manifolds, float deltaTime);
+    void PrepareConstraints(const std::vector<Constraint*>& constraints, float deltaTime);
+    void WarmStart();
+    void SolveVelocities(bool backwards);
+    void StoreResults();
+    void SolvePositions();
+    void CorrectPositions(float deltaTime);
+
+    void ApplyImpulse(const SolverPoint& point, const DirectX::XMVECTOR& impulse);
+    DirectX::XMVECTOR GetRelativeVelocity(const SolverPoint& point) const;
+    float GetEffectiveMass(const SolverPoint& point, const DirectX::XMVECTOR& direction) const;
+
+    static void ComputeTangents(const DirectX::XMVECTOR& normal, DirectX::XMVECTOR outTangents[2]);
+
+private:
+    std::vector<SolverBody> m_Bodies{};
+    std::vector<SolverPoint> m_Points{};
+    std::vector<SolverConstraint> m_Constraints{};
+    std::unordered_map<const RigidBody*, uint32_t> m_BodyLookup{};   //~ null is the world
+
+    uint32_t m_Iterations{ 8 };
+    uint32_t m_IterationsRun{ 0 };
+    float m_RestitutionThreshold{ 1.0f };   //~ closing speed below which contacts do not bounce
+    float m_PenetrationSlop{ 0.01f };       //~ overlap left alone so resting contacts persist
+    float m_PenetrationFactor{ 0.8f };      //~ share of the remaining overlap removed per step
+};
@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "SeparatingAxisCache.h"
+#include "Collision/ContactManifold.h"
+
+
+uint8_t SeparatingAxisCache::Find(const ICollider* a, const ICollider* b) const
+{
+    const ColliderPairKey key = ColliderPairKey::Make(a, b);
+    const auto it = m_Axes.find(key);
+    if (it == m_Axes.end()) return ContactManifold::NoAxis;
+
+    return key.A == a ? it->second.Axis : Mirror(it->second.Axis);
+}
+
+void SeparatingAxisCache::Store(const ICollider* a, const ICollider* b, uint8_t axis)
+{
+    const ColliderPairKey key = ColliderPairKey::Make(a, b);
+    if (axis == ContactManifold::NoAxis)
+    {
+        m_Axes.erase(key);
+        return;
+    }
+
+    Entry& entry = m_Axes[key];
+    entry.Axis = key.A == a ? axis : Mirror(axis);
+    entry.Touched = true;
+}
+
+void SeparatingAxisCache::Prune()
+{
+    for (auto it = m_Axes.begin(); it != m_Axes.end();)
+    {
+        if (!it->second.Touched)
+        {
+            it = m_Axes.erase(it);
+            continue;
+        }
+        it->second.Touched = false;
+        ++it;
+    }
+}
+
+void SeparatingAxisCache::RemoveCollider(const ICollider* collider)
+{
+    std::erase_if(m_Axes, [collider](const auto& item)
+    {
+        return item.first.Contains(collider);
+    });
+}
+
+void SeparatingAxisCache::Clear()
+{
+    m_Axes.clear();
+}
+
+uint8_t SeparatingAxisCache::Mirror(uint8_t axis)
+{
+    if (axis < 3) return static_cast<uint8_t>(axis + 3);
+    if (axis < 6) return static_cast<uint8_t>(axis - 3);
+    if (axis < 15)
+    {
+        const uint8_t edge = static_cast<uint8_t>(axis - 6);
+        return static_cast<uint8_t>(6 + (edge % 3) * 3 + edge / 3);
+    }
+    return axis;
+}
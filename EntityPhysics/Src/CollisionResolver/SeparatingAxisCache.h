@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "ColliderPairKey.h"
+
+
+// Remembers which SAT axis separated each broadphase pair that did not touch, so next step
+// the box test can try that axis first and usually stop after one axis.
+// Find is safe to call from several threads at once; Store and Prune are not.
+class SeparatingAxisCache
+{
+public:
+    //~ The axis in (a, b) order, ContactManifold::NoAxis when the pair has none stored
+    uint8_t Find(const ICollider* a, const ICollider* b) const;
+
+    //~ NoAxis forgets the pair (it touches, no axis to try)
+    void Store(const ICollider* a, const ICollider* b, uint8_t axis);
+
+    //~ Forgets every pair that was not stored since the previous Prune
+    void Prune();
+
+    void RemoveCollider(const ICollider* collider);
+    void Clear();
+
+    size_t GetCount() const { return m_Axes.size(); }
+
+private:
+    struct Entry
+    {
+        uint8_t Axis;   //~ in key order
+        bool Touched;
+    };
+
+    //~ Same axis seen from the other box: faces of A and B trade places, edge (i, j) becomes (j, i)
+    static uint8_t Mirror(uint8_t axis);
+
+private:
+    std::unordered_map<ColliderPairKey, Entry, ColliderPairKeyHash> m_Axes{};
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <DirectXMath.h>
+
+class RigidBody;
+
+
+// Velocities of one body while a solver works on them, written back once it is done.
+// Static bodies, and the world that constraints can be anchored to (no body at all), have
+// zero inverse mass and inertia, so every impulse on them is a no-op.
+// The pseudo velocities only push overlapping bodies apart: they move and turn the body once
+// the solver is done and are then dropped, so they never show up as real velocity.
+struct SolverBody
+{
+    RigidBody* Body;
+    DirectX::XMVECTOR LinearVelocity;
+    DirectX::XMVECTOR AngularVelocity;
+    DirectX::XMVECTOR PseudoLinearVelocity;
+    DirectX::XMVECTOR PseudoAngularVelocity;
+    DirectX::XMMATRIX InverseInertia;
+    float InverseMass;
+
+    //~ 'relative' is the point the impulse acts at, minus the centre of the body
+    void ApplyImpulse(const DirectX::XMVECTOR& impulse, const DirectX::XMVECTOR& relative)
+    {
+        using namespace DirectX;
+
+        LinearVelocity = XMVectorAdd(LinearVelocity, XMVectorScale(impulse, InverseMass));
+        AngularVelocity = XMVectorAdd(AngularVelocity,
+            XMVector3TransformNormal(XMVector3Cross(relative, impulse), InverseInertia));
+    }
+
+    void ApplyPseudoImpulse(const DirectX::XMVECTOR& impulse, const DirectX::XMVECTOR& relative)
+    {
+        using namespace DirectX;
+
+        PseudoLinearVelocity = XMVectorAdd(PseudoLinearVelocity, XMVectorScale(impulse, InverseMass));
+        PseudoAngularVelocity = XMVectorAdd(PseudoAngularVelocity,
+            XMVector3TransformNormal(XMVector3Cross(relative, impulse), InverseInertia));
+    }
+
+    void ApplyAngularImpulse(const DirectX::XMVECTOR& impulse)
+    {
+        using namespace DirectX;
+
+        AngularVelocity = XMVectorAdd(AngularVelocity, XMVector3TransformNormal(impulse, InverseInertia));
+    }
+
+    DirectX::XMVECTOR GetPointVelocity(const DirectX::XMVECTOR& relative) const
+    {
+        using namespace DirectX;
+
+        return XMVectorAdd(LinearVelocity, XMVector3Cross(AngularVelocity, relative));
+    }
+
+    DirectX::XMVECTOR GetPseudoPointVelocity(const DirectX::XMVECTOR& relative) const
+    {
+        using namespace DirectX;
+
+        return XMVectorAdd(PseudoLinearVelocity, XMVector3Cross(PseudoAngularVelocity, relative));
+    }
+
+    //~ Angular part of the effective mass, axis . InverseInertia . axis
+    float GetAngularMass(const DirectX::XMVECTOR& axis) const
+    {
+        using namespace DirectX;
+
+        return XMVectorGetX(XMVector3Dot(XMVector3TransformNormal(axis, InverseInertia), axis));
+    }
+};
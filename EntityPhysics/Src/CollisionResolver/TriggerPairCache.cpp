@@ -0,0 +1,121 @@
+#include "pch.h"
+#include "TriggerPairCache.h"
+#include "State/StateBuffer.h"
+#include <algorithm>
+#include <functional>
+
+
+void TriggerPairCache::Add(ICollider* a, ICollider* b)
+{
+    Pair pair;
+    if (MakePair(a, b, pair)) m_Current.push_back(pair);
+}
+
+void TriggerPairCache::Keep(ICollider* a, ICollider* b)
+{
+    Pair pair;
+    if (MakePair(a, b, pair) && std::binary_search(m_Previous.begin(), m_Previous.end(), pair, Less))
+    {
+        m_Current.push_back(pair);
+    }
+}
+
+void TriggerPairCache::Flush()
+{
+    std::sort(m_Current.begin(), m_Current.end(), Less);
+
+    //~ One merge walk over both sorted sets
+    m_Events.clear();
+    size_t previous = 0;
+    size_t current = 0;
+    while (previous < m_Previous.size() || current < m_Current.size())
+    {
+        if (current == m_Current.size() ||
+            (previous < m_Previous.size() && Less(m_Previous[previous], m_Current[current])))
+        {
+            const Pair& pair = m_Previous[previous++];
+            m_Events.push_back({ pair.Trigger, pair.Other, TriggerEventType::Exit });
+        }
+        else if (previous == m_Previous.size() || Less(m_Current[current], m_Previous[previous]))
+        {
+            const Pair& pair = m_Current[current++];
+            m_Events.push_back({ pair.Trigger, pair.Other, TriggerEventType::Enter });
+        }
+        else
+        {
+            const Pair& pair = m_Current[current++];
+            ++previous;
+            m_Events.push_back({ pair.Trigger, pair.Other, TriggerEventType::Stay });
+        }
+    }
+
+    std::swap(m_Previous, m_Current);
+    m_Current.clear();
+}
+
+void TriggerPairCache::Dispatch() const
+{
+    for (const TriggerEvent& event : m_Events)
+    {
+        event.Trigger->OnTriggerEvent(event.Other, event.Type);
+    }
+}
+
+void TriggerPairCache::RemoveCollider(const ICollider* collider)
+{
+    auto involves = [collider](const Pair& pair)
+    {
+        return pair.Trigger == collider || pair.Other == collider;
+    };
+    std::erase_if(m_Previous, involves);
+    std::erase_if(m_Current, involves);
+    std::erase_if(m_Events, [collider](const TriggerEvent& event)
+    {
+        return event.Trigger == collider || event.Other == collider;
+    });
+}
+
+void TriggerPairCache::SaveState(StateWriter& writer) const
+{
+    writer.WriteVector(m_Previous);
+}
+
+bool TriggerPairCache::RestoreState(StateReader& reader)
+{
+    m_Current.clear();
+    m_Events.clear();
+    return reader.ReadVector(m_Previous);
+}
+
+void TriggerPairCache::Clear()
+{
+    m_Current.clear();
+    m_Previous.clear();
+    m_Events.clear();
+}
+
+bool TriggerPairCache::MakePair(ICollider* a, ICollider* b, Pair& outPair)
+{
+    const bool triggerA = a->GetColliderState() == ColliderState::Trigger;
+    const bool triggerB = b->GetColliderState() == ColliderState::Trigger;
+    if (triggerA == triggerB) return false;
+
+    outPair = triggerA ? Pair{ a, b } : Pair{ b, a };
+    return true;
+}
+
+bool TriggerPairCache::Less(const Pair& a, const Pair& b)
+{
+    //~ By body slot first, so the event order does not depend on where the colliders were allocated
+    const uint32_t triggerA = a.Trigger->GetRigidBody()->GetSlot();
+    const uint32_t triggerB = b.Trigger->GetRigidBody()->GetSlot();
+    if (triggerA != triggerB) return triggerA < triggerB;
+
+    const uint32_t otherA = a.Other->GetRigidBody()->GetSlot();
+    const uint32_t otherB = b.Other->GetRigidBody()->GetSlot();
+    if (otherA != otherB) return otherA < otherB;
+
+    const std::less<const ICollider*> less{};
+    if (a.Trigger != b.Trigger) return less(a.Trigger, b.Trigger);
+    return less(a.Other, b.Other);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Collision/ICollider.h"
+
+class StateReader;
+class StateWriter;
+
+struct TriggerEvent
+{
+    ICollider* Trigger;
+    ICollider* Other;
+    TriggerEventType Type;
+};
+
+// Every pair of one trigger and one non trigger collider that touched this step, kept as a
+// sorted vector and diffed against the previous step's once the step is done: new pairs
+// enter, pairs in both stay, pairs that are gone exit. An exit costs nothing beyond the
+// broadphase no longer reporting the pair, and callbacks run after the step instead of in
+// the middle of collision detection. Trigger vs trigger pairs are ignored.
+class TriggerPairCache
+{
+public:
+    //~ A pair that touched this step (call from the serial merge)
+    void Add(ICollider* a, ICollider* b);
+
+    //~ A pair that was not tested this step (both at rest) stays inside if it was inside
+    void Keep(ICollider* a, ICollider* b);
+
+    //~ Diffs this step's pairs against the previous step's into GetEvents()
+    void Flush();
+
+    //~ Runs the SetTriggerTarget callbacks for every event of the last Flush, in event order
+    void Dispatch() const;
+
+    const std::vector<TriggerEvent>& GetEvents() const { return m_Events; }
+    size_t GetPairCount() const { return m_Previous.size(); }
+
+    //~ The pairs inside after the last Flush, so a rollback reports the same enters and exits
+    void SaveState(StateWriter& writer) const;
+    bool RestoreState(StateReader& reader);
+
+    //~ Forgets the collider's pairs without an exit event
+    void RemoveCollider(const ICollider* collider);
+    void Clear();
+
+private:
+    struct Pair
+    {
+        ICollider* Trigger;
+        ICollider* Other;
+    };
+
+    //~ Trigger first, false for pairs this cache does not track
+    static bool MakePair(ICollider* a, ICollider* b, Pair& outPair);
+    static bool Less(const Pair& a, const Pair& b);
+
+private:
+    std::vector<Pair> m_Current{};
+    std::vector<Pair> m_Previous{};     //~ sorted
+    std::vector<TriggerEvent> m_Events{};
+};
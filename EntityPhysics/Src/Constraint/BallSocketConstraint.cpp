@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "BallSocketConstraint.h"
+#include "State/StateBuffer.h"
+
+
+BallSocketConstraint::BallSocketConstraint(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor)
+    : Constraint(bodyA, bodyB)
+{
+    m_Point.Initialize(bodyA, bodyB, worldAnchor);
+}
+
+void BallSocketConstraint::Prepare(const SolverBody& a, const SolverBody& b, float deltaTime)
+{
+    m_Point.Prepare(a, b, deltaTime);
+}
+
+void BallSocketConstraint::WarmStart(SolverBody& a, SolverBody& b) const
+{
+    m_Point.WarmStart(a, b);
+}
+
+void BallSocketConstraint::SolveVelocities(SolverBody& a, SolverBody& b)
+{
+    m_Point.Solve(a, b);
+}
+
+void BallSocketConstraint::ResetImpulses()
+{
+    m_Point.Impulse = { 0.0f, 0.0f, 0.0f };
+}
+
+void BallSocketConstraint::SaveState(StateWriter& writer) const
+{
+    writer.Write(m_Point.Impulse);
+}
+
+bool BallSocketConstraint::RestoreState(StateReader& reader)
+{
+    return reader.Read(m_Point.Impulse);
+}
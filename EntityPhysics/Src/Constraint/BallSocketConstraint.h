@@ -0,0 +1,25 @@
+#pragma once
+#include "Constraint.h"
+
+
+// Holds one point of each body together and lets them turn freely about it: the links of
+// a chain, a shoulder.
+class BallSocketConstraint final : public Constraint
+{
+public:
+    BallSocketConstraint(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor);
+    ~BallSocketConstraint() override = default;
+
+    ConstraintType GetType() const override { return ConstraintType::BallSocket; }
+
+    void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime) override;
+    void WarmStart(SolverBody& a, SolverBody& b) const override;
+    void SolveVelocities(SolverBody& a, SolverBody& b) override;
+    void ResetImpulses() override;
+
+    void SaveState(StateWriter& writer) const override;
+    bool RestoreState(StateReader& reader) override;
+
+private:
+    PointPart m_Point{};
+};
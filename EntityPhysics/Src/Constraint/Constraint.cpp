@@ -0,0 +1,185 @@
+#include "pch.h"
+#include "Constraint.h"
+#include "RigidBody/RigidBody.h"
+
+#include <cfloat>
+#include <cmath>
+
+
+Constraint::Constraint(RigidBody* bodyA, RigidBody* bodyB)
+    : m_BodyA(bodyA), m_BodyB(bodyB)
+{
+}
+
+void Constraint::SetEnabled(bool enabled)
+{
+    m_Enabled = enabled;
+    if (!enabled) ResetImpulses();
+}
+
+void Constraint::PointPart::Initialize(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor)
+{
+    LocalAnchorA = ToLocalPoint(bodyA, worldAnchor);
+    LocalAnchorB = ToLocalPoint(bodyB, worldAnchor);
+    Impulse = { 0.0f, 0.0f, 0.0f };
+}
+
+void Constraint::PointPart::Prepare(const SolverBody& a, const SolverBody& b, float deltaTime)
+{
+    using namespace DirectX;
+
+    RelativeA = XMVector3Rotate(XMLoadFloat3(&LocalAnchorA), GetOrientation(a.Body));
+    RelativeB = XMVector3Rotate(XMLoadFloat3(&LocalAnchorB), GetOrientation(b.Body));
+
+    //~ Column k is the velocity change of the anchors for a unit impulse along axis k
+    const XMMATRIX identity = XMMatrixIdentity();
+    XMMATRIX mass = identity;
+    for (int k = 0; k < 3; ++k)
+    {
+        const XMVECTOR axis = identity.r[k];
+        XMVECTOR column = XMVectorScale(axis, a.InverseMass + b.InverseMass);
+        column = XMVectorAdd(column, XMVector3Cross(
+            XMVector3TransformNormal(XMVector3Cross(RelativeA, axis), a.InverseInertia), RelativeA));
+        column = XMVectorAdd(column, XMVector3Cross(
+            XMVector3TransformNormal(XMVector3Cross(RelativeB, axis), b.InverseInertia), RelativeB));
+        mass.r[k] = XMVectorSetW(column, 0.0f);
+    }
+    Mass = InvertMass(mass);
+
+    const XMVECTOR anchorA = XMVectorAdd(GetPosition(a.Body), RelativeA);
+    const XMVECTOR anchorB = XMVectorAdd(GetPosition(b.Body), RelativeB);
+    Bias = XMVectorScale(XMVectorSubtract(anchorB, anchorA), PositionCorrection / deltaTime);
+}
+
+void Constraint::PointPart::WarmStart(SolverBody& a, SolverBody& b) const
+{
+    using namespace DirectX;
+
+    const XMVECTOR impulse = XMLoadFloat3(&Impulse);
+    a.ApplyImpulse(XMVectorNegate(impulse), RelativeA);
+    b.ApplyImpulse(impulse, RelativeB);
+}
+
+void Constraint::PointPart::Solve(SolverBody& a, SolverBody& b)
+{
+    using namespace DirectX;
+
+    const XMVECTOR velocity = XMVectorSubtract(b.GetPointVelocity(RelativeB), a.GetPointVelocity(RelativeA));
+    const XMVECTOR impulse = XMVector3TransformNormal(XMVectorNegate(XMVectorAdd(velocity, Bias)), Mass);
+    XMStoreFloat3(&Impulse, XMVectorAdd(XMLoadFloat3(&Impulse), impulse));
+
+    a.ApplyImpulse(XMVectorNegate(impulse), RelativeA);
+    b.ApplyImpulse(impulse, RelativeB);
+}
+
+void Constraint::AnglePart::Initialize(RigidBody* bodyA, RigidBody* bodyB)
+{
+    DirectX::XMStoreFloat4(&ReferenceRotation, GetRelativeRotation(GetOrientation(bodyA), GetOrientation(bodyB)));
+    Impulse = { 0.0f, 0.0f, 0.0f };
+}
+
+void Constraint::AnglePart::Prepare(const SolverBody& a, const SolverBody& b, float deltaTime)
+{
+    using namespace DirectX;
+
+    XMMATRIX mass = XMMatrixIdentity();
+    for (int k = 0; k < 3; ++k)
+    {
+        mass.r[k] = XMVectorSetW(XMVectorAdd(a.InverseInertia.r[k], b.InverseInertia.r[k]), 0.0f);
+    }
+    Mass = InvertMass(mass);
+
+    //~ Rotation from where B should be to where it is, in world space; twice its vector part
+    //~ is the rotation vector for small errors
+    const XMVECTOR orientationA = GetOrientation(a.Body);
+    const XMVECTOR target = XMQuaternionMultiply(XMLoadFloat4(&ReferenceRotation), orientationA);
+    XMVECTOR error = XMQuaternionMultiply(XMQuaternionConjugate(target), GetOrientation(b.Body));
+    if (XMVectorGetW(error) < 0.0f) error = XMVectorNegate(error);
+
+    Bias = XMVectorScale(XMVectorSetW(error, 0.0f), 2.0f * PositionCorrection / deltaTime);
+}
+
+void Constraint::AnglePart::WarmStart(SolverBody& a, SolverBody& b) const
+{
+    using namespace DirectX;
+
+    const XMVECTOR impulse = XMLoadFloat3(&Impulse);
+    a.ApplyAngularImpulse(XMVectorNegate(impulse));
+    b.ApplyAngularImpulse(impulse);
+}
+
+void Constraint::AnglePart::Solve(SolverBody& a, SolverBody& b)
+{
+    using namespace DirectX;
+
+    const XMVECTOR velocity = XMVectorSubtract(b.AngularVelocity, a.AngularVelocity);
+    const XMVECTOR impulse = XMVector3TransformNormal(XMVectorNegate(XMVectorAdd(velocity, Bias)), Mass);
+    XMStoreFloat3(&Impulse, XMVectorAdd(XMLoadFloat3(&Impulse), impulse));
+
+    a.ApplyAngularImpulse(XMVectorNegate(impulse));
+    b.ApplyAngularImpulse(impulse);
+}
+
+DirectX::XMVECTOR Constraint::GetPosition(RigidBody* body)
+{
+    return body ? body->GetPosition() : DirectX::XMVectorZero();
+}
+
+DirectX::XMVECTOR Constraint::GetOrientation(const RigidBody* body)
+{
+    return body ? body->GetOrientation().ToXmVector() : DirectX::XMQuaternionIdentity();
+}
+
+DirectX::XMFLOAT3 Constraint::ToLocalPoint(RigidBody* body, const DirectX::XMVECTOR& worldPoint)
+{
+    using namespace DirectX;
+
+    XMFLOAT3 local;
+    XMStoreFloat3(&local, XMVector3InverseRotate(XMVectorSubtract(worldPoint, GetPosition(body)), GetOrientation(body)));
+    return local;
+}
+
+DirectX::XMFLOAT3 Constraint::ToLocalDirection(const RigidBody* body, const DirectX::XMVECTOR& worldDirection)
+{
+    using namespace DirectX;
+
+    XMFLOAT3 local;
+    XMStoreFloat3(&local, XMVector3InverseRotate(XMVector3Normalize(worldDirection), GetOrientation(body)));
+    return local;
+}
+
+DirectX::XMVECTOR Constraint::GetRelativeRotation(const DirectX::XMVECTOR& orientationA,
+    const DirectX::XMVECTOR& orientationB)
+{
+    using namespace DirectX;
+
+    return XMQuaternionMultiply(orientationB, XMQuaternionConjugate(orientationA));
+}
+
+void Constraint::ComputePerpendiculars(const DirectX::XMVECTOR& axis, DirectX::XMVECTOR outPerpendiculars[2])
+{
+    using namespace DirectX;
+
+    XMFLOAT3 n;
+    XMStoreFloat3(&n, axis);
+
+    XMVECTOR perpendicular;
+    if (fabsf(n.x) >= 0.57735f) perpendicular = XMVectorSet(n.y, -n.x, 0.0f, 0.0f);
+    else perpendicular = XMVectorSet(0.0f, n.z, -n.y, 0.0f);
+
+    outPerpendiculars[0] = XMVector3Normalize(perpendicular);
+    outPerpendiculars[1] = XMVector3Cross(axis, outPerpendiculars[0]);
+}
+
+DirectX::XMMATRIX Constraint::InvertMass(const DirectX::XMMATRIX& mass)
+{
+    using namespace DirectX;
+
+    XMVECTOR determinant;
+    const XMMATRIX inverse = XMMatrixInverse(&determinant, mass);
+    if (fabsf(XMVectorGetX(determinant)) < FLT_MIN)
+    {
+        return XMMATRIX(XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero());
+    }
+    return inverse;
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <DirectXMath.h>
+
+#include "CollisionResolver/SolverBody.h"
+
+class RigidBody;
+class StateReader;
+class StateWriter;
+
+enum class ConstraintType : uint8_t
+{
+    Distance,
+    BallSocket,
+    Hinge,
+    Fixed,
+};
+
+// Joint between two bodies, solved by the ContactSolver in the same iterations as the
+// contacts of their island. Every constraint keeps its accumulated impulses from one step to
+// the next and applies them up front (warm starting), like the contacts do, so a hanging
+// chain starts each step from last step's tension instead of from zero.
+// Drift is removed through the velocities (a fraction of the position error per step), so
+// joints pulled apart by a hard hit come back together over a few steps.
+// Anchors and axes are given in world space at construction, for the pose the bodies are in
+// then. The constraint does not own its bodies; it is skipped while either one is not
+// simulated, so removing a body from the PhysicsSystem leaves its joints inert.
+class Constraint
+{
+public:
+    //~ 'bodyB' may be null, body A is then held to the world
+    Constraint(RigidBody* bodyA, RigidBody* bodyB);
+    virtual ~Constraint() = default;
+
+    Constraint(const Constraint&) = delete;
+    Constraint(Constraint&&) = delete;
+    Constraint& operator=(const Constraint&) = delete;
+    Constraint& operator=(Constraint&&) = delete;
+
+    virtual ConstraintType GetType() const = 0;
+
+    RigidBody* GetBodyA() const { return m_BodyA; }
+    RigidBody* GetBodyB() const { return m_BodyB; }
+
+    //~ A disabled constraint is skipped and forgets its impulses
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_Enabled; }
+
+    //~ Whether the colliders of the two bodies still collide with each other (off by default,
+    //~ the links of a chain overlap at every joint)
+    void SetCollideConnected(bool collide) { m_CollideConnected = collide; }
+    bool GetCollideConnected() const { return m_CollideConnected; }
+
+    //~ Solver interface, see ContactSolver. Prepare caches what stays fixed over the iterations.
+    virtual void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime) = 0;
+    virtual void WarmStart(SolverBody& a, SolverBody& b) const = 0;
+    virtual void SolveVelocities(SolverBody& a, SolverBody& b) = 0;
+    virtual void ResetImpulses() = 0;
+
+    //~ Accumulated impulses, for rollback along with the bodies
+    virtual void SaveState(StateWriter& writer) const = 0;
+    virtual bool RestoreState(StateReader& reader) = 0;
+
+protected:
+    //~ Holds a point of A and a point of B together, three rows solved as one block
+    struct PointPart
+    {
+        DirectX::XMFLOAT3 LocalAnchorA{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 LocalAnchorB{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 Impulse{ 0.0f, 0.0f, 0.0f };
+
+        DirectX::XMVECTOR RelativeA{};  //~ anchor - centre of A, world space
+        DirectX::XMVECTOR RelativeB{};
+        DirectX::XMVECTOR Bias{};
+        DirectX::XMMATRIX Mass{};       //~ inverse of the effective mass matrix
+
+        void Initialize(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor);
+        void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime);
+        void WarmStart(SolverBody& a, SolverBody& b) const;
+        void Solve(SolverBody& a, SolverBody& b);
+    };
+
+    //~ Keeps the orientation of B relative to A, three rows solved as one block
+    struct AnglePart
+    {
+        DirectX::XMFLOAT4 ReferenceRotation{ 0.0f, 0.0f, 0.0f, 1.0f };  //~ A to B at construction
+        DirectX::XMFLOAT3 Impulse{ 0.0f, 0.0f, 0.0f };
+
+        DirectX::XMVECTOR Bias{};
+        DirectX::XMMATRIX Mass{};
+
+        void Initialize(RigidBody* bodyA, RigidBody* bodyB);
+        void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime);
+        void WarmStart(SolverBody& a, SolverBody& b) const;
+        void Solve(SolverBody& a, SolverBody& b);
+    };
+
+    //~ A null body is the world: at the origin, not rotated
+    static DirectX::XMVECTOR GetPosition(RigidBody* body);
+    static DirectX::XMVECTOR GetOrientation(const RigidBody* body);
+
+    static DirectX::XMFLOAT3 ToLocalPoint(RigidBody* body, const DirectX::XMVECTOR& worldPoint);
+    static DirectX::XMFLOAT3 ToLocalDirection(const RigidBody* body, const DirectX::XMVECTOR& worldDirection);
+
+    //~ Rotation taking A's frame to B's, conj(qA) * qB
+    static DirectX::XMVECTOR GetRelativeRotation(const DirectX::XMVECTOR& orientationA,
+        const DirectX::XMVECTOR& orientationB);
+
+    //~ Two unit vectors perpendicular to the unit 'axis' and to each other
+    static void ComputePerpendiculars(const DirectX::XMVECTOR& axis, DirectX::XMVECTOR outPerpendiculars[2]);
+
+    //~ Inverse of a 3x3 effective mass, zero when the bodies cannot respond at all
+    static DirectX::XMMATRIX InvertMass(const DirectX::XMMATRIX& mass);
+
+    static constexpr float PositionCorrection = 0.2f;   //~ fraction of the drift removed per step
+
+protected:
+    RigidBody* m_BodyA;
+    RigidBody* m_BodyB;
+    bool m_Enabled{ true };
+    bool m_CollideConnected{ false };
+};
@@ -0,0 +1,106 @@
+#include "pch.h"
+#include "DistanceConstraint.h"
+#include "State/StateBuffer.h"
+
+#include <algorithm>
+
+
+DistanceConstraint::DistanceConstraint(RigidBody* bodyA, RigidBody* bodyB,
+    const DirectX::XMVECTOR& worldAnchorA, const DirectX::XMVECTOR& worldAnchorB)
+    : Constraint(bodyA, bodyB)
+    , m_LocalAnchorA(ToLocalPoint(bodyA, worldAnchorA))
+    , m_LocalAnchorB(ToLocalPoint(bodyB, worldAnchorB))
+{
+    using namespace DirectX;
+
+    SetLength(XMVectorGetX(XMVector3Length(XMVectorSubtract(worldAnchorB, worldAnchorA))));
+}
+
+void DistanceConstraint::SetLength(float length)
+{
+    SetLengthRange(length, length);
+}
+
+void DistanceConstraint::SetLengthRange(float minLength, float maxLength)
+{
+    m_MinLength = (std::max)(0.0f, minLength);
+    m_MaxLength = (std::max)(m_MinLength, maxLength);
+}
+
+void DistanceConstraint::Prepare(const SolverBody& a, const SolverBody& b, float deltaTime)
+{
+    using namespace DirectX;
+
+    m_RelativeA = XMVector3Rotate(XMLoadFloat3(&m_LocalAnchorA), GetOrientation(a.Body));
+    m_RelativeB = XMVector3Rotate(XMLoadFloat3(&m_LocalAnchorB), GetOrientation(b.Body));
+
+    const XMVECTOR anchorA = XMVectorAdd(GetPosition(a.Body), m_RelativeA);
+    const XMVECTOR anchorB = XMVectorAdd(GetPosition(b.Body), m_RelativeB);
+    const XMVECTOR separation = XMVectorSubtract(anchorB, anchorA);
+    const float length = XMVectorGetX(XMVector3Length(separation));
+
+    //~ Coincident anchors have no direction to push along, any will do to get them apart
+    m_Normal = length > 1e-6f ? XMVectorScale(separation, 1.0f / length) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+
+    float target = m_MinLength;
+    if (m_MinLength == m_MaxLength) m_State = LengthState::Equal;
+    else if (length <= m_MinLength) m_State = LengthState::AtMin;
+    else if (length >= m_MaxLength)
+    {
+        m_State = LengthState::AtMax;
+        target = m_MaxLength;
+    }
+    else m_State = LengthState::Free;
+
+    //~ Last step's impulse only warm starts if it still pushes the allowed way
+    if (m_State == LengthState::Free) m_Impulse = 0.0f;
+    else if (m_State == LengthState::AtMin) m_Impulse = (std::max)(m_Impulse, 0.0f);
+    else if (m_State == LengthState::AtMax) m_Impulse = (std::min)(m_Impulse, 0.0f);
+    if (m_State == LengthState::Free) return;
+
+    const float mass = a.InverseMass + b.InverseMass
+        + a.GetAngularMass(XMVector3Cross(m_RelativeA, m_Normal))
+        + b.GetAngularMass(XMVector3Cross(m_RelativeB, m_Normal));
+    m_Mass = mass > 0.0f ? 1.0f / mass : 0.0f;
+    m_Bias = (length - target) * PositionCorrection / deltaTime;
+}
+
+void DistanceConstraint::WarmStart(SolverBody& a, SolverBody& b) const
+{
+    using namespace DirectX;
+
+    if (m_State == LengthState::Free) return;
+
+    const XMVECTOR impulse = XMVectorScale(m_Normal, m_Impulse);
+    a.ApplyImpulse(XMVectorNegate(impulse), m_RelativeA);
+    b.ApplyImpulse(impulse, m_RelativeB);
+}
+
+void DistanceConstraint::SolveVelocities(SolverBody& a, SolverBody& b)
+{
+    using namespace DirectX;
+
+    if (m_State == LengthState::Free) return;
+
+    const XMVECTOR velocity = XMVectorSubtract(b.GetPointVelocity(m_RelativeB), a.GetPointVelocity(m_RelativeA));
+    const float speed = XMVectorGetX(XMVector3Dot(velocity, m_Normal));
+
+    const float previous = m_Impulse;
+    m_Impulse = previous - (speed + m_Bias) * m_Mass;
+    if (m_State == LengthState::AtMin) m_Impulse = (std::max)(m_Impulse, 0.0f);
+    else if (m_State == LengthState::AtMax) m_Impulse = (std::min)(m_Impulse, 0.0f);
+
+    const XMVECTOR impulse = XMVectorScale(m_Normal, m_Impulse - previous);
+    a.ApplyImpulse(XMVectorNegate(impulse), m_RelativeA);
+    b.ApplyImpulse(impulse, m_RelativeB);
+}
+
+void DistanceConstraint::SaveState(StateWriter& writer) const
+{
+    writer.Write(m_Impulse);
+}
+
+bool DistanceConstraint::RestoreState(StateReader& reader)
+{
+    return reader.Read(m_Impulse);
+}
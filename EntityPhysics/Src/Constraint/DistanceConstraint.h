@@ -0,0 +1,54 @@
+#pragma once
+#include "Constraint.h"
+
+
+// Keeps one point of each body at a distance from each other, the bodies turn freely about
+// their anchors. With a length range it only acts at the ends of the range: a rope (minimum 0)
+// or a slack link.
+class DistanceConstraint final : public Constraint
+{
+public:
+    //~ The length starts out as the current distance between the anchors
+    DistanceConstraint(RigidBody* bodyA, RigidBody* bodyB,
+        const DirectX::XMVECTOR& worldAnchorA, const DirectX::XMVECTOR& worldAnchorB);
+    ~DistanceConstraint() override = default;
+
+    ConstraintType GetType() const override { return ConstraintType::Distance; }
+
+    void SetLength(float length);
+    void SetLengthRange(float minLength, float maxLength);
+    float GetMinLength() const { return m_MinLength; }
+    float GetMaxLength() const { return m_MaxLength; }
+
+    void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime) override;
+    void WarmStart(SolverBody& a, SolverBody& b) const override;
+    void SolveVelocities(SolverBody& a, SolverBody& b) override;
+    void ResetImpulses() override { m_Impulse = 0.0f; }
+
+    void SaveState(StateWriter& writer) const override;
+    bool RestoreState(StateReader& reader) override;
+
+private:
+    enum class LengthState : uint8_t
+    {
+        Equal,
+        AtMin,      //~ may only push apart
+        AtMax,      //~ may only pull together
+        Free,
+    };
+
+private:
+    DirectX::XMFLOAT3 m_LocalAnchorA;
+    DirectX::XMFLOAT3 m_LocalAnchorB;
+    float m_MinLength{ 0.0f };
+    float m_MaxLength{ 0.0f };
+    float m_Impulse{ 0.0f };
+
+    //~ Cached by Prepare
+    DirectX::XMVECTOR m_RelativeA{};
+    DirectX::XMVECTOR m_RelativeB{};
+    DirectX::XMVECTOR m_Normal{};       //~ from A's anchor towards B's
+    float m_Mass{ 0.0f };
+    float m_Bias{ 0.0f };
+    LengthState m_State{ LengthState::Equal };
+};
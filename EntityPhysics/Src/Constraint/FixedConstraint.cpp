@@ -0,0 +1,47 @@
+#include "pch.h"
+#include "FixedConstraint.h"
+#include "State/StateBuffer.h"
+
+
+FixedConstraint::FixedConstraint(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor)
+    : Constraint(bodyA, bodyB)
+{
+    m_Point.Initialize(bodyA, bodyB, worldAnchor);
+    m_Angle.Initialize(bodyA, bodyB);
+}
+
+void FixedConstraint::Prepare(const SolverBody& a, const SolverBody& b, float deltaTime)
+{
+    m_Point.Prepare(a, b, deltaTime);
+    m_Angle.Prepare(a, b, deltaTime);
+}
+
+void FixedConstraint::WarmStart(SolverBody& a, SolverBody& b) const
+{
+    m_Point.WarmStart(a, b);
+    m_Angle.WarmStart(a, b);
+}
+
+//~ Angle first, so the point lock works on the final angular velocities
+void FixedConstraint::SolveVelocities(SolverBody& a, SolverBody& b)
+{
+    m_Angle.Solve(a, b);
+    m_Point.Solve(a, b);
+}
+
+void FixedConstraint::ResetImpulses()
+{
+    m_Point.Impulse = { 0.0f, 0.0f, 0.0f };
+    m_Angle.Impulse = { 0.0f, 0.0f, 0.0f };
+}
+
+void FixedConstraint::SaveState(StateWriter& writer) const
+{
+    writer.Write(m_Point.Impulse);
+    writer.Write(m_Angle.Impulse);
+}
+
+bool FixedConstraint::RestoreState(StateReader& reader)
+{
+    return reader.Read(m_Point.Impulse) && reader.Read(m_Angle.Impulse);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Constraint.h"
+
+
+// Welds two bodies together in the pose they had at construction: a shield on an arm, a
+// breakable wall made of pieces (disable the constraint to break it).
+class FixedConstraint final : public Constraint
+{
+public:
+    //~ 'worldAnchor' is where the point lock sits; at the centre of the pair it is stiffest
+    FixedConstraint(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor);
+    ~FixedConstraint() override = default;
+
+    ConstraintType GetType() const override { return ConstraintType::Fixed; }
+
+    void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime) override;
+    void WarmStart(SolverBody& a, SolverBody& b) const override;
+    void SolveVelocities(SolverBody& a, SolverBody& b) override;
+    void ResetImpulses() override;
+
+    void SaveState(StateWriter& writer) const override;
+    bool RestoreState(StateReader& reader) override;
+
+private:
+    PointPart m_Point{};
+    AnglePart m_Angle{};
+};
@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "HingeConstraint.h"
+#include "State/StateBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+HingeConstraint::HingeConstraint(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor,
+    const DirectX::XMVECTOR& worldAxis)
+    : Constraint(bodyA, bodyB)
+    , m_LocalAxisA(ToLocalDirection(bodyA, worldAxis))
+    , m_LocalAxisB(ToLocalDirection(bodyB, worldAxis))
+{
+    m_Point.Initialize(bodyA, bodyB, worldAnchor);
+    DirectX::XMStoreFloat4(&m_ReferenceRotation, GetRelativeRotation(GetOrientation(bodyA), GetOrientation(bodyB)));
+}
+
+void HingeConstraint::SetLimits(float lowerAngle, float upperAngle)
+{
+    m_LowerAngle = lowerAngle;
+    m_UpperAngle = (std::max)(lowerAngle, upperAngle);
+    m_LimitsEnabled = true;
+}
+
+void HingeConstraint::SetLimitsEnabled(bool enabled)
+{
+    m_LimitsEnabled = enabled;
+    if (!enabled)
+    {
+        m_LowerImpulse = 0.0f;
+        m_UpperImpulse = 0.0f;
+    }
+}
+
+void HingeConstraint::Prepare(const SolverBody& a, const SolverBody& b, float deltaTime)
+{
+    using namespace DirectX;
+
+    m_Point.Prepare(a, b, deltaTime);
+
+    const XMVECTOR orientationA = GetOrientation(a.Body);
+    const XMVECTOR orientationB = GetOrientation(b.Body);
+    m_Axis = XMVector3Rotate(XMLoadFloat3(&m_LocalAxisA), orientationA);
+    const XMVECTOR axisB = XMVector3Rotate(XMLoadFloat3(&m_LocalAxisB), orientationB);
+
+    //~ B's axis is turned away from A's by about |axis x axisB|, about that cross product
+    ComputePerpendiculars(m_Axis, m_Perpendiculars);
+    const XMVECTOR misalignment = XMVector3Cross(m_Axis, axisB);
+    for (int k = 0; k < 2; ++k)
+    {
+        const float mass = a.GetAngularMass(m_Perpendiculars[k]) + b.GetAngularMass(m_Perpendiculars[k]);
+        m_AlignMass[k] = mass > 0.0f ? 1.0f / mass : 0.0f;
+        m_AlignBias[k] = XMVectorGetX(XMVector3Dot(misalignment, m_Perpendiculars[k])) * PositionCorrection / deltaTime;
+    }
+
+    //~ Only the part of last step's impulse that still lies across the axis
+    const XMVECTOR alignImpulse = XMLoadFloat3(&m_AlignImpulse);
+    XMStoreFloat3(&m_AlignImpulse, XMVectorSubtract(alignImpulse,
+        XMVectorScale(m_Axis, XMVectorGetX(XMVector3Dot(alignImpulse, m_Axis)))));
+
+    //~ Twist of B about the axis since construction, measured in A's frame
+    XMVECTOR twist = XMQuaternionMultiply(XMQuaternionConjugate(XMLoadFloat4(&m_ReferenceRotation)),
+        GetRelativeRotation(orientationA, orientationB));
+    if (XMVectorGetW(twist) < 0.0f) twist = XMVectorNegate(twist);
+    m_Angle = 2.0f * atan2f(XMVectorGetX(XMVector3Dot(twist, XMLoadFloat3(&m_LocalAxisA))), XMVectorGetW(twist));
+
+    if (!m_LimitsEnabled) return;
+
+    const float axialMass = a.GetAngularMass(m_Axis) + b.GetAngularMass(m_Axis);
+    m_AxialMass = axialMass > 0.0f ? 1.0f / axialMass : 0.0f;
+
+    //~ Short of a limit the body may close the gap within this step, past it the gap is
+    //~ corrected like any other drift
+    auto limitBias = [deltaTime](float gap)
+    {
+        return gap > 0.0f ? gap / deltaTime : gap * PositionCorrection / deltaTime;
+    };
+    m_LowerBias = limitBias(m_Angle - m_LowerAngle);
+    m_UpperBias = limitBias(m_UpperAngle - m_Angle);
+}
+
+void HingeConstraint::WarmStart(SolverBody& a, SolverBody& b) const
+{
+    using namespace DirectX;
+
+    m_Point.WarmStart(a, b);
+
+    const XMVECTOR angularImpulse = XMVectorAdd(XMLoadFloat3(&m_AlignImpulse),
+        XMVectorScale(m_Axis, m_LowerImpulse - m_UpperImpulse));
+    a.ApplyAngularImpulse(XMVectorNegate(angularImpulse));
+    b.ApplyAngularImpulse(angularImpulse);
+}
+
+//~ Limits, then alignment, then the point lock, which matters most to the eye
+void HingeConstraint::SolveVelocities(SolverBody& a, SolverBody& b)
+{
+    using namespace DirectX;
+
+    if (m_LimitsEnabled) SolveLimits(a, b);
+
+    XMVECTOR alignImpulse = XMLoadFloat3(&m_AlignImpulse);
+    for (int k = 0; k < 2; ++k)
+    {
+        const XMVECTOR velocity = XMVectorSubtract(b.AngularVelocity, a.AngularVelocity);
+        const float speed = XMVectorGetX(XMVector3Dot(velocity, m_Perpendiculars[k]));
+        const XMVECTOR impulse = XMVectorScale(m_Perpendiculars[k], -(speed + m_AlignBias[k]) * m_AlignMass[k]);
+
+        alignImpulse = XMVectorAdd(alignImpulse, impulse);
+        a.ApplyAngularImpulse(XMVectorNegate(impulse));
+        b.ApplyAngularImpulse(impulse);
+    }
+    XMStoreFloat3(&m_AlignImpulse, alignImpulse);
+
+    m_Point.Solve(a, b);
+}
+
+void HingeConstraint::SolveLimits(SolverBody& a, SolverBody& b)
+{
+    using namespace DirectX;
+
+    //~ Lower limit pushes B's angle up, the upper one down; both may only push
+    {
+        const float speed = XMVectorGetX(XMVector3Dot(XMVectorSubtract(b.AngularVelocity, a.AngularVelocity), m_Axis));
+        const float previous = m_LowerImpulse;
+        m_LowerImpulse = (std::max)(0.0f, previous - (speed + m_LowerBias) * m_AxialMass);
+
+        const XMVECTOR impulse = XMVectorScale(m_Axis, m_LowerImpulse - previous);
+        a.ApplyAngularImpulse(XMVectorNegate(impulse));
+        b.ApplyAngularImpulse(impulse);
+    }
+    {
+        const float speed = XMVectorGetX(XMVector3Dot(XMVectorSubtract(a.AngularVelocity, b.AngularVelocity), m_Axis));
+        const float previous = m_UpperImpulse;
+        m_UpperImpulse = (std::max)(0.0f, previous - (speed + m_UpperBias) * m_AxialMass);
+
+        const XMVECTOR impulse = XMVectorScale(m_Axis, m_UpperImpulse - previous);
+        a.ApplyAngularImpulse(impulse);
+        b.ApplyAngularImpulse(XMVectorNegate(impulse));
+    }
+}
+
+void HingeConstraint::ResetImpulses()
+{
+    m_Point.Impulse = { 0.0f, 0.0f, 0.0f };
+    m_AlignImpulse = { 0.0f, 0.0f, 0.0f };
+    m_LowerImpulse = 0.0f;
+    m_UpperImpulse = 0.0f;
+}
+
+void HingeConstraint::SaveState(StateWriter& writer) const
+{
+    writer.Write(m_Point.Impulse);
+    writer.Write(m_AlignImpulse);
+    writer.Write(m_LowerImpulse);
+    writer.Write(m_UpperImpulse);
+}
+
+bool HingeConstraint::RestoreState(StateReader& reader)
+{
+    return reader.Read(m_Point.Impulse) && reader.Read(m_AlignImpulse)
+        && reader.Read(m_LowerImpulse) && reader.Read(m_UpperImpulse);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Constraint.h"
+
+
+// Holds one point of each body together and lets them turn about a single shared axis
+// only: a door, a wheel, an elbow. The angle is measured from the pose at construction
+// (positive counter clockwise about the axis, B relative to A) and can be limited.
+// Limits act speculatively, a body swinging towards one slows down so it does not overshoot.
+class HingeConstraint final : public Constraint
+{
+public:
+    HingeConstraint(RigidBody* bodyA, RigidBody* bodyB, const DirectX::XMVECTOR& worldAnchor,
+        const DirectX::XMVECTOR& worldAxis);
+    ~HingeConstraint() override = default;
+
+    ConstraintType GetType() const override { return ConstraintType::Hinge; }
+
+    //~ Radians, within [-pi, pi]; enables the limits
+    void SetLimits(float lowerAngle, float upperAngle);
+    void SetLimitsEnabled(bool enabled);
+    bool AreLimitsEnabled() const { return m_LimitsEnabled; }
+    float GetLowerAngle() const { return m_LowerAngle; }
+    float GetUpperAngle() const { return m_UpperAngle; }
+
+    //~ Angle as of the last step
+    float GetAngle() const { return m_Angle; }
+
+    void Prepare(const SolverBody& a, const SolverBody& b, float deltaTime) override;
+    void WarmStart(SolverBody& a, SolverBody& b) const override;
+    void SolveVelocities(SolverBody& a, SolverBody& b) override;
+    void ResetImpulses() override;
+
+    void SaveState(StateWriter& writer) const override;
+    bool RestoreState(StateReader& reader) override;
+
+private:
+    void SolveLimits(SolverBody& a, SolverBody& b);
+
+private:
+    PointPart m_Point{};
+    DirectX::XMFLOAT3 m_LocalAxisA;
+    DirectX::XMFLOAT3 m_LocalAxisB;
+    DirectX::XMFLOAT4 m_ReferenceRotation;  //~ A to B at construction
+
+    bool m_LimitsEnabled{ false };
+    float m_LowerAngle{ 0.0f };
+    float m_UpperAngle{ 0.0f };
+
+    //~ Accumulated impulses. The alignment one is kept as a world space vector, the basis it
+    //~ is solved in is rebuilt from the axis every step.
+    DirectX::XMFLOAT3 m_AlignImpulse{ 0.0f, 0.0f, 0.0f };
+    float m_LowerImpulse{ 0.0f };
+    float m_UpperImpulse{ 0.0f };
+
+    //~ Cached by Prepare
+    DirectX::XMVECTOR m_Axis{};                 //~ world space, as A sees it
+    DirectX::XMVECTOR m_Perpendiculars[2]{};
+    float m_AlignMass[2]{};
+    float m_AlignBias[2]{};
+    float m_AxialMass{ 0.0f };
+    float m_LowerBias{ 0.0f };
+    float m_UpperBias{ 0.0f };
+    float m_Angle{ 0.0f };
+};
@@ -1,5 +1,28 @@
 #pragma once
 #include "RigidBody/IntegrationType.h"
 #include "RigidBody/RigidBody.h"
+#include "RigidBody/RigidBodyPool.h"
 #include "Collision/Cube/CubeCollider.h"
+#include "Collision/Sphere/SphereCollider.h"
+#include "Collision/Capsule/CapsuleCollider.h"
+#include "Collision/Plane/PlaneCollider.h"
+#include "PhysicsObject/PhysicsObjectPool.h"
+#include "Collision/CollisionDispatcher.h"
+#include "Collision/ContinuousCollision.h"
 #include "CollisionResolver/CollisionResolver.h"
+#include "CollisionResolver/ContactManifoldCache.h"
+#include "CollisionResolver/SeparatingAxisCache.h"
+#include "CollisionResolver/TriggerPairCache.h"
+#include "CollisionResolver/ContactSolver.h"
+#include "Constraint/DistanceConstraint.h"
+#include "Constraint/BallSocketConstraint.h"
+#include "Constraint/HingeConstraint.h"
+#include "Constraint/FixedConstraint.h"
+#include "Island/IslandManager.h"
+#include "Threading/WorkerPool.h"
+#include "Broadphase/SweepAndPrune.h"
+#include "Broadphase/DynamicTreeBroadphase.h"
+#include "Query/QueryWorld.h"
+#include "Profiling/PhysicsProfiler.h"
+#include "World/PhysicsWorld.h"
+#include "State/StateBuffer.h"
@@ -0,0 +1,309 @@
+#include "pch.h"
+#include "IslandManager.h"
+#include "Constraint/Constraint.h"
+#include "State/StateBuffer.h"
+
+#include <algorithm>
+#include <cfloat>
+
+
+void IslandManager::BuildIslands(const std::vector<ContactManifold*>& manifolds, const std::vector<Constraint*>& constraints)
+{
+    RigidBodyPool* pool = RigidBodyPool::Get();
+    const uint32_t capacity = static_cast<uint32_t>(pool->GetCapacity());
+
+    m_Parent.resize(capacity);
+    m_IslandSleepTime.resize(capacity);
+    m_RootToIsland.resize(capacity);
+    m_SlotIsland.resize(capacity, NoIsland);
+
+    if (m_SleepingEnabled) WakeDisturbedIslands(manifolds, constraints);
+
+    for (uint32_t slot = 0; slot < capacity; ++slot)
+    {
+        m_Parent[slot] = slot;
+        m_RootToIsland[slot] = NoIsland;
+    }
+
+    for (const ContactManifold* manifold : manifolds)
+    {
+        uint32_t slotA, slotB;
+        if (GetDynamicSlot(manifold->Colliders[0], slotA) && GetDynamicSlot(manifold->Colliders[1], slotB))
+        {
+            Union(slotA, slotB);
+        }
+    }
+    for (const Constraint* constraint : constraints)
+    {
+        uint32_t slotA, slotB;
+        if (GetDynamicSlot(constraint->GetBodyA(), slotA) && GetDynamicSlot(constraint->GetBodyB(), slotB))
+        {
+            Union(slotA, slotB);
+        }
+    }
+
+    //~ Manifolds against static geometry (and joints to the world) follow their dynamic body,
+    //~ static-static ones are dropped
+    for (std::vector<ContactManifold*>& island : m_ContactIslands) island.clear();
+    for (std::vector<Constraint*>& island : m_ConstraintIslands) island.clear();
+    m_ContactIslandCount = 0;
+
+    for (ContactManifold* manifold : manifolds)
+    {
+        uint32_t slot;
+        if (!GetDynamicSlot(manifold->Colliders[0], slot) && !GetDynamicSlot(manifold->Colliders[1], slot)) continue;
+
+        m_ContactIslands[GetContactIsland(slot)].push_back(manifold);
+    }
+    for (Constraint* constraint : constraints)
+    {
+        uint32_t slot;
+        if (!GetDynamicSlot(constraint->GetBodyA(), slot) && !GetDynamicSlot(constraint->GetBodyB(), slot)) continue;
+
+        m_ConstraintIslands[GetContactIsland(slot)].push_back(constraint);
+    }
+}
+
+void IslandManager::UpdateSleeping(float deltaTime)
+{
+    m_IslandCount = 0;
+    if (!m_SleepingEnabled) return;
+
+    RigidBodyPool* pool = RigidBodyPool::Get();
+    const uint32_t capacity = static_cast<uint32_t>(m_Parent.size());
+
+    //~ An island is only as sleepy as its most restless body
+    for (uint32_t slot = 0; slot < capacity; ++slot)
+    {
+        m_IslandSleepTime[slot] = FLT_MAX;
+        m_RootToIsland[slot] = NoIsland;
+    }
+
+    for (uint32_t slot = 0; slot < capacity; ++slot)
+    {
+        if (!pool->CanSleep(slot) || pool->IsSleeping(slot)) continue;
+
+        const float sleepTime = pool->UpdateSleepTime(slot, deltaTime, m_LinearSleepThreshold, m_AngularSleepThreshold);
+        float& islandTime = m_IslandSleepTime[Find(slot)];
+        islandTime = (std::min)(islandTime, sleepTime);
+    }
+
+    for (uint32_t slot = 0; slot < capacity; ++slot)
+    {
+        if (!pool->CanSleep(slot) || pool->IsSleeping(slot)) continue;
+
+        const uint32_t root = Find(slot);
+        if (root == slot) ++m_IslandCount;
+        if (m_IslandSleepTime[root] < m_TimeToSleep) continue;
+
+        if (m_RootToIsland[root] == NoIsland)
+        {
+            m_RootToIsland[root] = m_NextIslandId++;
+        }
+        const uint32_t island = m_RootToIsland[root];
+
+        pool->SetSleeping(slot, true);
+        m_SleepingIslands[island].push_back(slot);
+        m_SlotIsland[slot] = island;
+    }
+}
+
+void IslandManager::WakeAll()
+{
+    while (!m_SleepingIslands.empty())
+    {
+        WakeIsland(m_SleepingIslands.begin()->first);
+    }
+}
+
+void IslandManager::SaveState(StateWriter& writer) const
+{
+    writer.Write(m_NextIslandId);
+    writer.WriteVector(m_SlotIsland);
+    writer.Write(static_cast<uint64_t>(m_SleepingIslands.size()));
+    for (const auto& [island, slots] : m_SleepingIslands)
+    {
+        writer.Write(island);
+        writer.WriteVector(slots);
+    }
+}
+
+bool IslandManager::RestoreState(StateReader& reader)
+{
+    uint64_t sleepingCount = 0;
+    if (!reader.Read(m_NextIslandId) || !reader.ReadVector(m_SlotIsland) || !reader.Read(sleepingCount)) return false;
+
+    m_SleepingIslands.clear();
+    for (uint64_t i = 0; i < sleepingCount; ++i)
+    {
+        uint32_t island = 0;
+        if (!reader.Read(island) || !reader.ReadVector(m_SleepingIslands[island])) return false;
+    }
+    return true;
+}
+
+void IslandManager::SetSleepingEnabled(bool enabled)
+{
+    m_SleepingEnabled = enabled;
+    if (!enabled) WakeAll();
+}
+
+void IslandManager::SetSleepThresholds(float linear, float angular)
+{
+    m_LinearSleepThreshold = linear;
+    m_AngularSleepThreshold = angular;
+}
+
+bool IslandManager::IsResting(const ICollider* collider)
+{
+    if (collider->GetColliderState() == ColliderState::Static) return true;
+
+    const RigidBody* body = collider->GetRigidBody();
+    if (body->IsKinematic()) return !RigidBodyPool::Get()->IsKinematicMoving(body->GetSlot());
+    return body->GetRestingState();
+}
+
+uint32_t IslandManager::Find(uint32_t slot)
+{
+    //~ Path halving
+    while (m_Parent[slot] != slot)
+    {
+        m_Parent[slot] = m_Parent[m_Parent[slot]];
+        slot = m_Parent[slot];
+    }
+    return slot;
+}
+
+void IslandManager::Union(uint32_t a, uint32_t b)
+{
+    const uint32_t rootA = Find(a);
+    const uint32_t rootB = Find(b);
+    if (rootA == rootB) return;
+
+    //~ Lower slot becomes the root, keeps the result independent of the manifold order
+    if (rootA < rootB) m_Parent[rootB] = rootA;
+    else m_Parent[rootA] = rootB;
+}
+
+uint32_t IslandManager::GetContactIsland(uint32_t slot)
+{
+    uint32_t& island = m_RootToIsland[Find(slot)];
+    if (island == NoIsland)
+    {
+        island = m_ContactIslandCount++;
+        if (m_ContactIslands.size() < m_ContactIslandCount)
+        {
+            m_ContactIslands.emplace_back();
+            m_ConstraintIslands.emplace_back();
+        }
+    }
+    return island;
+}
+
+void IslandManager::WakeIsland(uint32_t island)
+{
+    const auto it = m_SleepingIslands.find(island);
+    if (it == m_SleepingIslands.end()) return;
+
+    RigidBodyPool* pool = RigidBodyPool::Get();
+    for (const uint32_t slot : it->second)
+    {
+        //~ The slot may have been released and handed to another body since
+        if (m_SlotIsland[slot] != island) continue;
+
+        m_SlotIsland[slot] = NoIsland;
+        pool->SetSleeping(slot, false);
+    }
+    m_SleepingIslands.erase(it);
+}
+
+void IslandManager::WakeDisturbedIslands(const std::vector<ContactManifold*>& manifolds,
+    const std::vector<Constraint*>& constraints)
+{
+    RigidBodyPool* pool = RigidBodyPool::Get();
+
+    //~ Some member was woken directly or removed from the simulation
+    std::vector<uint32_t>& disturbed = m_DisturbedIslands;
+    disturbed.clear();
+    for (const auto& [island, slots] : m_SleepingIslands)
+    {
+        const bool isDisturbed = std::any_of(slots.begin(), slots.end(), [&](uint32_t slot)
+        {
+            return m_SlotIsland[slot] == island && (!pool->IsSleeping(slot) || !pool->CanSleep(slot));
+        });
+        if (isDisturbed) disturbed.push_back(island);
+    }
+
+    //~ A sleeping body touched by (or jointed to) an awake one, or carried by a moving kinematic one
+    for (const ContactManifold* manifold : manifolds)
+    {
+        uint32_t slotA, slotB;
+        const bool dynamicA = GetDynamicSlot(manifold->Colliders[0], slotA);
+        const bool dynamicB = GetDynamicSlot(manifold->Colliders[1], slotB);
+        if (dynamicA && dynamicB) WakeLinked(slotA, slotB, disturbed);
+        else if (dynamicA && IsMovingKinematic(manifold->Colliders[1])) WakeSlot(slotA, disturbed);
+        else if (dynamicB && IsMovingKinematic(manifold->Colliders[0])) WakeSlot(slotB, disturbed);
+    }
+    for (const Constraint* constraint : constraints)
+    {
+        uint32_t slotA, slotB;
+        const bool dynamicA = GetDynamicSlot(constraint->GetBodyA(), slotA);
+        const bool dynamicB = GetDynamicSlot(constraint->GetBodyB(), slotB);
+        if (dynamicA && dynamicB) WakeLinked(slotA, slotB, disturbed);
+        else if (dynamicA && IsMovingKinematic(constraint->GetBodyB())) WakeSlot(slotA, disturbed);
+        else if (dynamicB && IsMovingKinematic(constraint->GetBodyA())) WakeSlot(slotB, disturbed);
+    }
+
+    for (const uint32_t island : disturbed)
+    {
+        WakeIsland(island);
+    }
+}
+
+void IslandManager::WakeLinked(uint32_t slotA, uint32_t slotB, std::vector<uint32_t>& disturbed)
+{
+    RigidBodyPool* pool = RigidBodyPool::Get();
+
+    const bool sleepingA = pool->IsSleeping(slotA);
+    const bool sleepingB = pool->IsSleeping(slotB);
+    if (sleepingA == sleepingB) return;
+
+    WakeSlot(sleepingA ? slotA : slotB, disturbed);
+}
+
+void IslandManager::WakeSlot(uint32_t slot, std::vector<uint32_t>& disturbed)
+{
+    RigidBodyPool* pool = RigidBodyPool::Get();
+    if (!pool->IsSleeping(slot)) return;
+
+    const uint32_t island = m_SlotIsland[slot];
+    if (island != NoIsland) disturbed.push_back(island);
+    else pool->SetSleeping(slot, false);
+}
+
+bool IslandManager::GetDynamicSlot(const ICollider* collider, uint32_t& outSlot)
+{
+    if (!collider || collider->GetColliderState() != ColliderState::Dynamic) return false;
+
+    outSlot = collider->GetRigidBody()->GetSlot();
+    return RigidBodyPool::Get()->CanSleep(outSlot);
+}
+
+bool IslandManager::GetDynamicSlot(const RigidBody* body, uint32_t& outSlot)
+{
+    if (!body) return false;
+
+    outSlot = body->GetSlot();
+    return RigidBodyPool::Get()->CanSleep(outSlot);
+}
+
+bool IslandManager::IsMovingKinematic(const ICollider* collider)
+{
+    return collider && collider->GetColliderState() == ColliderState::Dynamic &&
+           IsMovingKinematic(collider->GetRigidBody());
+}
+
+bool IslandManager::IsMovingKinematic(const RigidBody* body)
+{
+    return body && RigidBodyPool::Get()->IsKinematicMoving(body->GetSlot());
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Collision/ContactManifold.h"
+
+class Constraint;
+class StateReader;
+class StateWriter;
+
+// Groups bodies that touch or are jointed into islands (union-find over the contact and
+// constraint graph of the step).
+// The islands share no dynamic body, so their contacts can be solved independently (and
+// in parallel), and an island is put to sleep once every body in it has stayed below the
+// velocity thresholds for TimeToSleep seconds. Islands sleep and wake as a whole: touching an awake
+// body, or waking any member directly (AddForce, SetVelocity, ...), wakes all of it.
+// Static colliders and kinematic bodies never join an island, so everything resting on the same
+// floor or platform does not end up in one giant island. A moving kinematic body wakes what it touches.
+class IslandManager
+{
+public:
+    IslandManager() = default;
+    ~IslandManager() = default;
+
+    IslandManager(const IslandManager&) = delete;
+    IslandManager(IslandManager&&) = default;
+    IslandManager& operator=(const IslandManager&) = delete;
+    IslandManager& operator=(IslandManager&&) = default;
+
+    //~ Call once per step after the narrowphase: wakes disturbed islands and groups the manifolds
+    //~ and constraints
+    void BuildIslands(const std::vector<ContactManifold*>& manifolds, const std::vector<Constraint*>& constraints);
+
+    //~ Manifolds and constraints of each island, in the order they were given to BuildIslands.
+    //~ Both have GetContactIslandCount entries in use, an island may have only one kind.
+    const std::vector<std::vector<ContactManifold*>>& GetContactIslands() const { return m_ContactIslands; }
+    const std::vector<std::vector<Constraint*>>& GetConstraintIslands() const { return m_ConstraintIslands; }
+    uint32_t GetContactIslandCount() const { return m_ContactIslandCount; }
+
+    //~ Call after the contacts were solved, puts the islands that came to rest to sleep
+    void UpdateSleeping(float deltaTime);
+
+    //~ Wakes every sleeping island and forgets them (sleeping disabled, scene cleared, ...)
+    void WakeAll();
+
+    void SetSleepingEnabled(bool enabled);
+    bool IsSleepingEnabled() const { return m_SleepingEnabled; }
+
+    void SetSleepThresholds(float linear, float angular);
+    void SetTimeToSleep(float seconds) { m_TimeToSleep = seconds; }
+
+    //~ Awake islands seen by the last UpdateSleeping
+    uint32_t GetIslandCount() const { return m_IslandCount; }
+    size_t GetSleepingIslandCount() const { return m_SleepingIslands.size(); }
+
+    //~ Which sleeping bodies wake together, for rollback along with the pool's sleep flags
+    void SaveState(StateWriter& writer) const;
+    bool RestoreState(StateReader& reader);
+
+    //~ True when the collider never moves on its own this step (static, asleep, or kinematic
+    //~ and standing still)
+    static bool IsResting(const ICollider* collider);
+
+private:
+    static constexpr uint32_t NoIsland = 0xFFFFFFFFu;
+
+    uint32_t Find(uint32_t slot);
+    void Union(uint32_t a, uint32_t b);
+
+    //~ Island of the slot's root for this step, opened on first use
+    uint32_t GetContactIsland(uint32_t slot);
+
+    void WakeIsland(uint32_t island);
+    void WakeDisturbedIslands(const std::vector<ContactManifold*>& manifolds, const std::vector<Constraint*>& constraints);
+    void WakeLinked(uint32_t slotA, uint32_t slotB, std::vector<uint32_t>& disturbed);
+    void WakeSlot(uint32_t slot, std::vector<uint32_t>& disturbed);
+    static bool GetDynamicSlot(const ICollider* collider, uint32_t& outSlot);
+    static bool GetDynamicSlot(const RigidBody* body, uint32_t& outSlot);
+    static bool IsMovingKinematic(const ICollider* collider);
+    static bool IsMovingKinematic(const RigidBody* body);
+
+private:
+    //~ Union-find, indexed by pool slot
+    std::vector<uint32_t> m_Parent{};
+    std::vector<float> m_IslandSleepTime{};     //~ smallest sleep time in the island, stored on the root
+    std::vector<uint32_t> m_RootToIsland{};
+
+    //~ Grouped manifolds and constraints, inner vectors are reused between steps
+    std::vector<std::vector<ContactManifold*>> m_ContactIslands{};
+    std::vector<std::vector<Constraint*>> m_ConstraintIslands{};
+    uint32_t m_ContactIslandCount{ 0 };
+
+    //~ Sleeping islands by id, and the id of the island each sleeping slot belongs to
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_SleepingIslands{};
+    std::vector<uint32_t> m_SlotIsland{};
+    std::vector<uint32_t> m_DisturbedIslands{};
+    uint32_t m_NextIslandId{ 0 };
+
+    uint32_t m_IslandCount{ 0 };
+    bool m_SleepingEnabled{ true };
+    float m_LinearSleepThreshold{ 0.05f };
+    float m_AngularSleepThreshold{ 0.05f };
+    float m_TimeToSleep{ 0.5f };
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+
+// Names one body and its collider in PhysicsObjectPool. The slot's generation moves on every
+// time the object is destroyed, so a handle kept past that resolves to nothing instead of to
+// whatever object takes the slot next.
+struct PhysicsHandle
+{
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t Index{ InvalidIndex };
+    uint32_t Generation{ 0 };
+
+    bool IsValid() const { return Index != InvalidIndex; }
+    bool operator==(const PhysicsHandle& other) const = default;
+};
@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "PhysicsObjectPool.h"
+
+
+PhysicsObjectPool* PhysicsObjectPool::Get()
+{
+    //~ The bodies release their RigidBodyPool slots when this pool goes away, so that one has to
+    //~ be constructed first to be destroyed last
+    RigidBodyPool::Get();
+    static PhysicsObjectPool instance{};
+    return &instance;
+}
+
+PhysicsObjectPool::~PhysicsObjectPool()
+{
+    for (uint32_t index = 0; index < m_Alive.size(); ++index)
+    {
+        if (!m_Alive[index]) continue;
+
+        Entry& entry = GetEntry(index);
+        GetEntryCollider(entry)->~ICollider();
+        GetBody(entry)->~RigidBody();
+    }
+}
+
+PhysicsHandle PhysicsObjectPool::Create(ColliderType type)
+{
+    if (m_FreeSlots.empty()) Grow();
+
+    const uint32_t index = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+
+    Entry& entry = GetEntry(index);
+    RigidBody* body = new (entry.Body) RigidBody();
+    if (!ConstructCollider(entry, type, body)) ConstructCollider(entry, ColliderType::Cube, body);
+
+    m_Alive[index] = 1;
+    ++m_AliveCount;
+    return { index, m_Generations[index] };
+}
+
+void PhysicsObjectPool::Destroy(PhysicsHandle handle)
+{
+    if (!IsAlive(handle)) return;
+
+    Entry& entry = GetEntry(handle.Index);
+    GetEntryCollider(entry)->~ICollider();
+    GetBody(entry)->~RigidBody();
+
+    m_Alive[handle.Index] = 0;
+    ++m_Generations[handle.Index];
+    m_FreeSlots.push_back(handle.Index);
+    --m_AliveCount;
+}
+
+bool PhysicsObjectPool::IsAlive(PhysicsHandle handle) const
+{
+    return handle.Index < m_Generations.size() && m_Alive[handle.Index] &&
+           m_Generations[handle.Index] == handle.Generation;
+}
+
+RigidBody* PhysicsObjectPool::GetRigidBody(PhysicsHandle handle) const
+{
+    return IsAlive(handle) ? GetBody(GetEntry(handle.Index)) : nullptr;
+}
+
+ICollider* PhysicsObjectPool::GetCollider(PhysicsHandle handle) const
+{
+    return IsAlive(handle) ? GetEntryCollider(GetEntry(handle.Index)) : nullptr;
+}
+
+bool PhysicsObjectPool::SetColliderType(PhysicsHandle handle, ColliderType type)
+{
+    if (!IsAlive(handle) || type >= ColliderType::Count) return false;
+
+    Entry& entry = GetEntry(handle.Index);
+    ICollider* collider = GetEntryCollider(entry);
+    if (collider->GetColliderType() == type) return true;
+
+    const ColliderState state = collider->GetColliderState();
+    const uint8_t layer = collider->GetLayer();
+    const DirectX::XMVECTOR scale = collider->GetScale();
+    collider->~ICollider();
+
+    collider = ConstructCollider(entry, type, GetBody(entry));
+    collider->SetColliderState(state);
+    collider->SetLayer(layer);
+    collider->SetScale(scale);
+    return true;
+}
+
+ICollider* PhysicsObjectPool::ConstructCollider(Entry& entry, ColliderType type, RigidBody* body)
+{
+    switch (type)
+    {
+    case ColliderType::Cube:    return new (entry.Collider) CubeCollider(body);
+    case ColliderType::Sphere:  return new (entry.Collider) SphereCollider(body);
+    case ColliderType::Capsule: return new (entry.Collider) CapsuleCollider(body);
+    case ColliderType::Plane:   return new (entry.Collider) PlaneCollider(body);
+    default:                    return nullptr;
+    }
+}
+
+void PhysicsObjectPool::Grow()
+{
+    const uint32_t first = static_cast<uint32_t>(m_Generations.size());
+    m_Chunks.push_back(std::make_unique<Chunk>());
+    m_Generations.resize(first + ChunkSize, 0);
+    m_Alive.resize(first + ChunkSize, 0);
+
+    //~ Handed out lowest index first
+    for (uint32_t index = first + ChunkSize; index > first; --index)
+    {
+        m_FreeSlots.push_back(index - 1);
+    }
+}
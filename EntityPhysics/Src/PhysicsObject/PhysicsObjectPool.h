@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "PhysicsHandle.h"
+#include "Collision/Cube/CubeCollider.h"
+#include "Collision/Sphere/SphereCollider.h"
+#include "Collision/Capsule/CapsuleCollider.h"
+#include "Collision/Plane/PlaneCollider.h"
+
+
+// Owns the RigidBody and collider of every physics object, addressed by PhysicsHandle.
+// Each object is one cache line aligned entry holding the body (itself a handle into
+// RigidBodyPool) next to its collider, in storage sized for the largest collider type, so
+// changing the shape rebuilds the collider where it is. Entries live in fixed size chunks that
+// never move: the RigidBody* and ICollider* handed out stay valid until the object is
+// destroyed, which is what the broadphase, caches and constraints hold on to.
+// Create and Destroy are for the thread that runs the frames, like the PhysicsSystem.
+class PhysicsObjectPool
+{
+public:
+    static constexpr uint32_t ChunkSize = 64;   //~ entries per chunk
+
+    static PhysicsObjectPool* Get();
+
+    ~PhysicsObjectPool();
+
+    PhysicsObjectPool(const PhysicsObjectPool&) = delete;
+    PhysicsObjectPool(PhysicsObjectPool&&) = delete;
+    PhysicsObjectPool& operator=(const PhysicsObjectPool&) = delete;
+    PhysicsObjectPool& operator=(PhysicsObjectPool&&) = delete;
+
+    //~ A new body (not simulated until added to a PhysicsSystem) with a collider of 'type'
+    PhysicsHandle Create(ColliderType type = ColliderType::Cube);
+    void Destroy(PhysicsHandle handle);
+    bool IsAlive(PhysicsHandle handle) const;
+
+    //~ Null for handles that are invalid or were destroyed
+    RigidBody* GetRigidBody(PhysicsHandle handle) const;
+    ICollider* GetCollider(PhysicsHandle handle) const;
+
+    //~ Replaces the collider with one of 'type' at the same address, keeping its state, layer and
+    //~ scale (trigger targets are dropped). Do it before the object is added to a PhysicsSystem.
+    bool SetColliderType(PhysicsHandle handle, ColliderType type);
+
+    size_t GetAliveCount() const { return m_AliveCount; }
+    size_t GetCapacity() const { return m_Generations.size(); }
+
+private:
+    PhysicsObjectPool() = default;
+
+    static constexpr size_t ColliderSize = (std::max)({ sizeof(CubeCollider), sizeof(SphereCollider),
+        sizeof(CapsuleCollider), sizeof(PlaneCollider) });
+    static constexpr size_t ColliderAlignment = (std::max)({ alignof(CubeCollider), alignof(SphereCollider),
+        alignof(CapsuleCollider), alignof(PlaneCollider) });
+
+    //~ Constructed and destroyed in place, only while the slot is alive
+    struct alignas(64) Entry
+    {
+        alignas(ColliderAlignment) std::byte Collider[ColliderSize];
+        alignas(RigidBody) std::byte Body[sizeof(RigidBody)];
+    };
+
+    struct Chunk
+    {
+        Entry Entries[ChunkSize];
+    };
+
+    Entry& GetEntry(uint32_t index) const { return m_Chunks[index / ChunkSize]->Entries[index % ChunkSize]; }
+    static RigidBody* GetBody(Entry& entry) { return std::launder(reinterpret_cast<RigidBody*>(entry.Body)); }
+    static ICollider* GetEntryCollider(Entry& entry) { return std::launder(reinterpret_cast<ICollider*>(entry.Collider)); }
+    static ICollider* ConstructCollider(Entry& entry, ColliderType type, RigidBody* body);
+
+    void Grow();
+
+private:
+    std::vector<std::unique_ptr<Chunk>> m_Chunks{};
+    std::vector<uint32_t> m_Generations{};
+    std::vector<uint8_t> m_Alive{};
+    std::vector<uint32_t> m_FreeSlots{};
+    size_t m_AliveCount{ 0 };
+};
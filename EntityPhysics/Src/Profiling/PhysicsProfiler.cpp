@@ -0,0 +1,128 @@
+#include "pch.h"
+#include "PhysicsProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+
+void PhysicsProfiler::BeginStep(float deltaTime)
+{
+    m_Current = PhysicsStepProfile{};
+    m_Current.Step = m_StepIndex++;
+    m_Current.DeltaTime = deltaTime;
+    if (m_Enabled) m_StepStart = Clock::now();
+}
+
+void PhysicsProfiler::EndStep()
+{
+    if (!m_Enabled) return;
+
+    const std::chrono::duration<float, std::milli> elapsed = Clock::now() - m_StepStart;
+    m_Current.TotalMs = elapsed.count();
+
+    m_Records[m_Next] = m_Current;
+    m_Next = (m_Next + 1) % Capacity;
+    m_Count = (std::min)(m_Count + 1, Capacity);
+}
+
+const PhysicsStepProfile& PhysicsProfiler::GetRecord(size_t index) const
+{
+    //~ The oldest record sits where the next one will be written once the buffer is full
+    const size_t oldest = m_Count < Capacity ? 0 : m_Next;
+    return m_Records[(oldest + index) % Capacity];
+}
+
+const PhysicsStepProfile* PhysicsProfiler::GetLatest() const
+{
+    return m_Count > 0 ? &GetRecord(m_Count - 1) : nullptr;
+}
+
+PhysicsStepProfile PhysicsProfiler::GetAverage(size_t count) const
+{
+    PhysicsStepProfile average{};
+    count = (std::min)(count, m_Count);
+    if (count == 0) return average;
+
+    //~ Counters are summed wide and divided once, so long runs do not lose them to rounding
+    double deltaTime = 0.0, totalMs = 0.0;
+    double phaseMs[PhysicsStepProfile::PhaseCount]{};
+    uint64_t bodies = 0, candidates = 0, tested = 0, touching = 0, contacts = 0, axes = 0;
+    uint64_t constraints = 0, islands = 0, iterations = 0;
+    for (size_t i = m_Count - count; i < m_Count; ++i)
+    {
+        const PhysicsStepProfile& record = GetRecord(i);
+        deltaTime += record.DeltaTime;
+        totalMs += record.TotalMs;
+        for (size_t phase = 0; phase < PhysicsStepProfile::PhaseCount; ++phase)
+        {
+            phaseMs[phase] += record.PhaseMs[phase];
+        }
+        bodies += record.BodiesIntegrated;
+        candidates += record.CandidatePairs;
+        tested += record.PairsTested;
+        touching += record.TouchingPairs;
+        contacts += record.Contacts;
+        axes += record.SATAxesTested;
+        constraints += record.Constraints;
+        islands += record.Islands;
+        iterations += record.SolverIterations;
+    }
+
+    const double scale = 1.0 / static_cast<double>(count);
+    auto mean = [scale](uint64_t sum) { return static_cast<uint32_t>(static_cast<double>(sum) * scale + 0.5); };
+
+    average.Step = GetRecord(m_Count - 1).Step;
+    average.DeltaTime = static_cast<float>(deltaTime * scale);
+    average.TotalMs = static_cast<float>(totalMs * scale);
+    for (size_t phase = 0; phase < PhysicsStepProfile::PhaseCount; ++phase)
+    {
+        average.PhaseMs[phase] = static_cast<float>(phaseMs[phase] * scale);
+    }
+    average.BodiesIntegrated = mean(bodies);
+    average.CandidatePairs = mean(candidates);
+    average.PairsTested = mean(tested);
+    average.TouchingPairs = mean(touching);
+    average.Contacts = mean(contacts);
+    average.SATAxesTested = mean(axes);
+    average.Constraints = mean(constraints);
+    average.Islands = mean(islands);
+    average.SolverIterations = mean(iterations);
+    return average;
+}
+
+void PhysicsProfiler::Clear()
+{
+    m_Next = 0;
+    m_Count = 0;
+    m_StepIndex = 0;
+}
+
+const char* PhysicsProfiler::GetPhaseName(PhysicsPhase phase)
+{
+    switch (phase)
+    {
+    case PhysicsPhase::Integrate:   return "Integrate";
+    case PhysicsPhase::Broadphase:  return "Broadphase";
+    case PhysicsPhase::Narrowphase: return "Narrowphase";
+    case PhysicsPhase::Solve:       return "Solve";
+    case PhysicsPhase::Publish:     return "Publish";
+    default:                        return "Unknown";
+    }
+}
+
+std::string PhysicsProfiler::ToString(const PhysicsStepProfile& profile)
+{
+    char text[384];
+    std::snprintf(text, sizeof(text),
+        "step %llu: %.3f ms (integrate %.3f, broadphase %.3f, narrowphase %.3f, solve %.3f, publish %.3f) | "
+        "bodies %u, pairs %u / %u tested / %u touching, contacts %u, SAT axes %llu, "
+        "constraints %u, islands %u, iterations %u",
+        static_cast<unsigned long long>(profile.Step), profile.TotalMs,
+        profile.GetPhaseMs(PhysicsPhase::Integrate), profile.GetPhaseMs(PhysicsPhase::Broadphase),
+        profile.GetPhaseMs(PhysicsPhase::Narrowphase), profile.GetPhaseMs(PhysicsPhase::Solve),
+        profile.GetPhaseMs(PhysicsPhase::Publish),
+        profile.BodiesIntegrated, profile.CandidatePairs, profile.PairsTested, profile.TouchingPairs,
+        profile.Contacts, static_cast<unsigned long long>(profile.SATAxesTested),
+        profile.Constraints, profile.Islands, profile.SolverIterations);
+    return text;
+}
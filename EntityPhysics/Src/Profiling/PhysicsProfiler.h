@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+enum class PhysicsPhase : uint8_t
+{
+    Integrate,      //~ collider updates, body integration and continuous collision
+    Broadphase,     //~ bounds update, pair search and pair filtering
+    Narrowphase,    //~ pair tests and the merge into the caches
+    Solve,          //~ islands, contact and constraint solving, sleeping
+    Publish,        //~ transforms, trigger events and the query world
+    Count,
+};
+
+// What one physics step did and how long each part of it took
+struct PhysicsStepProfile
+{
+    static constexpr size_t PhaseCount = static_cast<size_t>(PhysicsPhase::Count);
+
+    uint64_t Step{ 0 };             //~ running index, counts every step since the profiler was cleared
+    float DeltaTime{ 0.0f };
+    float PhaseMs[PhaseCount]{};
+    float TotalMs{ 0.0f };
+
+    uint32_t BodiesIntegrated{ 0 };
+    uint32_t CandidatePairs{ 0 };   //~ from the broadphase, after filtering
+    uint32_t PairsTested{ 0 };      //~ candidates not skipped as resting
+    uint32_t TouchingPairs{ 0 };    //~ solid pairs, triggers not counted
+    uint32_t Contacts{ 0 };         //~ points over every touching pair
+    uint64_t SATAxesTested{ 0 };
+    uint32_t Constraints{ 0 };      //~ active ones
+    uint32_t Islands{ 0 };
+    uint32_t SolverIterations{ 0 }; //~ summed over the islands
+
+    float GetPhaseMs(PhysicsPhase phase) const { return PhaseMs[static_cast<size_t>(phase)]; }
+};
+
+// Per step timings and counters of the physics step, kept for the last Capacity steps.
+// The step fills the current record between BeginStep and EndStep (phases through
+// ScopedPhase, counters straight into GetCurrent) and EndStep files it into a fixed ring
+// buffer, so profiling never allocates. Everything here is meant for the thread that runs
+// the step; a disabled profiler skips the clock reads and records nothing.
+class PhysicsProfiler
+{
+public:
+    static constexpr size_t Capacity = 256;
+    using Clock = std::chrono::steady_clock;
+
+    //~ Times the enclosing scope into one phase of the current record
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase(PhysicsProfiler& profiler, PhysicsPhase phase)
+            : m_Profiler(profiler.m_Enabled ? &profiler : nullptr), m_Phase(phase)
+        {
+            if (m_Profiler) m_Start = Clock::now();
+        }
+
+        ~ScopedPhase()
+        {
+            if (!m_Profiler) return;
+            const std::chrono::duration<float, std::milli> elapsed = Clock::now() - m_Start;
+            m_Profiler->m_Current.PhaseMs[static_cast<size_t>(m_Phase)] += elapsed.count();
+        }
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase(ScopedPhase&&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(ScopedPhase&&) = delete;
+
+    private:
+        PhysicsProfiler* m_Profiler;
+        PhysicsPhase m_Phase;
+        Clock::time_point m_Start{};
+    };
+
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+    bool IsEnabled() const { return m_Enabled; }
+
+    void BeginStep(float deltaTime);
+    void EndStep();
+
+    //~ The record of the step in progress
+    PhysicsStepProfile& GetCurrent() { return m_Current; }
+
+    //~ Finished steps, index 0 is the oldest still kept
+    size_t GetRecordCount() const { return m_Count; }
+    const PhysicsStepProfile& GetRecord(size_t index) const;
+    const PhysicsStepProfile* GetLatest() const;
+
+    //~ Mean of the newest 'count' records (all of them when there are fewer), in every field
+    //~ but Step, which is the newest step
+    PhysicsStepProfile GetAverage(size_t count) const;
+
+    void Clear();
+
+    static const char* GetPhaseName(PhysicsPhase phase);
+
+    //~ One line, for logs
+    static std::string ToString(const PhysicsStepProfile& profile);
+
+private:
+    std::array<PhysicsStepProfile, Capacity> m_Records{};
+    size_t m_Next{ 0 };     //~ where the next finished step goes
+    size_t m_Count{ 0 };
+    uint64_t m_StepIndex{ 0 };
+
+    PhysicsStepProfile m_Current{};
+    Clock::time_point m_StepStart{};
+    bool m_Enabled{ true };
+};
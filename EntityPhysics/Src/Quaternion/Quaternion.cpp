@@ -1,66 +1,33 @@
 #include "pch.h"
 #include "Quaternion.h"
-#include <cmath>
 
-Quaternion::Quaternion() : R(1), I(0), J(0), K(0) {}
+#include <algorithm>
+
+Quaternion::Quaternion() : m_Value(DirectX::XMQuaternionIdentity()) {}
 Quaternion::Quaternion(float r, float i, float j, float k)
-    : R(r), I(i), J(j), K(k)
+    : m_Value(DirectX::XMVectorSet(i, j, k, r))
 {
 }
 
-DirectX::XMVECTOR Quaternion::ToXmVector() const
+Quaternion::Quaternion(const DirectX::XMVECTOR& value)
+    : m_Value(value)
 {
-    return DirectX::XMVectorSet(
-        I.load(std::memory_order_relaxed),
-        J.load(std::memory_order_relaxed),
-        K.load(std::memory_order_relaxed),
-        R.load(std::memory_order_relaxed)
-    );
 }
 
 void Quaternion::Normalize()
 {
-    // Read all components atomically
-    float r = R.load(std::memory_order_relaxed);
-    float i = I.load(std::memory_order_relaxed);
-    float j = J.load(std::memory_order_relaxed);
-    float k = K.load(std::memory_order_relaxed);
-
-    float d = r * r + i * i + j * j + k * k;
-
-    if (d == 0.f)
-    {
-        R.store(1.0f, std::memory_order_relaxed);
-        I.store(0.0f, std::memory_order_relaxed);
-        J.store(0.0f, std::memory_order_relaxed);
-        K.store(0.0f, std::memory_order_relaxed);
-        return;
-    }
-
-    float inv = 1.0f / std::sqrt(d);
-
-    R.store(r * inv, std::memory_order_relaxed);
-    I.store(i * inv, std::memory_order_relaxed);
-    J.store(j * inv, std::memory_order_relaxed);
-    K.store(k * inv, std::memory_order_relaxed);
+    m_Value = Normalized(m_Value);
 }
 
 DirectX::XMVECTOR Quaternion::RotateVector(const DirectX::XMVECTOR& v) const
 {
     using namespace DirectX;
 
-    XMVECTOR q = XMVectorSet(
-        I.load(std::memory_order_relaxed),
-        J.load(std::memory_order_relaxed),
-        K.load(std::memory_order_relaxed),
-        R.load(std::memory_order_relaxed)
-    );
-
-    XMVECTOR qInv = XMQuaternionInverse(q);
+    XMVECTOR qInv = XMQuaternionInverse(m_Value);
     XMVECTOR vec = XMVectorSetW(v, 0.0f);
 
     XMVECTOR result = XMQuaternionMultiply(
-        XMQuaternionMultiply(q, vec),
+        XMQuaternionMultiply(m_Value, vec),
         qInv
     );
 
@@ -69,110 +36,168 @@ DirectX::XMVECTOR Quaternion::RotateVector(const DirectX::XMVECTOR& v) const
 
 Quaternion Quaternion::operator*(const Quaternion& q) const
 {
-    DirectX::XMVECTOR q1 = ToXmVector();     // This = [x, y, z, w]
-    DirectX::XMVECTOR q2 = q.ToXmVector();   // q    = [x, y, z, w]
-
-    // Multiply in standard quaternion order
-    DirectX::XMVECTOR result = DirectX::XMQuaternionMultiply(q1, q2);
-
-    // Convert the result vector back into a Quaternion object
-    DirectX::XMFLOAT4 f;
-    DirectX::XMStoreFloat4(&f, result);      // f = [x, y, z, w]
-    return Quaternion(f.w, f.x, f.y, f.z);   // return Quaternion(w, x, y, z)
+    // XMQuaternionMultiply(a, b) is b * a in Hamilton order
+    return Quaternion(DirectX::XMQuaternionMultiply(m_Value, q.m_Value));
 }
 
 void Quaternion::AddScaledVector(const DirectX::XMVECTOR& vector, float scale)
 {
-    float r = R.load();
-    float i = I.load();
-    float j = J.load();
-    float k = K.load();
-
-    DirectX::XMVECTOR scaled = DirectX::XMVectorScale(vector, scale);
-    float x = DirectX::XMVectorGetX(scaled);
-    float y = DirectX::XMVectorGetY(scaled);
-    float z = DirectX::XMVectorGetZ(scaled);
-
-    // q = (0, x, y, z)
-    float qr = -(i * x + j * y + k * z); // dot
-    float qi = r * x + j * z - k * y;
-    float qj = r * y + k * x - i * z;
-    float qk = r * z + i * y - j * x;
+    using namespace DirectX;
 
-    // Add scaled half to original
-    R.store(r + 0.5f * qr);
-    I.store(i + 0.5f * qi);
-    J.store(j + 0.5f * qj);
-    K.store(k + 0.5f * qk);
+    // Add scaled half of q * (0, vector * scale) to the original
+    const XMVECTOR delta = MultiplyByVector(m_Value, XMVectorScale(vector, scale));
+    m_Value = XMVectorMultiplyAdd(delta, XMVectorReplicate(0.5f), m_Value);
 }
 
 void Quaternion::RotateByVector(const DirectX::XMVECTOR& vector)
 {
-    float r = R.load();
-    float i = I.load();
-    float j = J.load();
-    float k = K.load();
-
-    float x = DirectX::XMVectorGetX(vector);
-    float y = DirectX::XMVectorGetY(vector);
-    float z = DirectX::XMVectorGetZ(vector);
-
     // q = this * Quaternion(0, x, y, z)
-    float qr = -i * x - j * y - k * z;
-    float qi = r * x + j * z - k * y;
-    float qj = r * y + k * x - i * z;
-    float qk = r * z + i * y - j * x;
-
-    R.store(qr);
-    I.store(qi);
-    J.store(qj);
-    K.store(qk);
+    m_Value = MultiplyByVector(m_Value, vector);
 }
 
 Quaternion Quaternion::operator*(float scalar) const
 {
-    return Quaternion(
-        R.load(std::memory_order_relaxed) * scalar,
-        I.load(std::memory_order_relaxed) * scalar,
-        J.load(std::memory_order_relaxed) * scalar,
-        K.load(std::memory_order_relaxed) * scalar
-    );
+    return Quaternion(DirectX::XMVectorScale(m_Value, scalar));
 }
 
 
 Quaternion& Quaternion::operator+=(const Quaternion& q)
 {
-    R.store(R.load(std::memory_order_relaxed) + q.R.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    I.store(I.load(std::memory_order_relaxed) + q.I.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    J.store(J.load(std::memory_order_relaxed) + q.J.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    K.store(K.load(std::memory_order_relaxed) + q.K.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_Value = DirectX::XMVectorAdd(m_Value, q.m_Value);
     return *this;
 }
 
-Quaternion& Quaternion::operator=(const Quaternion& other)
+DirectX::XMMATRIX Quaternion::ToRotationMatrix() const
 {
-    if (this == &other) return *this;
+    using namespace DirectX;
+    return XMMatrixRotationQuaternion(m_Value);
+}
 
-    R.store(other.R.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    I.store(other.I.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    J.store(other.J.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    K.store(other.K.load(std::memory_order_relaxed), std::memory_order_relaxed);
+void Quaternion::NormalizeBatch(Quaternion* orientations, size_t count)
+{
+    for (size_t first = 0; first < count; first += 4)
+    {
+        const size_t lanes = (std::min)(count - first, static_cast<size_t>(4));
+        StoreLanes(NormalizedLanes(LoadLanes(orientations + first, lanes)), orientations + first, lanes);
+    }
+}
 
-    return *this;
+void Quaternion::IntegrateBatch(Quaternion* orientations, const DirectX::XMVECTOR* angularVelocities,
+    size_t count, float dt)
+{
+    using namespace DirectX;
+
+    const XMVECTOR halfDt = XMVectorReplicate(0.5f * dt);
+    for (size_t first = 0; first < count; first += 4)
+    {
+        const size_t lanes = (std::min)(count - first, static_cast<size_t>(4));
+        XMMATRIX q = LoadLanes(orientations + first, lanes);
+
+        XMVECTOR w[4]{ XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero() };
+        for (size_t n = 0; n < lanes; ++n) w[n] = angularVelocities[first + n];
+        const XMMATRIX velocity = XMMatrixTranspose(XMMATRIX(w[0], w[1], w[2], w[3]));
+        const XMVECTOR wx = velocity.r[0], wy = velocity.r[1], wz = velocity.r[2];
+        const XMVECTOR qx = q.r[0], qy = q.r[1], qz = q.r[2], qw = q.r[3];
+
+        //~ q += q * (0, w) * dt / 2, as in MultiplyByVector
+        const XMVECTOR dx = XMVectorSubtract(XMVectorMultiplyAdd(qw, wx, XMVectorMultiply(qy, wz)), XMVectorMultiply(qz, wy));
+        const XMVECTOR dy = XMVectorSubtract(XMVectorMultiplyAdd(qw, wy, XMVectorMultiply(qz, wx)), XMVectorMultiply(qx, wz));
+        const XMVECTOR dz = XMVectorSubtract(XMVectorMultiplyAdd(qw, wz, XMVectorMultiply(qx, wy)), XMVectorMultiply(qy, wx));
+        const XMVECTOR dw = XMVectorNegate(XMVectorMultiplyAdd(qx, wx, XMVectorMultiplyAdd(qy, wy, XMVectorMultiply(qz, wz))));
+        q.r[0] = XMVectorMultiplyAdd(dx, halfDt, qx);
+        q.r[1] = XMVectorMultiplyAdd(dy, halfDt, qy);
+        q.r[2] = XMVectorMultiplyAdd(dz, halfDt, qz);
+        q.r[3] = XMVectorMultiplyAdd(dw, halfDt, qw);
+
+        StoreLanes(NormalizedLanes(q), orientations + first, lanes);
+    }
 }
 
-Quaternion::Quaternion(const Quaternion& other)
+void Quaternion::ToRotationMatrixBatch(const Quaternion* orientations, DirectX::XMMATRIX* outMatrices, size_t count)
 {
-    R.store(other.R.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    I.store(other.I.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    J.store(other.J.load(std::memory_order_relaxed), std::memory_order_relaxed);
-    K.store(other.K.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    using namespace DirectX;
+
+    const XMVECTOR one = XMVectorSplatOne();
+    const XMVECTOR two = XMVectorReplicate(2.0f);
+    for (size_t first = 0; first < count; first += 4)
+    {
+        const size_t lanes = (std::min)(count - first, static_cast<size_t>(4));
+        const XMMATRIX q = LoadLanes(orientations + first, lanes);
+        const XMVECTOR x = q.r[0], y = q.r[1], z = q.r[2], w = q.r[3];
+
+        const XMVECTOR xx = XMVectorMultiply(x, x), yy = XMVectorMultiply(y, y), zz = XMVectorMultiply(z, z);
+        const XMVECTOR xy = XMVectorMultiply(x, y), xz = XMVectorMultiply(x, z), yz = XMVectorMultiply(y, z);
+        const XMVECTOR xw = XMVectorMultiply(x, w), yw = XMVectorMultiply(y, w), zw = XMVectorMultiply(z, w);
+
+        //~ Element (row, column) of the four matrices, laid out as XMMatrixRotationQuaternion
+        const XMMATRIX row0 = XMMatrixTranspose(XMMATRIX(
+            XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one),
+            XMVectorMultiply(two, XMVectorAdd(xy, zw)),
+            XMVectorMultiply(two, XMVectorSubtract(xz, yw)),
+            XMVectorZero()));
+        const XMMATRIX row1 = XMMatrixTranspose(XMMATRIX(
+            XMVectorMultiply(two, XMVectorSubtract(xy, zw)),
+            XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, zz), one),
+            XMVectorMultiply(two, XMVectorAdd(yz, xw)),
+            XMVectorZero()));
+        const XMMATRIX row2 = XMMatrixTranspose(XMMATRIX(
+            XMVectorMultiply(two, XMVectorAdd(xz, yw)),
+            XMVectorMultiply(two, XMVectorSubtract(yz, xw)),
+            XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, yy), one),
+            XMVectorZero()));
+
+        for (size_t n = 0; n < lanes; ++n)
+        {
+            outMatrices[first + n] = XMMATRIX(row0.r[n], row1.r[n], row2.r[n], g_XMIdentityR3);
+        }
+    }
 }
 
-DirectX::XMMATRIX Quaternion::ToRotationMatrix() const
+DirectX::XMMATRIX Quaternion::LoadLanes(const Quaternion* orientations, size_t count)
 {
     using namespace DirectX;
-    return XMMatrixRotationQuaternion(ToXmVector());
+
+    XMVECTOR q[4]{ XMQuaternionIdentity(), XMQuaternionIdentity(), XMQuaternionIdentity(), XMQuaternionIdentity() };
+    for (size_t n = 0; n < count; ++n) q[n] = orientations[n].m_Value;
+    return XMMatrixTranspose(XMMATRIX(q[0], q[1], q[2], q[3]));
+}
+
+void Quaternion::StoreLanes(const DirectX::XMMATRIX& lanes, Quaternion* orientations, size_t count)
+{
+    const DirectX::XMMATRIX q = DirectX::XMMatrixTranspose(lanes);
+    for (size_t n = 0; n < count; ++n) orientations[n].m_Value = q.r[n];
+}
+
+DirectX::XMMATRIX Quaternion::NormalizedLanes(const DirectX::XMMATRIX& lanes)
+{
+    using namespace DirectX;
+
+    const XMVECTOR lengthSq = XMVectorMultiplyAdd(lanes.r[0], lanes.r[0], XMVectorMultiplyAdd(lanes.r[1], lanes.r[1],
+        XMVectorMultiplyAdd(lanes.r[2], lanes.r[2], XMVectorMultiply(lanes.r[3], lanes.r[3]))));
+    const XMVECTOR invLength = XMVectorReciprocalSqrt(lengthSq);
+
+    //~ A zero quaternion becomes the identity, as in Normalized
+    const XMVECTOR degenerate = XMVectorEqual(lengthSq, XMVectorZero());
+    return XMMATRIX(
+        XMVectorSelect(XMVectorMultiply(lanes.r[0], invLength), XMVectorZero(), degenerate),
+        XMVectorSelect(XMVectorMultiply(lanes.r[1], invLength), XMVectorZero(), degenerate),
+        XMVectorSelect(XMVectorMultiply(lanes.r[2], invLength), XMVectorZero(), degenerate),
+        XMVectorSelect(XMVectorMultiply(lanes.r[3], invLength), XMVectorSplatOne(), degenerate));
+}
+
+DirectX::XMVECTOR Quaternion::MultiplyByVector(const DirectX::XMVECTOR& q, const DirectX::XMVECTOR& vector)
+{
+    using namespace DirectX;
+    return XMQuaternionMultiply(XMVectorSetW(vector, 0.0f), q);
+}
+
+DirectX::XMVECTOR Quaternion::Normalized(const DirectX::XMVECTOR& q)
+{
+    using namespace DirectX;
+
+    const XMVECTOR lengthSq = XMVector4LengthSq(q);
+    if (XMVectorGetX(lengthSq) == 0.0f) return XMQuaternionIdentity();
+    return XMVectorMultiply(q, XMVectorReciprocalSqrt(lengthSq));
 }
 
 Quaternion operator*(float scalar, const Quaternion& q)
@@ -1,34 +1,59 @@
 #pragma once
 #include "DirectXMath.h"
-#include <atomic>
+#include <cstddef>
 
-class Quaternion
+// Rotation quaternion R + Ii + Jj + Kk, held in one XMVECTOR laid out (I, J, K, R) so it
+// goes straight into DirectXMath. Plain data: a copy is one 16 byte move. Orientations are
+// written by the physics step and only read by others through the published snapshot, so
+// nothing here needs to be atomic.
+class alignas(16) Quaternion
 {
 public:
     Quaternion();
     Quaternion(float r, float i, float j, float k);
+    explicit Quaternion(const DirectX::XMVECTOR& value);   //~ (I, J, K, R)
 
     Quaternion operator*(const Quaternion& q) const;
     Quaternion operator*(float scalar) const;
     Quaternion& operator+=(const Quaternion& q);
-    Quaternion& operator=(const Quaternion& other);
-    Quaternion(const Quaternion& other);
 
     DirectX::XMMATRIX ToRotationMatrix() const;
 
     void AddScaledVector(const DirectX::XMVECTOR& vector, float scale);
     void RotateByVector(const DirectX::XMVECTOR& vector);
     void Normalize();
-    DirectX::XMVECTOR ToXmVector() const;
+    DirectX::XMVECTOR ToXmVector() const { return m_Value; }
     DirectX::XMVECTOR RotateVector(const DirectX::XMVECTOR& v) const;
 
     friend Quaternion operator*(float scalar, const Quaternion& q);
 
-    float GetR() const { return R.load(std::memory_order_relaxed); }
-    float GetI() const { return I.load(std::memory_order_relaxed); }
-    float GetJ() const { return J.load(std::memory_order_relaxed); }
-    float GetK() const { return K.load(std::memory_order_relaxed); }
+    float GetR() const { return DirectX::XMVectorGetW(m_Value); }
+    float GetI() const { return DirectX::XMVectorGetX(m_Value); }
+    float GetJ() const { return DirectX::XMVectorGetY(m_Value); }
+    float GetK() const { return DirectX::XMVectorGetZ(m_Value); }
+
+    //~ Batched versions for the integrator, four quaternions at a time with one per XMVECTOR lane.
+    //~ Normalize each of 'count' orientations
+    static void NormalizeBatch(Quaternion* orientations, size_t count);
+
+    //~ AddScaledVector(angularVelocities[n], dt) then Normalize, for each of 'count' orientations
+    static void IntegrateBatch(Quaternion* orientations, const DirectX::XMVECTOR* angularVelocities,
+        size_t count, float dt);
+
+    //~ ToRotationMatrix for each of 'count' orientations
+    static void ToRotationMatrixBatch(const Quaternion* orientations, DirectX::XMMATRIX* outMatrices, size_t count);
+
+private:
+    //~ Up to four quaternions transposed into lanes: r[0] = I of each, r[1] = J, r[2] = K, r[3] = R.
+    //~ Missing ones are padded with the identity and not stored back.
+    static DirectX::XMMATRIX LoadLanes(const Quaternion* orientations, size_t count);
+    static void StoreLanes(const DirectX::XMMATRIX& lanes, Quaternion* orientations, size_t count);
+    static DirectX::XMMATRIX NormalizedLanes(const DirectX::XMMATRIX& lanes);
+
+    //~ q * (0, vector) in Hamilton order, the rate of change of q for angular velocity 'vector'
+    static DirectX::XMVECTOR MultiplyByVector(const DirectX::XMVECTOR& q, const DirectX::XMVECTOR& vector);
+    static DirectX::XMVECTOR Normalized(const DirectX::XMVECTOR& q);
 
 private:
-    std::atomic<float> R, I, J, K;
+    DirectX::XMVECTOR m_Value;
 };
@@ -0,0 +1,599 @@
+#include "pch.h"
+#include "QueryWorld.h"
+#include "Collision/Capsule/CapsuleCollider.h"
+#include "Collision/Cube/CubeCollider.h"
+#include "Collision/Plane/PlaneCollider.h"
+#include "Collision/Sphere/SphereCollider.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+namespace
+{
+    using namespace DirectX;
+
+    constexpr float Epsilon = 1e-6f;
+
+    float Dot(const XMVECTOR& a, const XMVECTOR& b)
+    {
+        return XMVectorGetX(XMVector3Dot(a, b));
+    }
+
+    //~ First t >= 0 where the unit ray meets the sphere, false when it misses or starts inside
+    bool RaySphere(const XMVECTOR& origin, const XMVECTOR& direction, const XMVECTOR& center, float radius, float& outT)
+    {
+        const XMVECTOR m = XMVectorSubtract(origin, center);
+        const float b = Dot(m, direction);
+        const float c = Dot(m, m) - radius * radius;
+        if (c <= 0.0f || b > 0.0f) return false;
+
+        const float discriminant = b * b - c;
+        if (discriminant < 0.0f) return false;
+
+        outT = -b - std::sqrt(discriminant);
+        return outT >= 0.0f;
+    }
+
+    //~ Same for the capsule around segment [a, b]; the body is the cylinder between the caps
+    bool RayCapsule(const XMVECTOR& origin, const XMVECTOR& direction, const XMVECTOR& a, const XMVECTOR& b,
+        float radius, float& outT, XMVECTOR& outNormal)
+    {
+        const XMVECTOR startClosest = CapsuleCollider::ClosestPointOnSegment(origin, a, b);
+        if (XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(origin, startClosest))) <= radius * radius) return false;
+
+        float best = FLT_MAX;
+
+        const XMVECTOR ba = XMVectorSubtract(b, a);
+        const XMVECTOR oa = XMVectorSubtract(origin, a);
+        const float baba = Dot(ba, ba);
+        const float bard = Dot(ba, direction);
+        const float baoa = Dot(ba, oa);
+        const float qa = baba - bard * bard;
+        if (qa > Epsilon * baba)
+        {
+            const float qb = baba * Dot(direction, oa) - baoa * bard;
+            const float qc = baba * Dot(oa, oa) - baoa * baoa - radius * radius * baba;
+            const float h = qb * qb - qa * qc;
+            if (h >= 0.0f)
+            {
+                const float t = (-qb - std::sqrt(h)) / qa;
+                const float y = baoa + t * bard;
+                if (t >= 0.0f && y > 0.0f && y < baba) best = t;
+            }
+        }
+
+        for (const XMVECTOR& cap : { a, b })
+        {
+            float t;
+            if (RaySphere(origin, direction, cap, radius, t) && t < best) best = t;
+        }
+        if (best == FLT_MAX) return false;
+
+        const XMVECTOR point = XMVectorMultiplyAdd(direction, XMVectorReplicate(best), origin);
+        outNormal = XMVector3Normalize(XMVectorSubtract(point, CapsuleCollider::ClosestPointOnSegment(point, a, b)));
+        outT = best;
+        return true;
+    }
+
+    enum class SlabResult : uint8_t
+    {
+        Miss,
+        Hit,
+        Inside,
+    };
+
+    //~ Ray against the local box [-extents, extents], with the face it enters through
+    SlabResult RaySlab(const float origin[3], const float direction[3], const float extents[3],
+        float& outT, int& outAxis, float& outSign)
+    {
+        float tMin = -FLT_MAX;
+        float tMax = FLT_MAX;
+        outAxis = -1;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (fabsf(direction[i]) < Epsilon)
+            {
+                if (fabsf(origin[i]) > extents[i]) return SlabResult::Miss;
+                continue;
+            }
+
+            const float inverse = 1.0f / direction[i];
+            float t1 = (-extents[i] - origin[i]) * inverse;
+            float t2 = (extents[i] - origin[i]) * inverse;
+            if (t1 > t2) std::swap(t1, t2);
+
+            if (t1 > tMin)
+            {
+                tMin = t1;
+                outAxis = i;
+                outSign = direction[i] > 0.0f ? -1.0f : 1.0f;
+            }
+            tMax = (std::min)(tMax, t2);
+            if (tMin > tMax || tMax < 0.0f) return SlabResult::Miss;
+        }
+
+        if (outAxis < 0 || tMin < 0.0f) return SlabResult::Inside;
+        outT = tMin;
+        return SlabResult::Hit;
+    }
+
+    //~ Entry distance of the ray into 'bounds' within [0, maxT]
+    bool RayEntersBounds(const AABB& bounds, const float origin[3], const float inverseDirection[3], float maxT, float& outT)
+    {
+        float tMin = 0.0f;
+        float tMax = maxT;
+        for (int i = 0; i < 3; ++i)
+        {
+            float t1 = (bounds.GetMin(i) - origin[i]) * inverseDirection[i];
+            float t2 = (bounds.GetMax(i) - origin[i]) * inverseDirection[i];
+            if (t1 > t2) std::swap(t1, t2);
+            tMin = (std::max)(tMin, t1);
+            tMax = (std::min)(tMax, t2);
+            if (tMin > tMax) return false;
+        }
+        outT = tMin;
+        return true;
+    }
+
+    CubeCollider::BoxFrame MakeBoxFrame(const XMFLOAT3& center, const XMFLOAT3 axes[3], const XMFLOAT3& halfExtents)
+    {
+        CubeCollider::BoxFrame box{};
+        box.Center = XMLoadFloat3(&center);
+        for (int i = 0; i < 3; ++i) box.Axes[i] = XMLoadFloat3(&axes[i]);
+        box.HalfExtents[0] = halfExtents.x;
+        box.HalfExtents[1] = halfExtents.y;
+        box.HalfExtents[2] = halfExtents.z;
+        return box;
+    }
+}
+
+std::shared_ptr<const QueryWorld> QueryWorld::Build(const std::vector<ICollider*>& colliders)
+{
+    using namespace DirectX;
+
+    auto world = std::make_shared<QueryWorld>();
+    world->m_Shapes.reserve(colliders.size());
+
+    for (ICollider* collider : colliders)
+    {
+        if (!collider || collider->GetColliderState() == ColliderState::Trigger) continue;
+
+        Shape shape{};
+        shape.Collider = collider;
+        shape.Type = collider->GetColliderType();
+        shape.LayerMask = collider->GetLayerMask();
+        shape.Bounds = collider->GetWorldAABB();
+
+        switch (shape.Type)
+        {
+        case ColliderType::Cube:
+        {
+            const CubeCollider::BoxFrame box = static_cast<const CubeCollider*>(collider)->GetBoxFrame();
+            XMStoreFloat3(&shape.Center, box.Center);
+            for (int i = 0; i < 3; ++i) XMStoreFloat3(&shape.Axes[i], box.Axes[i]);
+            shape.HalfExtents = { box.HalfExtents[0], box.HalfExtents[1], box.HalfExtents[2] };
+            break;
+        }
+        case ColliderType::Sphere:
+        {
+            const SphereCollider* sphere = static_cast<const SphereCollider*>(collider);
+            XMStoreFloat3(&shape.Center, sphere->GetCenter());
+            shape.Radius = sphere->GetRadius();
+            break;
+        }
+        case ColliderType::Capsule:
+        {
+            const CapsuleCollider* capsule = static_cast<const CapsuleCollider*>(collider);
+            XMVECTOR start, end;
+            capsule->GetSegment(start, end);
+            XMStoreFloat3(&shape.Center, start);
+            XMStoreFloat3(&shape.End, end);
+            shape.Radius = capsule->GetRadius();
+            break;
+        }
+        case ColliderType::Plane:
+        {
+            const PlaneCollider* plane = static_cast<const PlaneCollider*>(collider);
+            XMStoreFloat3(&shape.Center, plane->GetPoint());
+            XMStoreFloat3(&shape.Axes[1], plane->GetNormal());
+            world->m_Unbounded.push_back(static_cast<uint32_t>(world->m_Shapes.size()));
+            break;
+        }
+        default:
+            continue;
+        }
+        world->m_Shapes.push_back(shape);
+    }
+    return world;
+}
+
+bool QueryWorld::Raycast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+    RaycastHit& outHit, uint32_t layerMask) const
+{
+    return SphereCast(origin, 0.0f, direction, maxDistance, outHit, layerMask);
+}
+
+size_t QueryWorld::RaycastAll(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+    std::vector<RaycastHit>& outHits, uint32_t layerMask) const
+{
+    using namespace DirectX;
+
+    outHits.clear();
+    if (XMVectorGetX(XMVector3LengthSq(direction)) < Epsilon) return 0;
+    const XMVECTOR unitDirection = XMVector3Normalize(direction);
+
+    auto test = [&](uint32_t index, float limit)
+    {
+        const Shape& shape = m_Shapes[index];
+        RaycastHit hit;
+        if (IsSelected(shape, layerMask) && CastShape(shape, origin, unitDirection, 0.0f, limit, hit)) outHits.push_back(hit);
+        return limit;
+    };
+
+    for (const uint32_t index : m_Unbounded) test(index, maxDistance);
+    TraverseRay(origin, unitDirection, maxDistance, 0.0f, test);
+
+    std::sort(outHits.begin(), outHits.end(), [](const RaycastHit& a, const RaycastHit& b) { return a.Distance < b.Distance; });
+    return outHits.size();
+}
+
+bool QueryWorld::SphereCast(const DirectX::XMVECTOR& origin, float radius, const DirectX::XMVECTOR& direction,
+    float maxDistance, RaycastHit& outHit, uint32_t layerMask) const
+{
+    using namespace DirectX;
+
+    if (XMVectorGetX(XMVector3LengthSq(direction)) < Epsilon) return false;
+    const XMVECTOR unitDirection = XMVector3Normalize(direction);
+    radius = (std::max)(radius, 0.0f);
+
+    bool found = false;
+    auto test = [&](uint32_t index, float limit)
+    {
+        const Shape& shape = m_Shapes[index];
+        RaycastHit hit;
+        if (!IsSelected(shape, layerMask) || !CastShape(shape, origin, unitDirection, radius, limit, hit)) return limit;
+
+        outHit = hit;
+        found = true;
+        return hit.Distance;
+    };
+
+    float cutoff = maxDistance;
+    for (const uint32_t index : m_Unbounded) cutoff = test(index, cutoff);
+    TraverseRay(origin, unitDirection, cutoff, radius, test);
+    return found;
+}
+
+size_t QueryWorld::OverlapBox(const DirectX::XMVECTOR& center, const DirectX::XMVECTOR& halfExtents,
+    const DirectX::XMVECTOR& orientation, std::vector<ICollider*>& outColliders, uint32_t layerMask) const
+{
+    using namespace DirectX;
+
+    outColliders.clear();
+
+    XMMATRIX world = XMMatrixRotationQuaternion(XMQuaternionNormalize(orientation));
+    XMFLOAT3 extents;
+    XMStoreFloat3(&extents, XMVectorAbs(halfExtents));
+
+    CubeCollider::BoxFrame box{};
+    box.Center = center;
+    for (int i = 0; i < 3; ++i) box.Axes[i] = world.r[i];
+    box.HalfExtents[0] = extents.x;
+    box.HalfExtents[1] = extents.y;
+    box.HalfExtents[2] = extents.z;
+
+    world.r[3] = XMVectorSetW(center, 1.0f);
+    const AABB bounds = AABB::FromTransform(world, XMVectorAbs(halfExtents));
+
+    auto overlaps = [&](const Shape& shape)
+    {
+        switch (shape.Type)
+        {
+        case ColliderType::Cube:
+            return CubeCollider::OverlapOBBs(box, MakeBoxFrame(shape.Center, shape.Axes, shape.HalfExtents));
+        case ColliderType::Sphere:
+        {
+            const XMVECTOR sphereCenter = XMLoadFloat3(&shape.Center);
+            const XMVECTOR offset = XMVectorSubtract(CubeCollider::ClosestPointOnBox(box, sphereCenter), sphereCenter);
+            return XMVectorGetX(XMVector3LengthSq(offset)) <= shape.Radius * shape.Radius;
+        }
+        case ColliderType::Capsule:
+        {
+            //~ Alternate projections between the box and the segment, as the cube vs capsule contact does
+            const XMVECTOR start = XMLoadFloat3(&shape.Center);
+            const XMVECTOR end = XMLoadFloat3(&shape.End);
+            XMVECTOR closest = XMVectorScale(XMVectorAdd(start, end), 0.5f);
+            for (int i = 0; i < 4; ++i)
+            {
+                closest = CapsuleCollider::ClosestPointOnSegment(CubeCollider::ClosestPointOnBox(box, closest), start, end);
+            }
+            const XMVECTOR offset = XMVectorSubtract(CubeCollider::ClosestPointOnBox(box, closest), closest);
+            return XMVectorGetX(XMVector3LengthSq(offset)) <= shape.Radius * shape.Radius;
+        }
+        case ColliderType::Plane:
+        {
+            const XMVECTOR normal = XMLoadFloat3(&shape.Axes[1]);
+            const float lowest = -CubeCollider::GetSupport(box, XMVectorNegate(normal));
+            return lowest <= Dot(XMLoadFloat3(&shape.Center), normal);
+        }
+        default:
+            return false;
+        }
+    };
+
+    auto test = [&](uint32_t index)
+    {
+        const Shape& shape = m_Shapes[index];
+        if (IsSelected(shape, layerMask) && overlaps(shape)) outColliders.push_back(shape.Collider);
+    };
+
+    for (const uint32_t index : m_Unbounded) test(index);
+
+    std::call_once(m_HierarchyBuilt, [this]() { BuildHierarchy(); });
+    if (m_Nodes.empty()) return outColliders.size();
+
+    uint32_t stack[64];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const Node& node = m_Nodes[stack[--stackSize]];
+        if (!node.Bounds.Overlaps(bounds)) continue;
+
+        if (node.Count > 0)
+        {
+            for (uint32_t i = 0; i < node.Count; ++i)
+            {
+                const uint32_t index = m_Order[node.First + i];
+                if (m_Shapes[index].Bounds.Overlaps(bounds)) test(index);
+            }
+            continue;
+        }
+        stack[stackSize++] = static_cast<uint32_t>(&node - m_Nodes.data()) + 1;
+        stack[stackSize++] = node.First;
+    }
+    return outColliders.size();
+}
+
+void QueryWorld::BuildHierarchy() const
+{
+    m_Order.clear();
+    for (uint32_t i = 0; i < m_Shapes.size(); ++i)
+    {
+        if (m_Shapes[i].Type != ColliderType::Plane) m_Order.push_back(i);
+    }
+
+    m_Nodes.clear();
+    m_Nodes.reserve(2 * (m_Order.size() / MaxLeafShapes + 1));
+    if (!m_Order.empty()) BuildNode(0, static_cast<uint32_t>(m_Order.size()));
+}
+
+// Top down, splitting at the median centre along the widest axis of the centres. The shapes
+// do not move once copied, so a balanced tree beats the incremental one the broadphase keeps.
+uint32_t QueryWorld::BuildNode(uint32_t first, uint32_t count) const
+{
+    const uint32_t index = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.push_back({});
+
+    AABB bounds = m_Shapes[m_Order[first]].Bounds;
+    AABB centers{};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const AABB& shapeBounds = m_Shapes[m_Order[first + i]].Bounds;
+        bounds = AABB::Union(bounds, shapeBounds);
+
+        const DirectX::XMFLOAT3 center{ shapeBounds.GetCenter(0), shapeBounds.GetCenter(1), shapeBounds.GetCenter(2) };
+        if (i == 0) centers = { center, center };
+        else centers = AABB::Union(centers, { center, center });
+    }
+
+    if (count <= MaxLeafShapes)
+    {
+        m_Nodes[index] = { bounds, first, count };
+        return index;
+    }
+
+    int axis = 0;
+    for (int i = 1; i < 3; ++i)
+    {
+        if (centers.GetMax(i) - centers.GetMin(i) > centers.GetMax(axis) - centers.GetMin(axis)) axis = i;
+    }
+
+    const uint32_t half = count / 2;
+    const auto begin = m_Order.begin() + first;
+    std::nth_element(begin, begin + half, begin + count, [this, axis](uint32_t a, uint32_t b)
+    {
+        return m_Shapes[a].Bounds.GetCenter(axis) < m_Shapes[b].Bounds.GetCenter(axis);
+    });
+
+    BuildNode(first, half);     //~ lands at index + 1
+    const uint32_t right = BuildNode(first + half, count - half);
+    m_Nodes[index] = { bounds, right, 0 };
+    return index;
+}
+
+template <typename Fn>
+void QueryWorld::TraverseRay(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction,
+    float maxDistance, float expand, Fn&& fn) const
+{
+    using namespace DirectX;
+
+    std::call_once(m_HierarchyBuilt, [this]() { BuildHierarchy(); });
+    if (m_Nodes.empty()) return;
+
+    XMFLOAT3 o, d;
+    XMStoreFloat3(&o, origin);
+    XMStoreFloat3(&d, direction);
+    const float rayOrigin[3] = { o.x, o.y, o.z };
+    const float inverseDirection[3] = { 1.0f / d.x, 1.0f / d.y, 1.0f / d.z };
+
+    float cutoff = maxDistance;
+    uint32_t stack[64];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const uint32_t nodeIndex = stack[--stackSize];
+        const Node& node = m_Nodes[nodeIndex];
+
+        float entry;
+        if (!RayEntersBounds(node.Bounds.Fattened(expand), rayOrigin, inverseDirection, cutoff, entry)) continue;
+
+        if (node.Count > 0)
+        {
+            for (uint32_t i = 0; i < node.Count; ++i) cutoff = fn(m_Order[node.First + i], cutoff);
+            continue;
+        }
+
+        //~ Nearer child on top of the stack, so closest hit queries shrink the cut off early
+        const uint32_t left = nodeIndex + 1;
+        const uint32_t right = node.First;
+        float leftEntry = FLT_MAX, rightEntry = FLT_MAX;
+        RayEntersBounds(m_Nodes[left].Bounds.Fattened(expand), rayOrigin, inverseDirection, cutoff, leftEntry);
+        RayEntersBounds(m_Nodes[right].Bounds.Fattened(expand), rayOrigin, inverseDirection, cutoff, rightEntry);
+        if (leftEntry <= rightEntry)
+        {
+            stack[stackSize++] = right;
+            stack[stackSize++] = left;
+        }
+        else
+        {
+            stack[stackSize++] = left;
+            stack[stackSize++] = right;
+        }
+    }
+}
+
+// Sphere casts are ray casts against the shape grown by the radius: a larger sphere, a fatter
+// capsule, a plane pushed out. A box grows into a rounded box, whose faces are the box pushed
+// out and whose edges and corners are capsules around the box edges (Ericson 5.5.7).
+bool QueryWorld::CastShape(const Shape& shape, const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction,
+    float radius, float maxDistance, RaycastHit& outHit) const
+{
+    using namespace DirectX;
+
+    float t = 0.0f;
+    XMVECTOR normal = XMVectorZero();
+
+    switch (shape.Type)
+    {
+    case ColliderType::Sphere:
+    {
+        const XMVECTOR center = XMLoadFloat3(&shape.Center);
+        if (!RaySphere(origin, direction, center, shape.Radius + radius, t)) return false;
+        normal = XMVector3Normalize(XMVectorSubtract(XMVectorMultiplyAdd(direction, XMVectorReplicate(t), origin), center));
+        break;
+    }
+    case ColliderType::Capsule:
+        if (!RayCapsule(origin, direction, XMLoadFloat3(&shape.Center), XMLoadFloat3(&shape.End),
+            shape.Radius + radius, t, normal)) return false;
+        break;
+    case ColliderType::Plane:
+    {
+        normal = XMLoadFloat3(&shape.Axes[1]);
+        const float distance = Dot(XMVectorSubtract(origin, XMLoadFloat3(&shape.Center)), normal) - radius;
+        const float approach = -Dot(direction, normal);
+        if (distance < 0.0f || approach <= Epsilon) return false;
+        t = distance / approach;
+        break;
+    }
+    case ColliderType::Cube:
+    {
+        //~ Into the box frame
+        const XMVECTOR center = XMLoadFloat3(&shape.Center);
+        const XMVECTOR offset = XMVectorSubtract(origin, center);
+        XMVECTOR axes[3];
+        float localOrigin[3], localDirection[3], extents[3], grown[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            axes[i] = XMLoadFloat3(&shape.Axes[i]);
+            localOrigin[i] = Dot(offset, axes[i]);
+            localDirection[i] = Dot(direction, axes[i]);
+        }
+        extents[0] = shape.HalfExtents.x;
+        extents[1] = shape.HalfExtents.y;
+        extents[2] = shape.HalfExtents.z;
+        for (int i = 0; i < 3; ++i) grown[i] = extents[i] + radius;
+
+        int axis;
+        float sign = 1.0f;
+        const SlabResult slab = RaySlab(localOrigin, localDirection, grown, t, axis, sign);
+        if (slab == SlabResult::Miss) return false;
+
+        //~ Where on the grown box the ray arrives (or starts), outside the box on which axes
+        float local[3];
+        uint32_t outside = 0;
+        uint32_t outsideCount = 0;
+        const float entry = slab == SlabResult::Hit ? t : 0.0f;
+        for (int i = 0; i < 3; ++i)
+        {
+            local[i] = localOrigin[i] + entry * localDirection[i];
+            if (fabsf(local[i]) > extents[i])
+            {
+                outside |= 1u << i;
+                ++outsideCount;
+            }
+        }
+
+        XMVECTOR localNormal = XMVectorZero();
+        if (slab == SlabResult::Hit && outsideCount <= 1)
+        {
+            //~ Face region of the rounded box
+            float n[3] = { 0.0f, 0.0f, 0.0f };
+            n[axis] = sign;
+            localNormal = XMVectorSet(n[0], n[1], n[2], 0.0f);
+        }
+        else
+        {
+            //~ Edge or corner region (or a start inside the grown box near one): the edges
+            //~ whose two other coordinates are both outside, as capsules of 'radius'
+            if (slab == SlabResult::Inside && outsideCount <= 1) return false;  //~ starts overlapping
+
+            const XMVECTOR rayOrigin = XMVectorSet(localOrigin[0], localOrigin[1], localOrigin[2], 0.0f);
+            const XMVECTOR rayDirection = XMVectorSet(localDirection[0], localDirection[1], localDirection[2], 0.0f);
+            float best = FLT_MAX;
+            for (int k = 0; k < 3; ++k)
+            {
+                const int i = (k + 1) % 3, j = (k + 2) % 3;
+                if (!(outside & (1u << i)) || !(outside & (1u << j))) continue;
+
+                float a[3], b[3];
+                a[i] = b[i] = local[i] > 0.0f ? extents[i] : -extents[i];
+                a[j] = b[j] = local[j] > 0.0f ? extents[j] : -extents[j];
+                a[k] = -extents[k];
+                b[k] = extents[k];
+
+                float edgeT;
+                XMVECTOR edgeNormal;
+                if (RayCapsule(rayOrigin, rayDirection, XMVectorSet(a[0], a[1], a[2], 0.0f), XMVectorSet(b[0], b[1], b[2], 0.0f),
+                    radius, edgeT, edgeNormal) && edgeT < best)
+                {
+                    best = edgeT;
+                    localNormal = edgeNormal;
+                }
+            }
+            if (best == FLT_MAX) return false;
+            t = best;
+        }
+
+        normal = XMVectorScale(axes[0], XMVectorGetX(localNormal));
+        normal = XMVectorMultiplyAdd(axes[1], XMVectorSplatY(localNormal), normal);
+        normal = XMVectorMultiplyAdd(axes[2], XMVectorSplatZ(localNormal), normal);
+        break;
+    }
+    default:
+        return false;
+    }
+
+    if (t > maxDistance) return false;
+
+    //~ The centre of the cast sphere at impact, less its radius along the normal is the surface
+    const XMVECTOR castCenter = XMVectorMultiplyAdd(direction, XMVectorReplicate(t), origin);
+    outHit.Collider = shape.Collider;
+    outHit.Distance = t;
+    XMStoreFloat3(&outHit.Normal, normal);
+    XMStoreFloat3(&outHit.Point, XMVectorSubtract(castCenter, XMVectorScale(normal, radius)));
+    return true;
+}
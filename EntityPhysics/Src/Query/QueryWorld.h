@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "Broadphase/AABB.h"
+#include "Collision/ICollider.h"
+
+
+struct RaycastHit
+{
+    ICollider* Collider{ nullptr };
+    DirectX::XMFLOAT3 Point{ 0.0f, 0.0f, 0.0f };    //~ on the surface of the collider that was hit
+    DirectX::XMFLOAT3 Normal{ 0.0f, 0.0f, 0.0f };   //~ surface normal there, facing the caster
+    float Distance{ 0.0f };                         //~ along the (unit) cast direction
+};
+
+// Read only copy of every non trigger collider as it was at the end of one step, with a
+// bounding volume hierarchy over it. Once built it never changes, so any number of threads
+// may query it while the next step runs; the PhysicsSystem swaps in a new one per step.
+// The hierarchy is built by the first query that needs it, so a step that nobody queries
+// only pays for copying the shapes.
+// Casts that start inside a collider do not report it. Planes are one sided, like their
+// collisions: everything behind the surface is inside.
+class QueryWorld
+{
+public:
+    static std::shared_ptr<const QueryWorld> Build(const std::vector<ICollider*>& colliders);
+
+    QueryWorld() = default;
+    ~QueryWorld() = default;
+
+    QueryWorld(const QueryWorld&) = delete;
+    QueryWorld(QueryWorld&&) = delete;
+    QueryWorld& operator=(const QueryWorld&) = delete;
+    QueryWorld& operator=(QueryWorld&&) = delete;
+
+    //~ Closest hit along the ray, 'direction' does not need to be normalised
+    bool Raycast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+        RaycastHit& outHit, uint32_t layerMask = ICollider::AllLayers) const;
+
+    //~ Every hit along the ray sorted by distance, returns the count
+    size_t RaycastAll(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+        std::vector<RaycastHit>& outHits, uint32_t layerMask = ICollider::AllLayers) const;
+
+    //~ First collider a sphere of 'radius' touches when moved along the ray
+    bool SphereCast(const DirectX::XMVECTOR& origin, float radius, const DirectX::XMVECTOR& direction,
+        float maxDistance, RaycastHit& outHit, uint32_t layerMask = ICollider::AllLayers) const;
+
+    //~ Every collider overlapping the box, 'orientation' is a quaternion. Returns the count.
+    size_t OverlapBox(const DirectX::XMVECTOR& center, const DirectX::XMVECTOR& halfExtents,
+        const DirectX::XMVECTOR& orientation, std::vector<ICollider*>& outColliders,
+        uint32_t layerMask = ICollider::AllLayers) const;
+
+    size_t GetShapeCount() const { return m_Shapes.size(); }
+
+private:
+    struct Shape
+    {
+        ICollider* Collider;
+        ColliderType Type;
+        uint32_t LayerMask;
+        AABB Bounds;
+        DirectX::XMFLOAT3 Center;       //~ cube, sphere; start of a capsule segment; point on a plane
+        DirectX::XMFLOAT3 End;          //~ end of a capsule segment
+        DirectX::XMFLOAT3 Axes[3];      //~ unit cube axes; Axes[1] is the plane normal
+        DirectX::XMFLOAT3 HalfExtents;  //~ cube
+        float Radius;                   //~ sphere, capsule
+    };
+
+    struct Node
+    {
+        AABB Bounds;
+        uint32_t First;     //~ first entry in m_Order (leaf) or right child index (inner)
+        uint32_t Count;     //~ 0 for inner nodes, whose left child is the next node
+    };
+
+    static constexpr uint32_t MaxLeafShapes = 4;
+
+    void BuildHierarchy() const;
+    uint32_t BuildNode(uint32_t first, uint32_t count) const;
+
+    //~ Calls fn(shapeIndex) for every shape whose bounds the (expanded) ray reaches before
+    //~ 'maxDistance'; fn returns the new cut off distance, so closest hit queries prune
+    template<typename Fn>
+    void TraverseRay(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction,
+        float maxDistance, float expand, Fn&& fn) const;
+
+    //~ Unit direction sweep of a sphere (radius 0 for a ray) against one shape
+    bool CastShape(const Shape& shape, const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction,
+        float radius, float maxDistance, RaycastHit& outHit) const;
+
+    static bool IsSelected(const Shape& shape, uint32_t layerMask) { return (shape.LayerMask & layerMask) != 0; }
+
+private:
+    std::vector<Shape> m_Shapes{};
+    std::vector<uint32_t> m_Unbounded{};        //~ planes, tested against every query
+
+    mutable std::once_flag m_HierarchyBuilt{};
+    mutable std::vector<uint32_t> m_Order{};    //~ shape indices, leaves own contiguous runs
+    mutable std::vector<Node> m_Nodes{};
+};
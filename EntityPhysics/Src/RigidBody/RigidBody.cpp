@@ -3,80 +3,88 @@
 #include <cmath>
 
 RigidBody::RigidBody()
-    :
-    InverseMass(1.0f),
-    Orientation(1, 0, 0, 0)
+    : m_Pool(RigidBodyPool::Get()), m_Slot(m_Pool->Allocate())
 {
-    m_InverseInertiaTensorLocal = DirectX::XMMatrixIdentity();
     CalculateDerivedData();
 }
 
+RigidBody::~RigidBody()
+{
+    if (m_Slot != RigidBodyPool::InvalidSlot) m_Pool->Release(m_Slot);
+}
+
+RigidBody::RigidBody(const RigidBody& other)
+    : m_Pool(other.m_Pool), m_Slot(m_Pool->Clone(other.m_Slot))
+{}
+
+RigidBody::RigidBody(RigidBody&& other) noexcept
+    : m_Pool(other.m_Pool), m_Slot(other.m_Slot)
+{
+    other.m_Slot = RigidBodyPool::InvalidSlot;
+}
+
+RigidBody& RigidBody::operator=(const RigidBody& other)
+{
+    if (this == &other) return *this;
+    if (m_Slot != RigidBodyPool::InvalidSlot) m_Pool->Release(m_Slot);
+    m_Slot = m_Pool->Clone(other.m_Slot);
+    return *this;
+}
+
+RigidBody& RigidBody::operator=(RigidBody&& other) noexcept
+{
+    if (this == &other) return *this;
+    if (m_Slot != RigidBodyPool::InvalidSlot) m_Pool->Release(m_Slot);
+    m_Slot = other.m_Slot;
+    other.m_Slot = RigidBodyPool::InvalidSlot;
+    return *this;
+}
+
 void RigidBody::AddForce(const DirectX::XMVECTOR& force)
 {
-    DirectX::XMVECTOR current = ForceAccum.Get();
+    DirectX::XMVECTOR current = m_Pool->m_ForceAccum.Get(m_Slot);
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, force);
-    ForceAccum.Set(updated);
+    m_Pool->m_ForceAccum.Set(m_Slot, updated);
+    Wake();
 }
 
 void RigidBody::AddTorque(const DirectX::XMVECTOR& torque)
 {
-    DirectX::XMVECTOR current = TorqueAccum.Get();
+    DirectX::XMVECTOR current = Data().TorqueAccum;
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, torque);
-    TorqueAccum.Set(updated);
+    Data().TorqueAccum = updated;
+    Wake();
 }
 
 void RigidBody::Integrate(float dt, IntegrationType type)
 {
-    switch (type)
-    {
-    case IntegrationType::Euler:
-        IntegrateEuler(dt);
-        break;
-    case IntegrationType::SemiImplicitEuler:
-        IntegrateSemiImplicitEuler(dt);
-        break;
-    case IntegrationType::Verlet:
-        IntegrateVerlet(dt);
-        break;
-    }
+    m_Pool->Integrate(m_Slot, dt, type);
 }
 
 DirectX::XMMATRIX RigidBody::GetTransformMatrix()
 {
     using namespace DirectX;
-    XMMATRIX rotation = Orientation.ToRotationMatrix();
-    XMMATRIX translation = XMMatrixTranslationFromVector(Position.Get());
+    XMMATRIX rotation = Data().Orientation.ToRotationMatrix();
+    XMMATRIX translation = XMMatrixTranslationFromVector(m_Pool->m_Position.Get(m_Slot));
     return rotation * translation;
 }
 
 void RigidBody::CalculateDerivedData()
 {
-    using namespace DirectX;
-
-    Orientation.Normalize(); // Prevent drift
-
-    XMMATRIX rotMatrix = XMMatrixRotationQuaternion(Orientation.ToXmVector());
-    XMMATRIX translation = XMMatrixTranslationFromVector(Position.Get());
-
-    TransformMatrix = rotMatrix * translation; // Full local-to-world matrix
-
-    XMMATRIX rotTranspose = XMMatrixTranspose(rotMatrix);
-    InverseInertiaTensorWorld = XMMatrixMultiply(
-        XMMatrixMultiply(rotMatrix, m_InverseInertiaTensorLocal),
-        rotTranspose
-    );
+    m_Pool->CalculateDerivedData(m_Slot);
 }
+
 void RigidBody::ClearAccumulators()
 {
-    ForceAccum.Set(DirectX::XMVectorZero());
-    TorqueAccum.Set(DirectX::XMVectorZero());
+    m_Pool->m_ForceAccum.Set(m_Slot, DirectX::XMVectorZero());
+    Data().TorqueAccum = DirectX::XMVectorZero();
 }
 
 // Setters
 void RigidBody::SetPosition(const DirectX::XMVECTOR& pos)
 {
-    Position.Set(pos);
-    m_VerletNeedsReset = true;
+    m_Pool->m_Position.Set(m_Slot, pos);
+    m_Pool->m_VerletNeedsReset[m_Slot] = 1;
 }
 
 void RigidBody::SetTranslation(float x, float y, float z)
@@ -104,7 +112,7 @@ void RigidBody::SetTranslation(float x, float y)
 
 void RigidBody::SetTranslationXY(const DirectX::XMFLOAT2& pos)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
 
     // Overwrite X and Y, keep Z and W the same
     DirectX::XMVECTOR updated = DirectX::XMVectorSet(
@@ -114,46 +122,46 @@ void RigidBody::SetTranslationXY(const DirectX::XMFLOAT2& pos)
         DirectX::XMVectorGetW(current)
     );
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::SetTranslationX(float x)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
 
     // Replace X, keep Y, Z, W
     DirectX::XMVECTOR updated = DirectX::XMVectorSetX(current, x);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::SetTranslationY(float y)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
 
     // Replace Y, keep X, Z, W
     DirectX::XMVECTOR updated = DirectX::XMVectorSetY(current, y);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::SetTranslationZ(float z)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
 
     // Replace Z, keep X, Y, W
     DirectX::XMVECTOR updated = DirectX::XMVectorSetZ(current, z);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::AddTranslation(float x, float y, float z)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
     DirectX::XMVECTOR delta = DirectX::XMVectorSet(x, y, z, 0.0f);
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, delta);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::AddTranslation(const DirectX::XMFLOAT3& pos)
@@ -166,21 +174,21 @@ void RigidBody::AddTranslation(const DirectX::XMFLOAT3& pos)
 
 void RigidBody::AddTranslation(const DirectX::XMVECTOR& pos)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
 
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, pos);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::AddTranslation(float x, float y)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
     // Create delta vector: X, Y, Z=0, W=0
     DirectX::XMVECTOR delta = DirectX::XMVectorSet(x, y, 0.0f, 0.0f);
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, delta);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::AddTranslationXY(const DirectX::XMFLOAT2& pos)
@@ -190,44 +198,44 @@ void RigidBody::AddTranslationXY(const DirectX::XMFLOAT2& pos)
 
 void RigidBody::AddTranslationX(float x)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
     DirectX::XMVECTOR delta = DirectX::XMVectorSet(x, 0.0f, 0.0f, 0.0f);
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, delta);
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::AddTranslationY(float y)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
 
     // Delta only in Y direction
     DirectX::XMVECTOR delta = DirectX::XMVectorSet(0.0f, y, 0.0f, 0.0f);
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, delta);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 void RigidBody::AddTranslationZ(float z)
 {
-    DirectX::XMVECTOR current = Position.Get();
+    DirectX::XMVECTOR current = m_Pool->m_Position.Get(m_Slot);
     // Delta only in Z direction
     DirectX::XMVECTOR delta = DirectX::XMVectorSet(0.0f, 0.0f, z, 0.0f);
     DirectX::XMVECTOR updated = DirectX::XMVectorAdd(current, delta);
 
-    Position.Set(updated);
+    m_Pool->m_Position.Set(m_Slot, updated);
 }
 
 DirectX::XMFLOAT3 RigidBody::GetTranslation()
 {
     DirectX::XMFLOAT3 result;
-    DirectX::XMStoreFloat3(&result, Position.Get());
+    DirectX::XMStoreFloat3(&result, m_Pool->m_Position.Get(m_Slot));
     return result;
 }
 
 DirectX::XMFLOAT2 RigidBody::GetTranslationXY()
 {
     DirectX::XMFLOAT2 result;
-    DirectX::XMVECTOR pos = Position.Get();
+    DirectX::XMVECTOR pos = m_Pool->m_Position.Get(m_Slot);
     result.x = DirectX::XMVectorGetX(pos);
     result.y = DirectX::XMVectorGetY(pos);
     return result;
@@ -235,29 +243,24 @@ DirectX::XMFLOAT2 RigidBody::GetTranslationXY()
 
 float RigidBody::GetPositionX()
 {
-    return DirectX::XMVectorGetX(Position.Get());
+    return DirectX::XMVectorGetX(m_Pool->m_Position.Get(m_Slot));
 }
 
 float RigidBody::GetPositionY()
 {
-    return DirectX::XMVectorGetY(Position.Get());
+    return DirectX::XMVectorGetY(m_Pool->m_Position.Get(m_Slot));
 }
 
 float RigidBody::GetPositionZ()
 {
-    return DirectX::XMVectorGetZ(Position.Get());
+    return DirectX::XMVectorGetZ(m_Pool->m_Position.Get(m_Slot));
 }
 
 void RigidBody::SetRotation(float pitch, float yaw, float roll)
 {
     DirectX::XMVECTOR quat = DirectX::XMQuaternionRotationRollPitchYaw(pitch, yaw, roll);
 
-    Orientation = Quaternion(
-        DirectX::XMVectorGetW(quat),
-        DirectX::XMVectorGetX(quat),
-        DirectX::XMVectorGetY(quat),
-        DirectX::XMVectorGetZ(quat)
-    );
+    Data().Orientation = Quaternion(quat);
 }
 
 void RigidBody::SetRotation(const DirectX::XMFLOAT3& rot)
@@ -267,29 +270,24 @@ void RigidBody::SetRotation(const DirectX::XMFLOAT3& rot)
 
 void RigidBody::SetRotation(const DirectX::XMVECTOR& rot)
 {
-    Orientation = Quaternion(
-        DirectX::XMVectorGetW(rot),
-        DirectX::XMVectorGetX(rot),
-        DirectX::XMVectorGetY(rot),
-        DirectX::XMVectorGetZ(rot)
-    );
+    Data().Orientation = Quaternion(rot);
 }
 
 void RigidBody::SetYaw(float yaw)
 {
-    DirectX::XMFLOAT3 euler = QuaternionToEuler(Orientation);
+    DirectX::XMFLOAT3 euler = QuaternionToEuler(Data().Orientation);
     SetRotation(euler.x, yaw, euler.z); // pitch, yaw, roll
 }
 
 void RigidBody::SetPitch(float pitch)
 {
-    DirectX::XMFLOAT3 euler = QuaternionToEuler(Orientation);
+    DirectX::XMFLOAT3 euler = QuaternionToEuler(Data().Orientation);
     SetRotation(pitch, euler.y, euler.z); // pitch, yaw, roll
 }
 
 void RigidBody::SetRoll(float roll)
 {
-    DirectX::XMFLOAT3 euler = QuaternionToEuler(Orientation);
+    DirectX::XMFLOAT3 euler = QuaternionToEuler(Data().Orientation);
     SetRotation(euler.x, euler.y, roll); // pitch, yaw, roll
 }
 
@@ -299,15 +297,10 @@ void RigidBody::AddRotation(float pitch, float yaw, float roll)
     DirectX::XMVECTOR qDelta = DirectX::XMQuaternionRotationRollPitchYaw(pitch, yaw, roll);
 
     // Compose with existing orientation
-    DirectX::XMVECTOR qCurrent = Orientation.ToXmVector();
+    DirectX::XMVECTOR qCurrent = Data().Orientation.ToXmVector();
     DirectX::XMVECTOR qResult = DirectX::XMQuaternionMultiply(qDelta, qCurrent);
 
-    Orientation = Quaternion(
-        DirectX::XMVectorGetW(qResult),
-        DirectX::XMVectorGetX(qResult),
-        DirectX::XMVectorGetY(qResult),
-        DirectX::XMVectorGetZ(qResult)
-    );
+    Data().Orientation = Quaternion(qResult);
 }
 
 void RigidBody::AddRotation(const DirectX::XMFLOAT3& rot)
@@ -318,15 +311,10 @@ void RigidBody::AddRotation(const DirectX::XMFLOAT3& rot)
 void RigidBody::AddRotation(const DirectX::XMVECTOR& rot)
 {
     // Compose: qResult = rot * current
-    DirectX::XMVECTOR qCurrent = Orientation.ToXmVector();
+    DirectX::XMVECTOR qCurrent = Data().Orientation.ToXmVector();
     DirectX::XMVECTOR qResult = DirectX::XMQuaternionMultiply(rot, qCurrent);
 
-    Orientation = Quaternion(
-        DirectX::XMVectorGetW(qResult),
-        DirectX::XMVectorGetX(qResult),
-        DirectX::XMVectorGetY(qResult),
-        DirectX::XMVectorGetZ(qResult)
-    );
+    Data().Orientation = Quaternion(qResult);
 }
 
 void RigidBody::AddYaw(float yaw)
@@ -362,22 +350,39 @@ void RigidBody::AddRoll(float roll)
 
 DirectX::XMFLOAT3 RigidBody::GetRotation() const
 {
-    return QuaternionToEuler(Orientation);
+    return QuaternionToEuler(Data().Orientation);
 }
 
 float RigidBody::GetYaw() const
 {
-    return QuaternionToEuler(Orientation).y;
+    return QuaternionToEuler(Data().Orientation).y;
 }
 
 float RigidBody::GetPitch() const
 {
-    return QuaternionToEuler(Orientation).x;
+    return QuaternionToEuler(Data().Orientation).x;
 }
 
 float RigidBody::GetRoll() const
 {
-    return QuaternionToEuler(Orientation).z;
+    return QuaternionToEuler(Data().Orientation).z;
+}
+
+BodyTransform RigidBody::GetRenderTransform() const
+{
+    const TransformSnapshot& snapshot = m_Pool->GetSnapshot();
+    if (const BodyTransform* published = snapshot.TryGet(m_Slot))
+    {
+        return published->Interpolated(snapshot.GetInterpolationAlpha());
+    }
+
+    BodyTransform live{};
+    live.Position = { m_Pool->m_Position.X[m_Slot], m_Pool->m_Position.Y[m_Slot], m_Pool->m_Position.Z[m_Slot] };
+    live.IsValid = 1;
+    DirectX::XMStoreFloat4(&live.Orientation, Data().Orientation.ToXmVector());
+    live.PreviousPosition = live.Position;
+    live.PreviousOrientation = live.Orientation;
+    return live;
 }
 
 DirectX::XMFLOAT3 RigidBody::QuaternionToEuler(const Quaternion& quaternion)
@@ -410,192 +415,226 @@ DirectX::XMFLOAT3 RigidBody::QuaternionToEuler(const Quaternion& quaternion)
 
 void RigidBody::SetVelocity(const DirectX::XMVECTOR& vel)
 {
-    Velocity.Set(vel);
-    m_VerletNeedsReset = true;
+    m_Pool->m_Velocity.Set(m_Slot, vel);
+    m_Pool->m_VerletNeedsReset[m_Slot] = 1;
+    Data().KinematicArrived = false;
+    Wake();
 }
 
 void RigidBody::SetDamping(float d)
 {
-    m_LinearDamping.store(d, std::memory_order_relaxed);
+    m_Pool->m_LinearDamping[m_Slot] = d;
 }
 
 
 void RigidBody::SetElasticity(float e)
 {
-    m_Elastic.store(e, std::memory_order_relaxed);
+    Data().Elastic = e;
 }
 
 
 void RigidBody::SetRestitution(float v)
 {
-    m_Restitution.store(v, std::memory_order_relaxed);
+    Data().Restitution = v;
 }
 
 
 void RigidBody::SetFriction(float v)
 {
-    m_Friction.store(v, std::memory_order_relaxed);
+    Data().Friction = v;
 }
 
 
 void RigidBody::SetAcceleration(const DirectX::XMVECTOR& acc)
 {
-    Acceleration.Set(acc);
+    m_Pool->m_Acceleration.Set(m_Slot, acc);
 }
 
 
 void RigidBody::SetOrientation(const Quaternion& q)
 {
-    Orientation = q;
-    Orientation.Normalize(); // direct math is fine
+    Data().Orientation = q;
+    Data().Orientation.Normalize(); // direct math is fine
 }
 
 
 void RigidBody::SetAngularVelocity(const DirectX::XMVECTOR& av)
 {
-    AngularVelocity.Set(av);
+    Data().AngularVelocity = av;
+    Data().KinematicArrived = false;
+    Wake();
 }
 
 
 void RigidBody::SetMass(float mass)
 {
-    InverseMass.store((mass > 0.0f) ? 1.0f / mass : 0.0f, std::memory_order_relaxed);
+    SetInverseMass((mass > 0.0f) ? 1.0f / mass : 0.0f);
 }
 
 
 void RigidBody::SetInverseMass(float invMass)
 {
-    InverseMass.store(invMass, std::memory_order_relaxed);
+    //~ Kinematic bodies stay at zero until they turn dynamic again
+    if (IsKinematic()) Data().DynamicInverseMass = invMass;
+    else m_Pool->m_InverseMass[m_Slot] = invMass;
 }
 
 
 void RigidBody::SetLinearDamping(float d)
 {
-    m_LinearDamping.store(d, std::memory_order_relaxed);
+    m_Pool->m_LinearDamping[m_Slot] = d;
 }
 
 
 void RigidBody::SetAngularDamping(float d)
 {
-    AngularDamping.store(d, std::memory_order_relaxed);
+    Data().AngularDamping = d;
 }
 
 
 void RigidBody::SetInverseInertiaTensor(const DirectX::XMMATRIX& tensor)
 {
-    m_InverseInertiaTensorLocal = tensor;
+    Data().InverseInertiaTensorLocal = tensor;
 }
 
 
 // Getters
 DirectX::XMVECTOR RigidBody::GetPosition()
 {
-    return Position.Get();
+    return m_Pool->m_Position.Get(m_Slot);
 }
 
 DirectX::XMVECTOR RigidBody::GetVelocity()
 {
-    return Velocity.Get();
+    return m_Pool->m_Velocity.Get(m_Slot);
 }
 
 DirectX::XMVECTOR RigidBody::GetAcceleration()
 {
-    return Acceleration.Get();
+    return m_Pool->m_Acceleration.Get(m_Slot);
 }
 
 DirectX::XMVECTOR RigidBody::GetAngularVelocity()
 {
-    return AngularVelocity.Get();
+    return Data().AngularVelocity;
 }
 
 Quaternion RigidBody::GetOrientation() const
 {
-    auto result = Orientation;
+    auto result = Data().Orientation;
     return result;
 }
 
 float RigidBody::GetMass() const
 {
-    float invMass = InverseMass.load(std::memory_order_relaxed);
+    float invMass = m_Pool->m_InverseMass[m_Slot];
     return (invMass > 0.0f) ? 1.0f / invMass : INFINITY;
 }
 
 float RigidBody::GetElasticity() const
 {
-    return m_Elastic.load(std::memory_order_relaxed);
+    return Data().Elastic;
 }
 
 float RigidBody::GetInverseMass() const
 {
-    return InverseMass.load(std::memory_order_relaxed);
+    return m_Pool->m_InverseMass[m_Slot];
 }
 
 DirectX::XMMATRIX RigidBody::GetInverseInertiaTensor() const
 {
-    return m_InverseInertiaTensorLocal;
+    return Data().InverseInertiaTensorLocal;
 }
 
 DirectX::XMMATRIX RigidBody::GetInverseInertiaTensorWorld() const
 {
-    return InverseInertiaTensorWorld;
+    return Data().InverseInertiaTensorWorld;
 }
 
 bool RigidBody::HasFiniteMass() const
 {
-    return InverseMass.load(std::memory_order_relaxed) > 0.0f;
+    return m_Pool->m_InverseMass[m_Slot] > 0.0f;
 }
 
 float RigidBody::GetDamping() const
 {
-    return m_LinearDamping.load(std::memory_order_relaxed);
+    return m_Pool->m_LinearDamping[m_Slot];
 }
 
 float RigidBody::GetAngularDamping() const
 {
-    return AngularDamping.load(std::memory_order_relaxed);
+    return Data().AngularDamping;
 }
 
 float RigidBody::GetRestitution() const
 {
-    return m_Restitution.load(std::memory_order_relaxed);
+    return Data().Restitution;
 }
 
 float RigidBody::GetFriction() const
 {
-    return m_Friction.load(std::memory_order_relaxed);
+    return Data().Friction;
 }
 
 void RigidBody::SetRestingState(bool state)
 {
-    m_Resting.store(state, std::memory_order_relaxed);
+    m_Pool->SetSleeping(m_Slot, state);
 }
 
 bool RigidBody::GetRestingState() const
 {
-    return m_Resting.load(std::memory_order_relaxed);
+    return m_Pool->IsSleeping(m_Slot);
 }
 
-void RigidBody::ConstrainVelocity(const DirectX::XMVECTOR& contactNormal)
+void RigidBody::Wake()
 {
-    const DirectX::XMVECTOR velocity = GetVelocity();
-    const float dot = DirectX::XMVectorGetX(DirectX::XMVector3Dot(velocity, contactNormal));
+    //~ Awake bodies keep their sleep timer, the island pass resets it once they move
+    if (m_Pool->IsSleeping(m_Slot)) m_Pool->SetSleeping(m_Slot, false);
+}
 
-    if (dot < 0.0f)
-    {
-        DirectX::XMVECTOR correction = DirectX::XMVectorScale(contactNormal, dot);
-        DirectX::XMVECTOR constrained = DirectX::XMVectorSubtract(velocity, correction);
-        SetVelocity(constrained);
-    }
+void RigidBody::SetKinematic(bool state)
+{
+    m_Pool->SetKinematic(m_Slot, state);
+}
+
+bool RigidBody::IsKinematic() const
+{
+    return m_Pool->IsKinematic(m_Slot);
+}
+
+void RigidBody::SetKinematicTarget(const DirectX::XMVECTOR& position, const Quaternion& orientation)
+{
+    m_Pool->SetKinematicTarget(m_Slot, position, orientation);
+}
+
+void RigidBody::SetKinematicTarget(const DirectX::XMVECTOR& position)
+{
+    m_Pool->SetKinematicTarget(m_Slot, position, Data().Orientation);
+}
+
+void RigidBody::SetContinuousCollision(bool state)
+{
+    Data().ContinuousCollision = state;
+}
+
+bool RigidBody::IsContinuousCollision() const
+{
+    return Data().ContinuousCollision;
+}
+
+void RigidBody::SetSimulated(bool state)
+{
+    m_Pool->m_Simulated[m_Slot] = state ? 1 : 0;
 }
 
-void RigidBody::SetAsPlatform(bool state)
+bool RigidBody::IsSimulated() const
 {
-    m_Platform.store(state, std::memory_order_relaxed);
+    return m_Pool->m_Simulated[m_Slot] != 0;
 }
 
-bool RigidBody::IsPlatform() const
+RigidBodyPool::BodyData& RigidBody::Data() const
 {
-    return m_Platform.load(std::memory_order_relaxed);
+    return m_Pool->m_Data[m_Slot];
 }
 
 void RigidBody::ComputeInverseInertiaTensorBox(float width, float height, float depth)
@@ -611,7 +650,7 @@ void RigidBody::ComputeInverseInertiaTensorBox(float width, float height, float
     float invIyy = (Iyy > 0.0f) ? (1.0f / Iyy) : 0.0f;
     float invIzz = (Izz > 0.0f) ? (1.0f / Izz) : 0.0f;
 
-    m_InverseInertiaTensorLocal = XMMatrixSet(
+    Data().InverseInertiaTensorLocal = XMMatrixSet(
         invIxx, 0.0f, 0.0f, 0.0f,
         0.0f, invIyy, 0.0f, 0.0f,
         0.0f, 0.0f, invIzz, 0.0f,
@@ -624,21 +663,21 @@ void RigidBody::ComputeInverseInertiaTensorSphere(float radius)
     float mass = GetMass();
     if (mass <= 0.0f)
     {
-        m_InverseInertiaTensorLocal.r[0] = DirectX::XMVectorZero();
-        m_InverseInertiaTensorLocal.r[1] = DirectX::XMVectorZero();
-        m_InverseInertiaTensorLocal.r[2] = DirectX::XMVectorZero();
-        m_InverseInertiaTensorLocal.r[3] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[0] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[1] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[2] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[3] = DirectX::XMVectorZero();
         return;
     }
 
     float factor = 2.0f / 5.0f * mass * radius * radius;
     float inv = 1.0f / factor;
 
-    m_InverseInertiaTensorLocal = DirectX::XMMatrixIdentity();
-    m_InverseInertiaTensorLocal.r[0] = DirectX::XMVectorSet(inv, 0, 0, 0);
-    m_InverseInertiaTensorLocal.r[1] = DirectX::XMVectorSet(0, inv, 0, 0);
-    m_InverseInertiaTensorLocal.r[2] = DirectX::XMVectorSet(0, 0, inv, 0);
-    m_InverseInertiaTensorLocal.r[3] = DirectX::XMVectorSet(0, 0, 0, 1);
+    Data().InverseInertiaTensorLocal = DirectX::XMMatrixIdentity();
+    Data().InverseInertiaTensorLocal.r[0] = DirectX::XMVectorSet(inv, 0, 0, 0);
+    Data().InverseInertiaTensorLocal.r[1] = DirectX::XMVectorSet(0, inv, 0, 0);
+    Data().InverseInertiaTensorLocal.r[2] = DirectX::XMVectorSet(0, 0, inv, 0);
+    Data().InverseInertiaTensorLocal.r[3] = DirectX::XMVectorSet(0, 0, 0, 1);
 }
 
 void RigidBody::ComputeInverseInertiaTensorCapsule(float radius, float height)
@@ -648,10 +687,10 @@ void RigidBody::ComputeInverseInertiaTensorCapsule(float radius, float height)
     float mass = GetMass();
     if (mass <= 0.0f)
     {
-        m_InverseInertiaTensorLocal.r[0] = DirectX::XMVectorZero();
-        m_InverseInertiaTensorLocal.r[1] = DirectX::XMVectorZero();
-        m_InverseInertiaTensorLocal.r[2] = DirectX::XMVectorZero();
-        m_InverseInertiaTensorLocal.r[3] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[0] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[1] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[2] = DirectX::XMVectorZero();
+        Data().InverseInertiaTensorLocal.r[3] = DirectX::XMVectorZero();
         return;
     }
 
@@ -684,7 +723,7 @@ void RigidBody::ComputeInverseInertiaTensorCapsule(float radius, float height)
     float invIyy = (Iyy > 0.0f) ? 1.0f / Iyy : 0.0f;
     float invIzz = (Izz > 0.0f) ? 1.0f / Izz : 0.0f;
 
-    m_InverseInertiaTensorLocal = XMMatrixSet(
+    Data().InverseInertiaTensorLocal = XMMatrixSet(
         invIxx, 0.0f, 0.0f, 0.0f,
         0.0f, invIyy, 0.0f, 0.0f,
         0.0f, 0.0f, invIzz, 0.0f,
@@ -703,137 +742,11 @@ void RigidBody::ApplyLinearImpulse(const DirectX::XMVECTOR& impulse)
 void RigidBody::ApplyAngularImpulse(const DirectX::XMVECTOR& impulse, const DirectX::XMVECTOR& contactVector)
 {
     DirectX::XMVECTOR torque = DirectX::XMVector3Cross(contactVector, impulse);
-    DirectX::XMVECTOR deltaAngular = DirectX::XMVector3Transform(torque, InverseInertiaTensorWorld);
+    DirectX::XMVECTOR deltaAngular = DirectX::XMVector3Transform(torque, Data().InverseInertiaTensorWorld);
 
     SetAngularVelocity(DirectX::XMVectorAdd(GetAngularVelocity(), deltaAngular));
 }
 
-void RigidBody::IntegrateEuler(float dt)
-{
-    CalculateDerivedData();
-
-    if (InverseMass.load(std::memory_order_relaxed) <= 0.0f) return;
-
-    DirectX::XMVECTOR pos = Position.Get();
-    DirectX::XMVECTOR vel = Velocity.Get();
-    DirectX::XMVECTOR acc = Acceleration.Get();
-    DirectX::XMVECTOR force = ForceAccum.Get();
-
-    DirectX::XMVECTOR acceleration = DirectX::XMVectorAdd(acc, DirectX::XMVectorScale(force, InverseMass));
-
-    pos = DirectX::XMVectorAdd(pos, DirectX::XMVectorScale(vel, dt));
-    vel = DirectX::XMVectorAdd(vel, DirectX::XMVectorScale(acceleration, dt));
-
-    ApplyLinearDamping(vel, dt);
-
-    Position.Set(pos);
-    Velocity.Set(vel);
-
-    IntegrateAngular(dt);
-    ClearAccumulators();
-}
-
-void RigidBody::IntegrateSemiImplicitEuler(float dt)
-{
-    CalculateDerivedData();
-
-    if (InverseMass.load(std::memory_order_relaxed) <= 0.0f) return;
-
-    DirectX::XMVECTOR pos = Position.Get();
-    DirectX::XMVECTOR vel = Velocity.Get();
-    DirectX::XMVECTOR acc = Acceleration.Get();
-    DirectX::XMVECTOR force = ForceAccum.Get();
-
-    DirectX::XMVECTOR acceleration = DirectX::XMVectorAdd(acc, DirectX::XMVectorScale(force, InverseMass));
-
-    vel = DirectX::XMVectorAdd(vel, DirectX::XMVectorScale(acceleration, dt));
-    pos = DirectX::XMVectorAdd(pos, DirectX::XMVectorScale(vel, dt));
-
-    ApplyLinearDamping(vel, dt);
-
-    Position.Set(pos);
-    Velocity.Set(vel);
-
-    IntegrateAngular(dt);
-    ClearAccumulators();
-}
-
-void RigidBody::IntegrateVerlet(float dt)
-{
-    CalculateDerivedData();
-
-    if (InverseMass.load(std::memory_order_relaxed) <= 0.0f) return;
-
-    DirectX::XMVECTOR pos = Position.Get();
-
-    if (m_VerletNeedsReset)
-    {
-        DirectX::XMVECTOR vel = Velocity.Get();
-        DirectX::XMVECTOR lastPos = DirectX::XMVectorSubtract(pos, DirectX::XMVectorScale(vel, dt));
-        m_LastPosition.Set(lastPos);
-        m_VerletNeedsReset = false;
-    }
-
-    DirectX::XMVECTOR lastPos = m_LastPosition.Get();
-    DirectX::XMVECTOR acc = Acceleration.Get();
-    DirectX::XMVECTOR force = ForceAccum.Get();
-
-    DirectX::XMVECTOR acceleration = DirectX::XMVectorAdd(acc, DirectX::XMVectorScale(force, InverseMass));
-    acceleration = ClampVectorLength(acceleration, 100.0f);
-
-    DirectX::XMVECTOR posDelta = DirectX::XMVectorSubtract(pos, lastPos);
-    DirectX::XMVECTOR accelTerm = DirectX::XMVectorScale(acceleration, dt * dt);
-    DirectX::XMVECTOR newPos = DirectX::XMVectorAdd(pos, DirectX::XMVectorAdd(posDelta, accelTerm));
-
-    DirectX::XMVECTOR vel = DirectX::XMVectorScale(posDelta, 1.0f / dt);
-    ApplyLinearDamping(vel, dt);
-
-    m_LastPosition.Set(pos);
-    Position.Set(newPos);
-    Velocity.Set(vel);
-
-    IntegrateAngular(dt);
-    ClearAccumulators();
-}
-
-void RigidBody::IntegrateAngular(float dt)
-{
-    DirectX::XMVECTOR angVel = AngularVelocity.Get();
-    DirectX::XMVECTOR torque = TorqueAccum.Get();
-
-    DirectX::XMVECTOR angularAcc = DirectX::XMVector3Transform(torque, m_InverseInertiaTensorLocal);
-    angVel = DirectX::XMVectorAdd(angVel, DirectX::XMVectorScale(angularAcc, dt));
-
-    float angDamp = AngularDamping.load(std::memory_order_relaxed);
-    angVel = DirectX::XMVectorScale(angVel, std::pow(angDamp, dt));
-
-    AngularVelocity.Set(angVel);
-
-    Orientation.AddScaledVector(angVel, dt);
-    Orientation.Normalize();
-
-    // Optional: sleep threshold
-    if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(angVel)) < 1e-5f)
-        AngularVelocity.Set(DirectX::XMVectorZero());
-}
-
-void RigidBody::ApplyLinearDamping(DirectX::XMVECTOR& vel, float dt) const
-{
-    float damping = m_LinearDamping.load(std::memory_order_relaxed);
-    vel = DirectX::XMVectorScale(vel, std::pow(damping, dt));
-
-    if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(vel)) < 1e-5f)
-        vel = DirectX::XMVectorZero();
-}
-
-void RigidBody::ResetVerletState(float delta)
-{
-    const auto pos = Position.Get();
-    const auto vel = Velocity.Get();
-    const auto lastPos = DirectX::XMVectorSubtract(pos, DirectX::XMVectorScale(vel, delta));
-    m_LastPosition.Set(lastPos);
-}
-
 DirectX::XMVECTOR RigidBody::ClampVectorLength(DirectX::XMVECTOR vec, float maxLength)
 {
     using namespace DirectX;
@@ -1,36 +1,23 @@
 #pragma once
-#include <atomic>
+#include <cstdint>
 #include <DirectXMath.h>
 #include "Quaternion/Quaternion.h"
 #include "IntegrationType.h"
+#include "RigidBodyPool.h"
 
 
-struct AtomicVector
-{
-    DirectX::XMVECTOR value = DirectX::XMVectorZero();
-    std::atomic_flag lock = ATOMIC_FLAG_INIT;
-
-    DirectX::XMVECTOR Get()
-    {
-        while (lock.test_and_set(std::memory_order_acquire)); // spin
-        DirectX::XMVECTOR val = value;
-        lock.clear(std::memory_order_release);
-        return val;
-    }
-
-    void Set(DirectX::XMVECTOR v)
-    {
-        while (lock.test_and_set(std::memory_order_acquire)); // spin
-        value = v;
-        lock.clear(std::memory_order_release);
-    }
-};
-
-
+// Handle to a body stored in RigidBodyPool. The handle owns its slot: constructing one
+// allocates a slot, destroying it releases the slot, copying clones the body state.
 class RigidBody
 {
 public:
     RigidBody();
+    ~RigidBody();
+
+    RigidBody(const RigidBody& other);
+    RigidBody(RigidBody&& other) noexcept;
+    RigidBody& operator=(const RigidBody& other);
+    RigidBody& operator=(RigidBody&& other) noexcept;
 
     void CalculateDerivedData();
 
@@ -69,13 +56,33 @@ public:
     float GetRestitution() const;
     float GetFriction() const;
 
+    //~ Resting bodies are asleep: not integrated and not tested against other resting bodies
     void SetRestingState(bool state);
     bool GetRestingState() const;
-
-    void ConstrainVelocity(const DirectX::XMVECTOR& contactNormal);
-
-    void SetAsPlatform(bool state);
-    bool IsPlatform() const;
+    void Wake();
+
+    //~ Kinematic bodies (moving platforms, elevators, doors) follow their targets with infinite
+    //~ mass and carry whatever rests on them (see RigidBodyPool::SetKinematic). The mass set
+    //~ while kinematic applies once the body turns dynamic again.
+    void SetKinematic(bool state);
+    bool IsKinematic() const;
+
+    //~ Where a kinematic body should be at the end of the next step, the orientation is kept
+    //~ when not given. The whole move happens in that one step and the body then stays at the
+    //~ target, so a frame that runs several steps does not carry it past; set a target every
+    //~ frame for continuous motion.
+    void SetKinematicTarget(const DirectX::XMVECTOR& position, const Quaternion& orientation);
+    void SetKinematicTarget(const DirectX::XMVECTOR& position);
+
+    //~ Opt-in continuous collision: the step sweeps this body from its previous pose and stops it
+    //~ at the first impact, so it cannot tunnel through thin colliders (see ContinuousCollision)
+    void SetContinuousCollision(bool state);
+    bool IsContinuousCollision() const;
+
+    //~ Only simulated bodies are advanced by RigidBodyPool::IntegrateAll
+    void SetSimulated(bool state);
+    bool IsSimulated() const;
+    uint32_t GetSlot() const { return m_Slot; }
 
     void ComputeInverseInertiaTensorBox(float width, float height, float depth);
     void ComputeInverseInertiaTensorSphere(float radius);
@@ -133,42 +140,18 @@ public:
     float GetPitch() const;
     float GetRoll() const;
 
+    //~ Pose blended between the last two published steps by the snapshot alpha
+    //~ (falls back to the live state before the first publish)
+    BodyTransform GetRenderTransform() const;
+
     //~ Helper
     static DirectX::XMFLOAT3 QuaternionToEuler(const Quaternion& quaternion);
     static DirectX::XMVECTOR ClampVectorLength(DirectX::XMVECTOR vec, float maxLength);
 
 private:
-    void IntegrateEuler(float dt);
-    void IntegrateSemiImplicitEuler(float dt);
-    void IntegrateVerlet(float dt);
-
-    void IntegrateAngular(float dt);
-    void ApplyLinearDamping(DirectX::XMVECTOR& vel, float dt) const;
-
-    void ResetVerletState(float delta);
+    RigidBodyPool::BodyData& Data() const;
 
 private:
-    bool m_VerletNeedsReset{ false };
-    std::atomic<bool> m_Platform{ false };
-    std::atomic<bool> m_Resting{ false };
-    std::atomic<float> InverseMass{ 10.f };
-    std::atomic<float> m_LinearDamping{ 0.75f };
-    std::atomic<float> m_Elastic{ 0.56f };
-    std::atomic<float> m_Restitution{ 0.35f };
-    std::atomic<float> m_Friction{ 0.38f };
-    std::atomic<float> AngularDamping{ 0.39f };
-
-
-    Quaternion Orientation;
-    AtomicVector Position;
-    AtomicVector m_LastPosition;
-    AtomicVector Velocity;
-    AtomicVector Acceleration;
-    AtomicVector ForceAccum;
-    AtomicVector AngularVelocity;
-    AtomicVector TorqueAccum;
-
-    DirectX::XMMATRIX m_InverseInertiaTensorLocal;
-    DirectX::XMMATRIX InverseInertiaTensorWorld;
-    DirectX::XMMATRIX TransformMatrix;
+    RigidBodyPool* m_Pool;
+    uint32_t m_Slot;
 };
\ No newline at end of file
@@ -0,0 +1,781 @@
+#include "pch.h"
+#include "RigidBodyPool.h"
+#include "State/StateBuffer.h"
+#include "Threading/WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+
+RigidBodyPool* RigidBodyPool::Get()
+{
+    static RigidBodyPool instance{};
+    return &instance;
+}
+
+uint32_t RigidBodyPool::Allocate()
+{
+    if (m_FreeSlots.empty()) Grow();
+
+    const uint32_t slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+
+    ResetSlot(slot);
+    m_Active[slot] = 1;
+    ++m_ActiveCount;
+    return slot;
+}
+
+uint32_t RigidBodyPool::Clone(uint32_t source)
+{
+    const uint32_t slot = Allocate();
+
+    m_Position.Set(slot, m_Position.Get(source));
+    m_LastPosition.Set(slot, m_LastPosition.Get(source));
+    m_Velocity.Set(slot, m_Velocity.Get(source));
+    m_Acceleration.Set(slot, m_Acceleration.Get(source));
+    m_ForceAccum.Set(slot, m_ForceAccum.Get(source));
+    m_InverseMass[slot] = m_InverseMass[source];
+    m_LinearDamping[slot] = m_LinearDamping[source];
+    m_Data[slot] = m_Data[source];
+    m_Simulated[slot] = m_Simulated[source];
+    m_VerletNeedsReset[slot] = m_VerletNeedsReset[source];
+    m_Sleeping[slot] = m_Sleeping[source];
+    return slot;
+}
+
+void RigidBodyPool::Release(uint32_t slot)
+{
+    if (slot >= m_Active.size() || !m_Active[slot]) return;
+
+    ResetSlot(slot);
+    m_FreeSlots.push_back(slot);
+    --m_ActiveCount;
+}
+
+uint32_t RigidBodyPool::IntegrateAll(float dt, IntegrationType type, WorkerPool* workers)
+{
+    const uint32_t batchCount = static_cast<uint32_t>(m_Active.size()) / BatchWidth;
+
+    //~ Bodies never read each other here, so any split of the slots gives the same result
+    if (!workers)
+    {
+        return IntegrateRange(0, batchCount, dt, type);
+    }
+
+    std::atomic<uint32_t> integrated{ 0 };
+    workers->ParallelFor(batchCount, 16, [&](uint32_t begin, uint32_t end, uint32_t)
+    {
+        integrated.fetch_add(IntegrateRange(begin, end, dt, type), std::memory_order_relaxed);
+    });
+    return integrated.load(std::memory_order_relaxed);
+}
+
+uint32_t RigidBodyPool::IntegrateRange(uint32_t firstBatch, uint32_t endBatch, float dt, IntegrationType type)
+{
+    const uint32_t firstSlot = firstBatch * BatchWidth;
+    const uint32_t endSlot = endBatch * BatchWidth;
+
+    //~ The little per body work left: kinematic bodies and the Verlet restart
+    uint32_t integrated = 0;
+    for (uint32_t slot = firstSlot; slot < endSlot; ++slot)
+    {
+        if (!m_Active[slot] || !m_Simulated[slot] || m_Sleeping[slot]) continue;
+
+        //~ Zero inverse mass keeps them out of the batched passes below
+        if (m_Data[slot].Kinematic)
+        {
+            IntegrateKinematic(slot, dt);
+            ++integrated;
+            continue;
+        }
+        if (m_InverseMass[slot] <= 0.0f) continue;
+
+        if (type == IntegrationType::Verlet) PrepareVerlet(slot, dt);
+        ++integrated;
+    }
+
+    //~ Rotations, inertia and linear state, BatchWidth bodies at a time (capacity is padded so
+    //~ there is no tail)
+    DampingCache dampingCache{};
+    for (uint32_t first = firstSlot; first < endSlot; first += BatchWidth)
+    {
+        IntegrateAngularBatch(first, dt, dampingCache);
+        IntegrateLinearBatch(first, dt, type, dampingCache);
+    }
+    return integrated;
+}
+
+void RigidBodyPool::Integrate(uint32_t slot, float dt, IntegrationType type)
+{
+    if (m_Data[slot].Kinematic)
+    {
+        IntegrateKinematic(slot, dt);
+        return;
+    }
+
+    CalculateDerivedData(slot);
+    if (m_InverseMass[slot] <= 0.0f) return;
+
+    if (type == IntegrationType::Verlet) PrepareVerlet(slot, dt);
+    IntegrateLinear(slot, dt, type);
+    IntegrateAngular(slot, dt);
+
+    m_ForceAccum.Set(slot, DirectX::XMVectorZero());
+    m_Data[slot].TorqueAccum = DirectX::XMVectorZero();
+}
+
+void RigidBodyPool::PublishTransforms()
+{
+    std::vector<BodyTransform>& buffer = m_Snapshot.GetBackBuffer();
+    buffer.resize(m_Active.size());
+
+    for (uint32_t slot = 0; slot < static_cast<uint32_t>(buffer.size()); ++slot)
+    {
+        BodyTransform& transform = buffer[slot];
+        BodyTransform& last = m_LastPublished[slot];
+        transform.IsValid = m_Active[slot];
+        if (!transform.IsValid) continue;
+
+        transform.Position = { m_Position.X[slot], m_Position.Y[slot], m_Position.Z[slot] };
+        DirectX::XMStoreFloat4(&transform.Orientation, m_Data[slot].Orientation.ToXmVector());
+
+        //~ A body published for the first time has no earlier pose to blend from
+        transform.PreviousPosition = last.IsValid ? last.Position : transform.Position;
+        transform.PreviousOrientation = last.IsValid ? last.Orientation : transform.Orientation;
+        last = transform;
+    }
+
+    m_Snapshot.Publish();
+}
+
+void RigidBodyPool::SetSleeping(uint32_t slot, bool sleeping)
+{
+    using namespace DirectX;
+
+    BodyData& data = m_Data[slot];
+    data.SleepTime = 0.0f;
+    if (m_Sleeping[slot] == static_cast<uint8_t>(sleeping)) return;
+
+    m_Sleeping[slot] = sleeping;
+    if (!sleeping)
+    {
+        m_VerletNeedsReset[slot] = 1;
+        return;
+    }
+
+    //~ A sleeping body is exactly at rest, waking it must not replay stale motion
+    m_Velocity.Set(slot, XMVectorZero());
+    m_ForceAccum.Set(slot, XMVectorZero());
+    data.AngularVelocity = XMVectorZero();
+    data.TorqueAccum = XMVectorZero();
+}
+
+void RigidBodyPool::SetKinematic(uint32_t slot, bool kinematic)
+{
+    using namespace DirectX;
+
+    BodyData& data = m_Data[slot];
+    if (data.Kinematic == kinematic) return;
+
+    data.Kinematic = kinematic;
+    data.HasKinematicTarget = false;
+    data.KinematicArrived = false;
+    if (!kinematic)
+    {
+        //~ Leaves with the velocity it was moving at
+        m_InverseMass[slot] = data.DynamicInverseMass;
+        m_VerletNeedsReset[slot] = 1;
+        return;
+    }
+
+    data.DynamicInverseMass = m_InverseMass[slot];
+    m_InverseMass[slot] = 0.0f;
+    m_ForceAccum.Set(slot, XMVectorZero());
+    data.TorqueAccum = XMVectorZero();
+    SetSleeping(slot, false);
+}
+
+void RigidBodyPool::SetKinematicTarget(uint32_t slot, const DirectX::XMVECTOR& position, const Quaternion& orientation)
+{
+    BodyData& data = m_Data[slot];
+    DirectX::XMStoreFloat3(&data.KinematicPosition, position);
+    DirectX::XMStoreFloat4(&data.KinematicOrientation, DirectX::XMQuaternionNormalize(orientation.ToXmVector()));
+    data.HasKinematicTarget = true;
+    data.KinematicArrived = false;
+}
+
+bool RigidBodyPool::IsKinematicMoving(uint32_t slot) const
+{
+    using namespace DirectX;
+
+    const BodyData& data = m_Data[slot];
+    if (!data.Kinematic) return false;
+    if (data.HasKinematicTarget) return true;
+
+    return XMVectorGetX(XMVector3LengthSq(m_Velocity.Get(slot))) > 0.0f ||
+           XMVectorGetX(XMVector3LengthSq(data.AngularVelocity)) > 0.0f;
+}
+
+bool RigidBodyPool::CanSleep(uint32_t slot) const
+{
+    return m_Active[slot] && m_Simulated[slot] && m_InverseMass[slot] > 0.0f;
+}
+
+float RigidBodyPool::UpdateSleepTime(uint32_t slot, float dt, float linearThreshold, float angularThreshold)
+{
+    using namespace DirectX;
+
+    BodyData& data = m_Data[slot];
+    const float linearSq = XMVectorGetX(XMVector3LengthSq(m_Velocity.Get(slot)));
+    const float angularSq = XMVectorGetX(XMVector3LengthSq(data.AngularVelocity));
+
+    if (linearSq > linearThreshold * linearThreshold || angularSq > angularThreshold * angularThreshold)
+    {
+        data.SleepTime = 0.0f;
+    }
+    else
+    {
+        data.SleepTime += dt;
+    }
+    return data.SleepTime;
+}
+
+void RigidBodyPool::SaveState(StateWriter& writer) const
+{
+    const size_t capacity = m_Active.size();
+    writer.Write(static_cast<uint64_t>(capacity));
+    writer.WriteArray(m_Active.data(), capacity);
+    writer.WriteArray(m_Simulated.data(), capacity);
+
+    for (const SoAVector3* vector : { &m_Position, &m_LastPosition, &m_Velocity, &m_Acceleration, &m_ForceAccum })
+    {
+        writer.WriteArray(vector->X.data(), capacity);
+        writer.WriteArray(vector->Y.data(), capacity);
+        writer.WriteArray(vector->Z.data(), capacity);
+    }
+    writer.WriteArray(m_InverseMass.data(), capacity);
+    writer.WriteArray(m_LinearDamping.data(), capacity);
+    writer.WriteArray(m_VerletNeedsReset.data(), capacity);
+    writer.WriteArray(m_Sleeping.data(), capacity);
+    writer.WriteArray(m_LastPublished.data(), capacity);
+
+    writer.WriteArray(m_Data.data(), capacity);
+}
+
+bool RigidBodyPool::CheckState(StateReader& reader) const
+{
+    return ReadStateSlots(reader) && reader.Skip(m_Active.size() * SlotStateSize);
+}
+
+bool RigidBodyPool::RestoreState(StateReader& reader)
+{
+    const size_t capacity = m_Active.size();
+    if (!ReadStateSlots(reader) || reader.GetRemaining() / SlotStateSize < capacity) return false;
+
+    //~ The whole state is there, so the reads below fill every array or (never) none
+    bool read = true;
+    for (SoAVector3* vector : { &m_Position, &m_LastPosition, &m_Velocity, &m_Acceleration, &m_ForceAccum })
+    {
+        read = read && reader.ReadArray(vector->X.data(), capacity);
+        read = read && reader.ReadArray(vector->Y.data(), capacity);
+        read = read && reader.ReadArray(vector->Z.data(), capacity);
+    }
+    read = read && reader.ReadArray(m_InverseMass.data(), capacity);
+    read = read && reader.ReadArray(m_LinearDamping.data(), capacity);
+    read = read && reader.ReadArray(m_VerletNeedsReset.data(), capacity);
+    read = read && reader.ReadArray(m_Sleeping.data(), capacity);
+    read = read && reader.ReadArray(m_LastPublished.data(), capacity);
+
+    return read && reader.ReadArray(m_Data.data(), capacity);
+}
+
+bool RigidBodyPool::ReadStateSlots(StateReader& reader) const
+{
+    //~ Bodies own their slots, so the state has to describe exactly the bodies alive now.
+    //~ A body taken out of the simulation since the save stays out.
+    const size_t capacity = m_Active.size();
+    uint64_t savedCapacity = 0;
+    if (!reader.Read(savedCapacity) || savedCapacity != capacity) return false;
+
+    return reader.ReadEqual(m_Active.data(), capacity) && reader.ReadEqual(m_Simulated.data(), capacity);
+}
+
+void RigidBodyPool::Grow()
+{
+    const size_t oldCapacity = m_Active.size();
+    const size_t newCapacity = (std::max)(static_cast<size_t>(BatchWidth), oldCapacity * 2);
+
+    m_Position.Resize(newCapacity);
+    m_LastPosition.Resize(newCapacity);
+    m_Velocity.Resize(newCapacity);
+    m_Acceleration.Resize(newCapacity);
+    m_ForceAccum.Resize(newCapacity);
+    m_InverseMass.resize(newCapacity, 0.0f);
+    m_LinearDamping.resize(newCapacity, 1.0f);
+    m_Data.resize(newCapacity);
+    m_Active.resize(newCapacity, 0);
+    m_Simulated.resize(newCapacity, 0);
+    m_VerletNeedsReset.resize(newCapacity, 0);
+    m_Sleeping.resize(newCapacity, 0);
+    m_LastPublished.resize(newCapacity);
+
+    //~ Hand out low slots first so live bodies stay packed at the front
+    for (size_t slot = newCapacity; slot > oldCapacity; --slot)
+    {
+        m_FreeSlots.push_back(static_cast<uint32_t>(slot - 1));
+    }
+}
+
+void RigidBodyPool::ResetSlot(uint32_t slot)
+{
+    using namespace DirectX;
+
+    m_Position.Set(slot, XMVectorZero());
+    m_LastPosition.Set(slot, XMVectorZero());
+    m_Velocity.Set(slot, XMVectorZero());
+    m_Acceleration.Set(slot, XMVectorZero());
+    m_ForceAccum.Set(slot, XMVectorZero());
+    m_InverseMass[slot] = 1.0f;
+    m_LinearDamping[slot] = 0.75f;
+    m_Data[slot] = BodyData{};
+    m_Active[slot] = 0;
+    m_Simulated[slot] = 0;
+    m_VerletNeedsReset[slot] = 0;
+    m_Sleeping[slot] = 0;
+    m_LastPublished[slot] = BodyTransform{};
+}
+
+void RigidBodyPool::CalculateDerivedData(uint32_t slot)
+{
+    using namespace DirectX;
+
+    BodyData& data = m_Data[slot];
+    data.Orientation.Normalize(); // Prevent drift
+
+    const XMMATRIX rotMatrix = XMMatrixRotationQuaternion(data.Orientation.ToXmVector());
+    const XMMATRIX translation = XMMatrixTranslationFromVector(m_Position.Get(slot));
+
+    data.TransformMatrix = rotMatrix * translation; // Full local-to-world matrix
+
+    const XMMATRIX rotTranspose = XMMatrixTranspose(rotMatrix);
+    data.InverseInertiaTensorWorld = XMMatrixMultiply(
+        XMMatrixMultiply(rotMatrix, data.InverseInertiaTensorLocal),
+        rotTranspose
+    );
+}
+
+void RigidBodyPool::IntegrateAngular(uint32_t slot, float dt)
+{
+    using namespace DirectX;
+
+    BodyData& data = m_Data[slot];
+
+    const XMVECTOR angularAcc = XMVector3Transform(data.TorqueAccum, data.InverseInertiaTensorLocal);
+    XMVECTOR angVel = XMVectorAdd(data.AngularVelocity, XMVectorScale(angularAcc, dt));
+    angVel = XMVectorScale(angVel, std::pow(data.AngularDamping, dt));
+
+    data.Orientation.AddScaledVector(angVel, dt);
+    data.Orientation.Normalize();
+
+    // Optional: sleep threshold
+    if (XMVectorGetX(XMVector3LengthSq(angVel)) < 1e-5f) angVel = XMVectorZero();
+    data.AngularVelocity = angVel;
+}
+
+void RigidBodyPool::PrepareVerlet(uint32_t slot, float dt)
+{
+    using namespace DirectX;
+    if (!m_VerletNeedsReset[slot]) return;
+
+    const XMVECTOR lastPos = XMVectorSubtract(m_Position.Get(slot), XMVectorScale(m_Velocity.Get(slot), dt));
+    m_LastPosition.Set(slot, lastPos);
+    m_VerletNeedsReset[slot] = 0;
+}
+
+// Kinematic bodies go exactly where they are told. The velocities are world space and only
+// recorded for the solver, which is how resting contacts pick up the platform's motion. A target
+// is reached in one step and the body stops there on the next; without a target it moves at
+// the velocity it was given.
+void RigidBodyPool::IntegrateKinematic(uint32_t slot, float dt)
+{
+    using namespace DirectX;
+
+    BodyData& data = m_Data[slot];
+    const XMVECTOR position = m_Position.Get(slot);
+    const XMVECTOR orientation = data.Orientation.ToXmVector();
+    m_LastPosition.Set(slot, position);
+
+    if (data.HasKinematicTarget)
+    {
+        const float inverseDt = 1.0f / dt;
+        const XMVECTOR targetPosition = XMLoadFloat3(&data.KinematicPosition);
+        XMVECTOR targetOrientation = XMLoadFloat4(&data.KinematicOrientation);
+
+        m_Velocity.Set(slot, XMVectorScale(XMVectorSubtract(targetPosition, position), inverseDt));
+
+        //~ Rotation from the current orientation to the target (target * conjugate(current)),
+        //~ the short way round, as axis * angle / dt
+        if (XMVectorGetX(XMVector4Dot(targetOrientation, orientation)) < 0.0f)
+        {
+            targetOrientation = XMVectorNegate(targetOrientation);
+        }
+        const XMVECTOR delta = XMQuaternionMultiply(XMQuaternionConjugate(orientation), targetOrientation);
+        const float sinHalfAngle = XMVectorGetX(XMVector3Length(delta));
+        const float scale = sinHalfAngle > 1e-6f
+            ? 2.0f * std::atan2(sinHalfAngle, XMVectorGetW(delta)) / sinHalfAngle
+            : 2.0f;
+        data.AngularVelocity = XMVectorSetW(XMVectorScale(delta, scale * inverseDt), 0.0f);
+
+        m_Position.Set(slot, targetPosition);
+        data.Orientation = Quaternion(targetOrientation);
+        data.HasKinematicTarget = false;
+        data.KinematicArrived = true;
+    }
+    else if (data.KinematicArrived)
+    {
+        //~ Holds at the target. Carrying on at the velocity that reached it would overshoot
+        //~ whenever a frame runs more than one step for a single target.
+        m_Velocity.Set(slot, XMVectorZero());
+        data.AngularVelocity = XMVectorZero();
+        data.KinematicArrived = false;
+    }
+    else
+    {
+        m_Position.Set(slot, XMVectorMultiplyAdd(m_Velocity.Get(slot), XMVectorReplicate(dt), position));
+
+        const float angularSpeed = XMVectorGetX(XMVector3Length(data.AngularVelocity));
+        if (angularSpeed > 0.0f)
+        {
+            const XMVECTOR rotation = XMQuaternionRotationNormal(
+                XMVectorScale(data.AngularVelocity, 1.0f / angularSpeed), angularSpeed * dt);
+            data.Orientation = Quaternion(XMQuaternionMultiply(orientation, rotation));
+        }
+    }
+
+    m_ForceAccum.Set(slot, XMVectorZero());
+    data.TorqueAccum = XMVectorZero();
+    CalculateDerivedData(slot);
+}
+
+DirectX::XMVECTOR RigidBodyPool::GetDampingFactors(const DirectX::XMVECTOR& damping, float dt, DampingCache& cache)
+{
+    using namespace DirectX;
+
+    const float first = XMVectorGetX(damping);
+    if (!XMVector4Equal(damping, XMVectorReplicate(first)))
+    {
+        return XMVectorPow(damping, XMVectorReplicate(dt));
+    }
+
+    if (first != cache.Damping || dt != cache.DeltaTime)
+    {
+        cache.Damping = first;
+        cache.DeltaTime = dt;
+        cache.Factor = std::pow(first, dt);
+    }
+    return XMVectorReplicate(cache.Factor);
+}
+
+// CalculateDerivedData and IntegrateAngular for one BatchWidth block. The quaternions go through
+// Quaternion's batch helpers; the inertia tensors and angular velocities are worked on four
+// bodies at a time, one per XMVECTOR lane, like the linear state below. Only the 3x3 part of
+// the inverse inertia tensor is rotated into world space, its last row is copied.
+void RigidBodyPool::IntegrateAngularBatch(uint32_t first, float dt, DampingCache& dampingCache)
+{
+    using namespace DirectX;
+
+    //~ Bodies that spin first, then the ones without finite mass that only need derived data
+    const auto needsDerivedData = [this](uint32_t slot)
+    {
+        return m_Active[slot] && m_Simulated[slot] && !m_Sleeping[slot] && !m_Data[slot].Kinematic;
+    };
+    uint32_t slots[BatchWidth];
+    uint32_t count = 0;
+    for (uint32_t slot = first; slot < first + BatchWidth; ++slot)
+    {
+        if (needsDerivedData(slot) && m_InverseMass[slot] > 0.0f) slots[count++] = slot;
+    }
+    const uint32_t spinningCount = count;
+    for (uint32_t slot = first; slot < first + BatchWidth; ++slot)
+    {
+        if (needsDerivedData(slot) && m_InverseMass[slot] <= 0.0f) slots[count++] = slot;
+    }
+    if (count == 0) return;
+
+    Quaternion orientations[BatchWidth];
+    XMMATRIX rotations[BatchWidth];
+    XMVECTOR angularVelocities[BatchWidth];
+    for (uint32_t n = 0; n < count; ++n) orientations[n] = m_Data[slots[n]].Orientation;
+
+    Quaternion::NormalizeBatch(orientations, count);   // Prevent drift
+    Quaternion::ToRotationMatrixBatch(orientations, rotations, count);
+
+    const XMVECTOR vdt = XMVectorReplicate(dt);
+    for (uint32_t lane = 0; lane < count; lane += 4)
+    {
+        //~ Short groups repeat their last body, which is then not stored
+        BodyData* data[4];
+        const XMMATRIX* rotation[4];
+        for (uint32_t n = 0; n < 4; ++n)
+        {
+            const uint32_t index = (std::min)(lane + n, count - 1);
+            data[n] = &m_Data[slots[index]];
+            rotation[n] = &rotations[index];
+        }
+
+        //~ r[i][j] and inertia[i][j] hold element (i, j) of the four bodies' matrices
+        XMVECTOR r[3][3];
+        XMVECTOR inertia[3][3];
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            const XMMATRIX rotationRow = XMMatrixTranspose(XMMATRIX(
+                rotation[0]->r[row], rotation[1]->r[row], rotation[2]->r[row], rotation[3]->r[row]));
+            const XMMATRIX inertiaRow = XMMatrixTranspose(XMMATRIX(
+                data[0]->InverseInertiaTensorLocal.r[row], data[1]->InverseInertiaTensorLocal.r[row],
+                data[2]->InverseInertiaTensorLocal.r[row], data[3]->InverseInertiaTensorLocal.r[row]));
+            for (uint32_t column = 0; column < 3; ++column)
+            {
+                r[row][column] = rotationRow.r[column];
+                inertia[row][column] = inertiaRow.r[column];
+            }
+        }
+
+        //~ World inverse inertia R * I * R^T
+        XMVECTOR rotatedInertia[3][3];
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            for (uint32_t j = 0; j < 3; ++j)
+            {
+                rotatedInertia[i][j] = XMVectorMultiplyAdd(r[i][0], inertia[0][j],
+                    XMVectorMultiplyAdd(r[i][1], inertia[1][j], XMVectorMultiply(r[i][2], inertia[2][j])));
+            }
+        }
+        XMMATRIX worldRows[3];
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            XMVECTOR world[3];
+            for (uint32_t j = 0; j < 3; ++j)
+            {
+                world[j] = XMVectorMultiplyAdd(rotatedInertia[i][0], r[j][0],
+                    XMVectorMultiplyAdd(rotatedInertia[i][1], r[j][1], XMVectorMultiply(rotatedInertia[i][2], r[j][2])));
+            }
+            worldRows[i] = XMMatrixTranspose(XMMATRIX(world[0], world[1], world[2], XMVectorZero()));
+        }
+
+        //~ w = (w + torque * I * dt) * damping^dt, with the local tensor as in IntegrateAngular
+        const XMMATRIX velocity = XMMatrixTranspose(XMMATRIX(
+            data[0]->AngularVelocity, data[1]->AngularVelocity, data[2]->AngularVelocity, data[3]->AngularVelocity));
+        const XMMATRIX torque = XMMatrixTranspose(XMMATRIX(
+            data[0]->TorqueAccum, data[1]->TorqueAccum, data[2]->TorqueAccum, data[3]->TorqueAccum));
+        const XMVECTOR damping = GetDampingFactors(XMVectorSet(data[0]->AngularDamping, data[1]->AngularDamping,
+            data[2]->AngularDamping, data[3]->AngularDamping), dt, dampingCache);
+        XMVECTOR w[3];
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            const XMVECTOR acceleration = XMVectorMultiplyAdd(torque.r[0], inertia[0][j],
+                XMVectorMultiplyAdd(torque.r[1], inertia[1][j], XMVectorMultiply(torque.r[2], inertia[2][j])));
+            w[j] = XMVectorMultiply(XMVectorMultiplyAdd(acceleration, vdt, velocity.r[j]), damping);
+        }
+        const XMMATRIX spin = XMMatrixTranspose(XMMATRIX(w[0], w[1], w[2], XMVectorZero()));
+
+        for (uint32_t n = 0; n < 4 && lane + n < count; ++n)
+        {
+            const uint32_t index = lane + n;
+            const uint32_t slot = slots[index];
+            BodyData& body = *data[n];
+
+            body.TransformMatrix = rotations[index];
+            body.TransformMatrix.r[3] = XMVectorSetW(m_Position.Get(slot), 1.0f);
+            body.InverseInertiaTensorWorld = XMMATRIX(worldRows[0].r[n], worldRows[1].r[n], worldRows[2].r[n],
+                body.InverseInertiaTensorLocal.r[3]);
+            angularVelocities[index] = spin.r[n];
+        }
+    }
+
+    Quaternion::IntegrateBatch(orientations, angularVelocities, spinningCount, dt);
+
+    for (uint32_t n = 0; n < count; ++n)
+    {
+        BodyData& data = m_Data[slots[n]];
+        data.Orientation = orientations[n];
+        if (n >= spinningCount) continue;
+
+        //~ Optional: sleep threshold
+        const XMVECTOR angularVelocity = angularVelocities[n];
+        data.AngularVelocity = XMVectorGetX(XMVector3LengthSq(angularVelocity)) < 1e-5f ? XMVectorZero() : angularVelocity;
+        data.TorqueAccum = XMVectorZero();
+    }
+}
+
+// Each XMVECTOR lane holds a different body: px = {p0.x, p1.x, p2.x, p3.x}. Two groups of four
+// cover one BatchWidth block. Lanes that must not move (free slots, static or unsimulated
+// bodies) are computed anyway and masked out on store.
+void RigidBodyPool::IntegrateLinearBatch(uint32_t first, float dt, IntegrationType type, DampingCache& dampingCache)
+{
+    using namespace DirectX;
+
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR vdt = XMVectorReplicate(dt);
+    const XMVECTOR restThreshold = XMVectorReplicate(1e-5f);
+
+    for (uint32_t i = first; i < first + BatchWidth; i += 4)
+    {
+        const auto enabled = [this](uint32_t s) -> uint32_t
+        {
+            return m_Active[s] && m_Simulated[s] && !m_Sleeping[s] && m_InverseMass[s] > 0.0f;
+        };
+        const uint32_t e0 = enabled(i), e1 = enabled(i + 1), e2 = enabled(i + 2), e3 = enabled(i + 3);
+        if (!(e0 | e1 | e2 | e3)) continue;
+        const XMVECTOR mask = XMVectorSelectControl(e0, e1, e2, e3);
+
+        XMVECTOR px = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Position.X[i]));
+        XMVECTOR py = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Position.Y[i]));
+        XMVECTOR pz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Position.Z[i]));
+        XMVECTOR vx = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Velocity.X[i]));
+        XMVECTOR vy = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Velocity.Y[i]));
+        XMVECTOR vz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Velocity.Z[i]));
+        const XMVECTOR invMass = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_InverseMass[i]));
+        const XMVECTOR damping = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_LinearDamping[i]));
+
+        //~ a = acceleration + force / m
+        XMVECTOR ax = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_ForceAccum.X[i])), invMass,
+            XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Acceleration.X[i])));
+        XMVECTOR ay = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_ForceAccum.Y[i])), invMass,
+            XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Acceleration.Y[i])));
+        XMVECTOR az = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_ForceAccum.Z[i])), invMass,
+            XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Acceleration.Z[i])));
+
+        XMVECTOR newPx, newPy, newPz;
+        switch (type)
+        {
+        case IntegrationType::Euler:
+            newPx = XMVectorMultiplyAdd(vx, vdt, px);
+            newPy = XMVectorMultiplyAdd(vy, vdt, py);
+            newPz = XMVectorMultiplyAdd(vz, vdt, pz);
+            vx = XMVectorMultiplyAdd(ax, vdt, vx);
+            vy = XMVectorMultiplyAdd(ay, vdt, vy);
+            vz = XMVectorMultiplyAdd(az, vdt, vz);
+            break;
+        case IntegrationType::SemiImplicitEuler:
+            vx = XMVectorMultiplyAdd(ax, vdt, vx);
+            vy = XMVectorMultiplyAdd(ay, vdt, vy);
+            vz = XMVectorMultiplyAdd(az, vdt, vz);
+            newPx = XMVectorMultiplyAdd(vx, vdt, px);
+            newPy = XMVectorMultiplyAdd(vy, vdt, py);
+            newPz = XMVectorMultiplyAdd(vz, vdt, pz);
+            break;
+        case IntegrationType::Verlet:
+        default:
+        {
+            //~ Clamp |a| to 100
+            const XMVECTOR lenSq = XMVectorMultiplyAdd(ax, ax, XMVectorMultiplyAdd(ay, ay, XMVectorMultiply(az, az)));
+            const XMVECTOR tooLong = XMVectorGreater(lenSq, XMVectorReplicate(100.0f * 100.0f));
+            const XMVECTOR scale = XMVectorSelect(XMVectorSplatOne(),
+                XMVectorMultiply(XMVectorReplicate(100.0f), XMVectorReciprocalSqrt(lenSq)), tooLong);
+            ax = XMVectorMultiply(ax, scale);
+            ay = XMVectorMultiply(ay, scale);
+            az = XMVectorMultiply(az, scale);
+
+            const XMVECTOR lastX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_LastPosition.X[i]));
+            const XMVECTOR lastY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_LastPosition.Y[i]));
+            const XMVECTOR lastZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_LastPosition.Z[i]));
+
+            const XMVECTOR dx = XMVectorSubtract(px, lastX);
+            const XMVECTOR dy = XMVectorSubtract(py, lastY);
+            const XMVECTOR dz = XMVectorSubtract(pz, lastZ);
+            const XMVECTOR dt2 = XMVectorReplicate(dt * dt);
+
+            newPx = XMVectorAdd(px, XMVectorMultiplyAdd(ax, dt2, dx));
+            newPy = XMVectorAdd(py, XMVectorMultiplyAdd(ay, dt2, dy));
+            newPz = XMVectorAdd(pz, XMVectorMultiplyAdd(az, dt2, dz));
+
+            const XMVECTOR invDt = XMVectorReplicate(1.0f / dt);
+            vx = XMVectorMultiply(dx, invDt);
+            vy = XMVectorMultiply(dy, invDt);
+            vz = XMVectorMultiply(dz, invDt);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_LastPosition.X[i]), XMVectorSelect(lastX, px, mask));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_LastPosition.Y[i]), XMVectorSelect(lastY, py, mask));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_LastPosition.Z[i]), XMVectorSelect(lastZ, pz, mask));
+            break;
+        }
+        }
+
+        //~ v *= damping^dt, then snap tiny velocities to rest
+        const XMVECTOR damp = GetDampingFactors(damping, dt, dampingCache);
+        vx = XMVectorMultiply(vx, damp);
+        vy = XMVectorMultiply(vy, damp);
+        vz = XMVectorMultiply(vz, damp);
+
+        const XMVECTOR speedSq = XMVectorMultiplyAdd(vx, vx, XMVectorMultiplyAdd(vy, vy, XMVectorMultiply(vz, vz)));
+        const XMVECTOR resting = XMVectorLess(speedSq, restThreshold);
+        vx = XMVectorSelect(vx, zero, resting);
+        vy = XMVectorSelect(vy, zero, resting);
+        vz = XMVectorSelect(vz, zero, resting);
+
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_Position.X[i]), XMVectorSelect(px, newPx, mask));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_Position.Y[i]), XMVectorSelect(py, newPy, mask));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_Position.Z[i]), XMVectorSelect(pz, newPz, mask));
+
+        const XMVECTOR oldVx = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Velocity.X[i]));
+        const XMVECTOR oldVy = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Velocity.Y[i]));
+        const XMVECTOR oldVz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Velocity.Z[i]));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_Velocity.X[i]), XMVectorSelect(oldVx, vx, mask));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_Velocity.Y[i]), XMVectorSelect(oldVy, vy, mask));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_Velocity.Z[i]), XMVectorSelect(oldVz, vz, mask));
+
+        //~ ClearAccumulators for the bodies that moved
+        float* forces[3] = { &m_ForceAccum.X[i], &m_ForceAccum.Y[i], &m_ForceAccum.Z[i] };
+        for (float* force : forces)
+        {
+            const XMVECTOR old = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(force));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(force), XMVectorSelect(old, zero, mask));
+        }
+    }
+}
+
+void RigidBodyPool::IntegrateLinear(uint32_t slot, float dt, IntegrationType type)
+{
+    using namespace DirectX;
+
+    XMVECTOR pos = m_Position.Get(slot);
+    XMVECTOR vel = m_Velocity.Get(slot);
+    XMVECTOR acceleration = XMVectorAdd(m_Acceleration.Get(slot),
+        XMVectorScale(m_ForceAccum.Get(slot), m_InverseMass[slot]));
+
+    switch (type)
+    {
+    case IntegrationType::Euler:
+        pos = XMVectorAdd(pos, XMVectorScale(vel, dt));
+        vel = XMVectorAdd(vel, XMVectorScale(acceleration, dt));
+        break;
+    case IntegrationType::SemiImplicitEuler:
+        vel = XMVectorAdd(vel, XMVectorScale(acceleration, dt));
+        pos = XMVectorAdd(pos, XMVectorScale(vel, dt));
+        break;
+    case IntegrationType::Verlet:
+    {
+        const XMVECTOR lenSq = XMVector3LengthSq(acceleration);
+        if (XMVectorGetX(lenSq) > 100.0f * 100.0f)
+        {
+            acceleration = XMVectorScale(acceleration, 100.0f / std::sqrt(XMVectorGetX(lenSq)));
+        }
+
+        const XMVECTOR posDelta = XMVectorSubtract(pos, m_LastPosition.Get(slot));
+        const XMVECTOR newPos = XMVectorAdd(pos, XMVectorAdd(posDelta, XMVectorScale(acceleration, dt * dt)));
+
+        vel = XMVectorScale(posDelta, 1.0f / dt);
+        m_LastPosition.Set(slot, pos);
+        pos = newPos;
+        break;
+    }
+    }
+
+    vel = XMVectorScale(vel, std::pow(m_LinearDamping[slot], dt));
+    if (XMVectorGetX(XMVector3LengthSq(vel)) < 1e-5f) vel = XMVectorZero();
+
+    m_Position.Set(slot, pos);
+    m_Velocity.Set(slot, vel);
+}
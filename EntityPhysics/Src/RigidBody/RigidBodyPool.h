@@ -0,0 +1,194 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "Quaternion/Quaternion.h"
+#include "IntegrationType.h"
+#include "TransformSnapshot.h"
+
+class WorkerPool;
+class StateReader;
+class StateWriter;
+
+// Three float arrays (x, y, z) so a single XMVECTOR load picks one component of four bodies
+struct SoAVector3
+{
+    std::vector<float> X{};
+    std::vector<float> Y{};
+    std::vector<float> Z{};
+
+    DirectX::XMVECTOR Get(uint32_t index) const
+    {
+        return DirectX::XMVectorSet(X[index], Y[index], Z[index], 0.0f);
+    }
+
+    void Set(uint32_t index, const DirectX::XMVECTOR& value)
+    {
+        X[index] = DirectX::XMVectorGetX(value);
+        Y[index] = DirectX::XMVectorGetY(value);
+        Z[index] = DirectX::XMVectorGetZ(value);
+    }
+
+    void Resize(size_t count)
+    {
+        X.resize(count, 0.0f);
+        Y.resize(count, 0.0f);
+        Z.resize(count, 0.0f);
+    }
+};
+
+// Owns the state of every RigidBody.
+// The linear state that the integrator touches every step lives in structure-of-arrays form,
+// so IntegrateAll can advance 8 bodies per iteration with two XMVECTORs per component. The
+// rest (orientation, inertia, material) is per body data; IntegrateAll transposes the rotation
+// and inertia work of each 8 body block into the same lane layout on the fly.
+// RigidBody only stores a slot index into this pool.
+// There is one pool per process, and the whole-pool passes (IntegrateAll, PublishTransforms,
+// SaveState) and the IslandManager walk every slot in it, so a single PhysicsWorld owns it.
+class RigidBodyPool
+{
+public:
+    static constexpr uint32_t InvalidSlot = 0xFFFFFFFFu;
+    static constexpr uint32_t BatchWidth = 8;
+
+    static RigidBodyPool* Get();
+
+    ~RigidBodyPool() = default;
+
+    RigidBodyPool(const RigidBodyPool&) = delete;
+    RigidBodyPool(RigidBodyPool&&) = delete;
+    RigidBodyPool& operator=(const RigidBodyPool&) = delete;
+    RigidBodyPool& operator=(RigidBodyPool&&) = delete;
+
+    uint32_t Allocate();
+    uint32_t Clone(uint32_t source);
+    void Release(uint32_t slot);
+
+    //~ Advances every awake simulated body with finite mass, split over 'workers' when given.
+    //~ Returns how many bodies that was.
+    uint32_t IntegrateAll(float dt, IntegrationType type, WorkerPool* workers = nullptr);
+
+    //~ Single body path, used by RigidBody::Integrate
+    void Integrate(uint32_t slot, float dt, IntegrationType type);
+
+    //~ Copies every live pose (and the one published before it) into the snapshot back buffer
+    //~ and publishes it (end of a step)
+    void PublishTransforms();
+    TransformSnapshot& GetSnapshot() { return m_Snapshot; }
+
+    //~ Kinematic bodies are moved by the game rather than by forces and contacts. They have
+    //~ infinite mass in the solver and never sleep, and what rests on them sees their velocity,
+    //~ so it is carried along by friction instead of being pushed out of them every step.
+    //~ The mass they had is kept for when they turn dynamic again.
+    void SetKinematic(uint32_t slot, bool kinematic);
+    bool IsKinematic(uint32_t slot) const { return m_Data[slot].Kinematic; }
+
+    //~ Pose a kinematic body reaches by the end of the next step. It gets the velocity that takes
+    //~ it there for that step and stops at the target on the steps after, until a new target (or
+    //~ SetVelocity) moves it again.
+    void SetKinematicTarget(uint32_t slot, const DirectX::XMVECTOR& position, const Quaternion& orientation);
+
+    //~ True for a kinematic body that moved in the last step or has a target for the next one
+    bool IsKinematicMoving(uint32_t slot) const;
+
+    //~ Sleeping bodies keep their pose but are skipped by IntegrateAll until woken
+    void SetSleeping(uint32_t slot, bool sleeping);
+    bool IsSleeping(uint32_t slot) const { return m_Sleeping[slot] != 0; }
+
+    //~ True for bodies the island pass may put to sleep (live, simulated, finite mass)
+    bool CanSleep(uint32_t slot) const;
+
+    //~ Adds dt to the time the body has been slower than both thresholds (or resets it) and returns it
+    float UpdateSleepTime(uint32_t slot, float dt, float linearThreshold, float angularThreshold);
+
+    //~ Every body's state in a handful of array copies, for rollback. A state only restores
+    //~ into a pool with the same live and simulated slots as when it was saved (false otherwise,
+    //~ untouched). CheckState consumes the same bytes as RestoreState without writing anything.
+    void SaveState(StateWriter& writer) const;
+    bool CheckState(StateReader& reader) const;
+    bool RestoreState(StateReader& reader);
+
+    size_t GetActiveCount() const { return m_ActiveCount; }
+    size_t GetCapacity() const { return m_Active.size(); }
+
+private:
+    RigidBodyPool() = default;
+
+    struct BodyData
+    {
+        Quaternion Orientation{ 1.0f, 0.0f, 0.0f, 0.0f };
+        DirectX::XMVECTOR AngularVelocity{ DirectX::XMVectorZero() };
+        DirectX::XMVECTOR TorqueAccum{ DirectX::XMVectorZero() };
+        DirectX::XMMATRIX InverseInertiaTensorLocal{ DirectX::XMMatrixIdentity() };
+        DirectX::XMMATRIX InverseInertiaTensorWorld{ DirectX::XMMatrixIdentity() };
+        DirectX::XMMATRIX TransformMatrix{ DirectX::XMMatrixIdentity() };
+        float AngularDamping{ 0.39f };
+        float Elastic{ 0.56f };
+        float Restitution{ 0.35f };
+        float Friction{ 0.38f };
+        float SleepTime{ 0.0f };
+        float DynamicInverseMass{ 1.0f };   //~ what m_InverseMass goes back to when no longer kinematic
+        DirectX::XMFLOAT3 KinematicPosition{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT4 KinematicOrientation{ 0.0f, 0.0f, 0.0f, 1.0f };
+        bool Kinematic{ false };
+        bool HasKinematicTarget{ false };
+        bool KinematicArrived{ false };     //~ reached its target last step, stops on the next
+        bool ContinuousCollision{ false };
+    };
+
+    void Grow();
+
+    //~ The slots a state belongs to, and the bytes per slot that follow them
+    bool ReadStateSlots(StateReader& reader) const;
+    static constexpr size_t SlotStateSize = sizeof(float) * 17 + sizeof(uint8_t) * 2
+        + sizeof(BodyTransform) + sizeof(BodyData);
+    void ResetSlot(uint32_t slot);
+
+    uint32_t IntegrateRange(uint32_t firstBatch, uint32_t endBatch, float dt, IntegrationType type);
+
+    void CalculateDerivedData(uint32_t slot);
+    void IntegrateAngular(uint32_t slot, float dt);
+    void PrepareVerlet(uint32_t slot, float dt);
+    void IntegrateKinematic(uint32_t slot, float dt);
+
+    //~ damping^dt for four lanes. Most bodies share their damping, so the last power is kept
+    //~ and reused whenever all four lanes have that damping.
+    struct DampingCache
+    {
+        float Damping{ -1.0f };
+        float DeltaTime{ 0.0f };
+        float Factor{ 1.0f };
+    };
+    static DirectX::XMVECTOR GetDampingFactors(const DirectX::XMVECTOR& damping, float dt, DampingCache& cache);
+
+    void IntegrateAngularBatch(uint32_t first, float dt, DampingCache& dampingCache);
+    void IntegrateLinearBatch(uint32_t first, float dt, IntegrationType type, DampingCache& dampingCache);
+    void IntegrateLinear(uint32_t slot, float dt, IntegrationType type);
+
+    friend class RigidBody;
+
+private:
+    //~ Hot, structure of arrays (capacity is always a multiple of BatchWidth)
+    SoAVector3 m_Position{};
+    SoAVector3 m_LastPosition{};
+    SoAVector3 m_Velocity{};
+    SoAVector3 m_Acceleration{};
+    SoAVector3 m_ForceAccum{};
+    std::vector<float> m_InverseMass{};
+    std::vector<float> m_LinearDamping{};
+
+    //~ Cold, one entry per slot
+    std::vector<BodyData> m_Data{};
+
+    std::vector<uint8_t> m_Active{};
+    std::vector<uint8_t> m_Simulated{};
+    std::vector<uint8_t> m_VerletNeedsReset{};
+    std::vector<uint8_t> m_Sleeping{};
+
+    std::vector<uint32_t> m_FreeSlots{};
+    size_t m_ActiveCount{ 0 };
+
+    TransformSnapshot m_Snapshot{};
+    std::vector<BodyTransform> m_LastPublished{};   //~ writer side copy of the previous step
+};
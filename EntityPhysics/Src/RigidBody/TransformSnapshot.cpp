@@ -0,0 +1,25 @@
+#include "pch.h"
+#include "TransformSnapshot.h"
+
+
+void TransformSnapshot::Publish()
+{
+    const uint8_t previous = m_Ready.exchange(static_cast<uint8_t>(m_Back | FreshBit), std::memory_order_acq_rel);
+    m_Back = previous & IndexMask;
+}
+
+bool TransformSnapshot::AcquireLatest()
+{
+    if (!(m_Ready.load(std::memory_order_relaxed) & FreshBit)) return false;
+
+    const uint8_t previous = m_Ready.exchange(m_Front, std::memory_order_acq_rel);
+    m_Front = previous & IndexMask;
+    return true;
+}
+
+const BodyTransform* TransformSnapshot::TryGet(uint32_t slot) const
+{
+    const std::vector<BodyTransform>& front = m_Buffers[m_Front];
+    if (slot >= front.size() || !front[slot].IsValid) return nullptr;
+    return &front[slot];
+}
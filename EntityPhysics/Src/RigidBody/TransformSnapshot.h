@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "Quaternion/Quaternion.h"
+
+
+// Pose of one body as seen by the renderer, along with its pose one step earlier
+struct BodyTransform
+{
+    DirectX::XMFLOAT3 Position{ 0.0f, 0.0f, 0.0f };
+    uint32_t IsValid{ 0 };
+    DirectX::XMFLOAT4 Orientation{ 0.0f, 0.0f, 0.0f, 1.0f };   //~ quaternion, x y z w
+    DirectX::XMFLOAT3 PreviousPosition{ 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT4 PreviousOrientation{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+    DirectX::XMVECTOR GetPosition() const { return DirectX::XMLoadFloat3(&Position); }
+    DirectX::XMVECTOR GetOrientation() const { return DirectX::XMLoadFloat4(&Orientation); }
+    DirectX::XMMATRIX ToRotationMatrix() const { return DirectX::XMMatrixRotationQuaternion(GetOrientation()); }
+    Quaternion ToQuaternion() const { return { Orientation.w, Orientation.x, Orientation.y, Orientation.z }; }
+
+    //~ Pose 'alpha' of the way from the previous step to this one (1 = this step)
+    BodyTransform Interpolated(float alpha) const
+    {
+        using namespace DirectX;
+
+        BodyTransform result = *this;
+        XMStoreFloat3(&result.Position, XMVectorLerp(XMLoadFloat3(&PreviousPosition), GetPosition(), alpha));
+        XMStoreFloat4(&result.Orientation, XMQuaternionSlerp(XMLoadFloat4(&PreviousOrientation), GetOrientation(), alpha));
+        return result;
+    }
+};
+
+// Triple buffered body transforms, indexed by pool slot.
+// The physics side fills the back buffer and publishes it with one atomic exchange, the
+// render side swaps in the newest published buffer once per frame and then reads it with
+// no synchronisation at all. Neither side ever waits for the other, and a reader always
+// sees positions and orientations from the same step.
+// With a fixed step the writer also hands over how far the frame has run into the next
+// step, so the reader can blend each body between its last two poses.
+class TransformSnapshot
+{
+public:
+    TransformSnapshot() = default;
+    ~TransformSnapshot() = default;
+
+    TransformSnapshot(const TransformSnapshot&) = delete;
+    TransformSnapshot(TransformSnapshot&&) = delete;
+    TransformSnapshot& operator=(const TransformSnapshot&) = delete;
+    TransformSnapshot& operator=(TransformSnapshot&&) = delete;
+
+    //~ Writer: the buffer to fill for the step being published
+    std::vector<BodyTransform>& GetBackBuffer() { return m_Buffers[m_Back]; }
+    void Publish();
+
+    //~ Reader: adopt the latest published buffer, returns false if nothing new arrived
+    bool AcquireLatest();
+    const std::vector<BodyTransform>& GetFrontBuffer() const { return m_Buffers[m_Front]; }
+    const BodyTransform* TryGet(uint32_t slot) const;
+
+    //~ Blend factor between the previous and the latest step, written once per frame
+    void SetInterpolationAlpha(float alpha) { m_InterpolationAlpha.store(alpha, std::memory_order_relaxed); }
+    float GetInterpolationAlpha() const { return m_InterpolationAlpha.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint8_t IndexMask = 0x3;
+    static constexpr uint8_t FreshBit = 0x4;
+
+    std::array<std::vector<BodyTransform>, 3> m_Buffers{};
+    uint8_t m_Back{ 0 };                       //~ owned by the writer
+    uint8_t m_Front{ 1 };                      //~ owned by the reader
+    std::atomic<uint8_t> m_Ready{ 2 };         //~ handed over between them
+    std::atomic<float> m_InterpolationAlpha{ 1.0f };
+};
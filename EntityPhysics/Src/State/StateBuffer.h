@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+// Flat byte buffer behind PhysicsSystem::SaveState. Values go in as their raw bytes, so a
+// state only means something to the same build on the same machine, which is all rollback
+// and replays within one session need.
+class StateWriter
+{
+public:
+    explicit StateWriter(std::vector<uint8_t>& buffer) : m_Buffer(buffer) {}
+
+    template<typename T>
+    void Write(const T& value) { WriteArray(&value, 1); }
+
+    template<typename T>
+    void WriteArray(const T* values, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (count == 0) return;
+
+        const size_t offset = m_Buffer.size();
+        m_Buffer.resize(offset + sizeof(T) * count);
+        std::memcpy(m_Buffer.data() + offset, values, sizeof(T) * count);
+    }
+
+    //~ Element count first, so the reader can size the vector
+    template<typename T>
+    void WriteVector(const std::vector<T>& values)
+    {
+        Write(static_cast<uint64_t>(values.size()));
+        WriteArray(values.data(), values.size());
+    }
+
+private:
+    std::vector<uint8_t>& m_Buffer;
+};
+
+// Reads back what a StateWriter wrote, in the same order. Every read checks the remaining
+// size and fails (returns false) instead of running off the end of a truncated buffer.
+class StateReader
+{
+public:
+    StateReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    template<typename T>
+    bool Read(T& value) { return ReadArray(&value, 1); }
+
+    template<typename T>
+    bool ReadArray(T* values, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (count > GetRemaining() / sizeof(T)) return false;
+        if (count == 0) return true;
+
+        std::memcpy(values, m_Data + m_Offset, sizeof(T) * count);
+        m_Offset += sizeof(T) * count;
+        return true;
+    }
+
+    //~ Consumes the values only when they equal 'expected', for checking a state fits
+    template<typename T>
+    bool ReadEqual(const T* expected, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (count > GetRemaining() / sizeof(T)) return false;
+        if (count == 0) return true;
+        if (std::memcmp(expected, m_Data + m_Offset, sizeof(T) * count) != 0) return false;
+
+        m_Offset += sizeof(T) * count;
+        return true;
+    }
+
+    //~ Steps over 'size' bytes, for checking a state without restoring it
+    bool Skip(size_t size)
+    {
+        if (size > GetRemaining()) return false;
+
+        m_Offset += size;
+        return true;
+    }
+
+    template<typename T>
+    bool ReadVector(std::vector<T>& values)
+    {
+        uint64_t count = 0;
+        if (!Read(count) || count > GetRemaining() / sizeof(T)) return false;
+
+        values.resize(static_cast<size_t>(count));
+        return ReadArray(values.data(), values.size());
+    }
+
+    size_t GetRemaining() const { return m_Size - m_Offset; }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Offset{ 0 };
+};
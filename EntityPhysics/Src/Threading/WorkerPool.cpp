@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+    if (threadCount == 0) threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    const uint32_t workerCount = threadCount - 1;
+
+    m_Threads.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        //~ Index 0 is the thread that calls ParallelFor
+        m_Threads.emplace_back(&WorkerPool::WorkerLoop, this, i + 1);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WorkAvailable.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+void WorkerPool::Dispatch(uint32_t count, uint32_t grainSize, void* context, TaskFn task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Context = context;
+        m_Task = task;
+        m_Count = count;
+        m_GrainSize = grainSize;
+        m_NextIndex.store(0, std::memory_order_relaxed);
+        m_BusyWorkers = static_cast<uint32_t>(m_Threads.size());
+        ++m_Generation;
+    }
+    m_WorkAvailable.notify_all();
+
+    ExecuteChunks(0);
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_WorkDone.wait(lock, [this] { return m_BusyWorkers == 0; });
+    m_Task = nullptr;
+    m_Context = nullptr;
+}
+
+void WorkerPool::ExecuteChunks(uint32_t threadIndex)
+{
+    while (true)
+    {
+        const uint32_t begin = m_NextIndex.fetch_add(m_GrainSize, std::memory_order_relaxed);
+        if (begin >= m_Count) break;
+
+        const uint32_t end = (std::min)(begin + m_GrainSize, m_Count);
+        m_Task(m_Context, begin, end, threadIndex);
+    }
+}
+
+void WorkerPool::WorkerLoop(uint32_t threadIndex)
+{
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WorkAvailable.wait(lock, [&] { return m_Stop || m_Generation != seenGeneration; });
+            if (m_Stop) return;
+            seenGeneration = m_Generation;
+        }
+
+        ExecuteChunks(threadIndex);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_BusyWorkers == 0) m_WorkDone.notify_one();
+    }
+}
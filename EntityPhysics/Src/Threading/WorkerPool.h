@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+// Fixed set of worker threads for the data parallel parts of a physics step.
+// ParallelFor hands out [begin, end) chunks of an index range from a shared counter; the
+// calling thread works on chunks too and the call returns once the whole range is done.
+// Which thread runs which chunk is not deterministic, so callers write results per index
+// (or per independent group) and merge them in index order afterwards.
+class WorkerPool
+{
+public:
+    //~ Threads including the caller: 1 runs everything inline, 0 uses every hardware thread
+    explicit WorkerPool(uint32_t threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    //~ Workers plus the calling thread; thread indices passed to tasks are below this
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Threads.size()) + 1; }
+
+    //~ fn(begin, end, threadIndex) for consecutive chunks of at most grainSize indices
+    template<typename Fn>
+    void ParallelFor(uint32_t count, uint32_t grainSize, Fn&& fn);
+
+private:
+    using TaskFn = void(*)(void* context, uint32_t begin, uint32_t end, uint32_t threadIndex);
+
+    void Dispatch(uint32_t count, uint32_t grainSize, void* context, TaskFn task);
+    void ExecuteChunks(uint32_t threadIndex);
+    void WorkerLoop(uint32_t threadIndex);
+
+private:
+    std::vector<std::thread> m_Threads{};
+    std::mutex m_Mutex{};
+    std::condition_variable m_WorkAvailable{};
+    std::condition_variable m_WorkDone{};
+
+    //~ Current job, written under m_Mutex before the generation is bumped
+    void* m_Context{ nullptr };
+    TaskFn m_Task{ nullptr };
+    uint32_t m_Count{ 0 };
+    uint32_t m_GrainSize{ 1 };
+    std::atomic<uint32_t> m_NextIndex{ 0 };
+
+    uint64_t m_Generation{ 0 };
+    uint32_t m_BusyWorkers{ 0 };
+    bool m_Stop{ false };
+};
+
+template <typename Fn>
+void WorkerPool::ParallelFor(uint32_t count, uint32_t grainSize, Fn&& fn)
+{
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+
+    //~ Not worth waking anyone
+    if (m_Threads.empty() || count <= grainSize)
+    {
+        fn(0u, count, 0u);
+        return;
+    }
+
+    using FnType = std::remove_reference_t<Fn>;
+    Dispatch(count, grainSize, const_cast<void*>(static_cast<const void*>(&fn)),
+        [](void* context, uint32_t begin, uint32_t end, uint32_t threadIndex)
+        {
+            (*static_cast<FnType*>(context))(begin, end, threadIndex);
+        });
+}
@@ -0,0 +1,503 @@
+#include "pch.h"
+#include "PhysicsWorld.h"
+#include "Broadphase/SweepAndPrune.h"
+#include "Collision/Cube/CubeCollider.h"
+#include "Constraint/Constraint.h"
+#include "RigidBody/RigidBodyPool.h"
+#include "State/StateBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+
+std::atomic<uint32_t> PhysicsWorld::s_LiveWorlds{ 0 };
+
+PhysicsWorld::PhysicsWorld()
+{
+    [[maybe_unused]] const uint32_t liveWorlds = s_LiveWorlds.fetch_add(1);
+    assert(liveWorlds == 0 && "Only one PhysicsWorld may exist at a time, the body pool is shared!");
+}
+
+PhysicsWorld::~PhysicsWorld()
+{
+    s_LiveWorlds.fetch_sub(1);
+}
+
+bool PhysicsWorld::AddObject(uint64_t key, ICollider* collider)
+{
+    if (!collider || !collider->GetRigidBody()) return false;
+
+    const auto it = FindObject(key);
+    if (it != m_Objects.end() && it->Key == key) return false;
+
+    RigidBody* body = collider->GetRigidBody();
+    m_Objects.insert(it, { key, body, collider });
+    m_CollidersDirty = true;
+    body->SetSimulated(true);
+    m_Broadphase->AddCollider(collider);
+    return true;
+}
+
+bool PhysicsWorld::RemoveObject(uint64_t key)
+{
+    const auto it = FindObject(key);
+    if (it == m_Objects.end() || it->Key != key) return false;
+
+    const ICollider* collider = it->Collider;
+    m_Broadphase->RemoveCollider(collider);
+    m_ContactManifolds.RemoveCollider(collider);
+    m_SeparatingAxes.RemoveCollider(collider);
+    m_TriggerPairs.RemoveCollider(collider);
+
+    it->Body->SetSimulated(false);
+    m_Objects.erase(it);
+    m_CollidersDirty = true;
+    return true;
+}
+
+void PhysicsWorld::Clear()
+{
+    m_Islands.WakeAll();
+    for (const ObjectEntry& entry : m_Objects)
+    {
+        entry.Body->SetSimulated(false);
+    }
+    m_Objects.clear();
+    m_Colliders.clear();
+    m_CollidersDirty = false;
+    m_Broadphase->Clear();
+    m_CandidatePairs.clear();
+    m_ContinuousCollision.Clear();
+    m_ContactManifolds.Clear();
+    m_SeparatingAxes.Clear();
+    m_TriggerPairs.Clear();
+    m_ActiveManifolds.clear();
+    m_Constraints.clear();
+    m_ActiveConstraints.clear();
+    m_JointedPairs.clear();
+    m_QueryWorld.store(nullptr);
+}
+
+bool PhysicsWorld::AddConstraint(Constraint* constraint)
+{
+    if (!constraint || !constraint->GetBodyA()) return false;
+    if (std::find(m_Constraints.begin(), m_Constraints.end(), constraint) != m_Constraints.end()) return false;
+
+    m_Constraints.push_back(constraint);
+    return true;
+}
+
+bool PhysicsWorld::RemoveConstraint(const Constraint* constraint)
+{
+    const auto it = std::find(m_Constraints.begin(), m_Constraints.end(), constraint);
+    if (it == m_Constraints.end()) return false;
+
+    m_Constraints.erase(it);
+    return true;
+}
+
+std::vector<PhysicsWorld::ObjectEntry>::iterator PhysicsWorld::FindObject(uint64_t key)
+{
+    return std::lower_bound(m_Objects.begin(), m_Objects.end(), key,
+        [](const ObjectEntry& entry, uint64_t value) { return entry.Key < value; });
+}
+
+void PhysicsWorld::SetBroadphase(BroadphaseType type)
+{
+    if (type == m_BroadphaseType) return;
+    m_BroadphaseType = type;
+
+    switch (type)
+    {
+    case BroadphaseType::SweepAndPrune: m_Broadphase = std::make_unique<SweepAndPrune>(); break;
+    case BroadphaseType::DynamicTree:   m_Broadphase = std::make_unique<DynamicTreeBroadphase>(); break;
+    }
+    m_Broadphase->SetCollisionMatrix(m_CollisionMatrix);
+
+    for (const ObjectEntry& entry : m_Objects)
+    {
+        m_Broadphase->AddCollider(entry.Collider);
+    }
+}
+
+void PhysicsWorld::SetLayerCollision(uint8_t layerA, uint8_t layerB, bool collides)
+{
+    m_CollisionMatrix.SetCollision(layerA, layerB, collides);
+    m_Broadphase->SetCollisionMatrix(m_CollisionMatrix);
+}
+
+void PhysicsWorld::SetCollisionMatrix(const CollisionMatrix& matrix)
+{
+    m_CollisionMatrix = matrix;
+    m_Broadphase->SetCollisionMatrix(m_CollisionMatrix);
+}
+
+void PhysicsWorld::SetThreadCount(uint32_t count)
+{
+    m_Workers = std::make_unique<WorkerPool>(count);
+}
+
+void PhysicsWorld::SaveState(std::vector<uint8_t>& outState) const
+{
+    outState.clear();
+    StateWriter writer(outState);
+    writer.Write(static_cast<uint64_t>(0));    //~ total size, filled in last
+
+    writer.Write(static_cast<uint64_t>(m_Objects.size()));
+    for (const ObjectEntry& entry : m_Objects)
+    {
+        writer.Write(entry.Key);
+    }
+
+    RigidBodyPool::Get()->SaveState(writer);
+    m_Islands.SaveState(writer);
+    m_ContactManifolds.SaveState(writer);
+    m_TriggerPairs.SaveState(writer);
+
+    //~ Each constraint's size first, so a different kind of joint in the same place is caught
+    writer.Write(static_cast<uint64_t>(m_Constraints.size()));
+    for (const Constraint* constraint : m_Constraints)
+    {
+        writer.Write(static_cast<uint64_t>(GetConstraintStateSize(constraint)));
+        constraint->SaveState(writer);
+    }
+
+    const uint64_t size = outState.size();
+    std::memcpy(outState.data(), &size, sizeof(size));
+}
+
+bool PhysicsWorld::RestoreState(const std::vector<uint8_t>& state)
+{
+    StateReader reader(state.data(), state.size());
+    uint64_t size = 0;
+    if (!reader.Read(size) || size != state.size()) return false;
+
+    //~ Parse the whole state into scratch copies first, so a state that does not fit this world
+    //~ (or is corrupt) is refused before anything is overwritten
+    if (!CheckState(reader)) return false;
+
+    //~ None of these can fail any more
+    bool restored = ReadObjectKeys(reader) && RigidBodyPool::Get()->RestoreState(reader)
+        && m_Islands.RestoreState(reader) && m_ContactManifolds.RestoreState(reader)
+        && m_TriggerPairs.RestoreState(reader);
+
+    uint64_t constraintCount = 0;
+    restored = restored && reader.Read(constraintCount);
+    for (Constraint* constraint : m_Constraints)
+    {
+        uint64_t constraintSize = 0;
+        restored = restored && reader.Read(constraintSize) && constraint->RestoreState(reader);
+    }
+
+    //~ Only hints for the box test, they never change a result
+    m_SeparatingAxes.Clear();
+    return restored;
+}
+
+bool PhysicsWorld::CheckState(StateReader reader) const
+{
+    IslandManager islands{};
+    ContactManifoldCache manifolds{};
+    TriggerPairCache triggerPairs{};
+    if (!ReadObjectKeys(reader) || !RigidBodyPool::Get()->CheckState(reader)) return false;
+    if (!islands.RestoreState(reader) || !manifolds.RestoreState(reader) || !triggerPairs.RestoreState(reader)) return false;
+
+    uint64_t constraintCount = 0;
+    if (!reader.Read(constraintCount) || constraintCount != m_Constraints.size()) return false;
+    for (const Constraint* constraint : m_Constraints)
+    {
+        const size_t expectedSize = GetConstraintStateSize(constraint);
+        uint64_t constraintSize = 0;
+        if (!reader.Read(constraintSize) || constraintSize != expectedSize || !reader.Skip(expectedSize)) return false;
+    }
+    return reader.GetRemaining() == 0;
+}
+
+bool PhysicsWorld::ReadObjectKeys(StateReader& reader) const
+{
+    uint64_t count = 0;
+    if (!reader.Read(count) || count != m_Objects.size()) return false;
+
+    return std::all_of(m_Objects.begin(), m_Objects.end(), [&](const ObjectEntry& entry)
+    {
+        return reader.ReadEqual(&entry.Key, 1);
+    });
+}
+
+size_t PhysicsWorld::GetConstraintStateSize(const Constraint* constraint)
+{
+    std::vector<uint8_t> state{};
+    StateWriter writer(state);
+    constraint->SaveState(writer);
+    return state.size();
+}
+
+void PhysicsWorld::Step(float deltaTime)
+{
+    m_Profiler.BeginStep(deltaTime);
+    Integrate(deltaTime);
+    UpdateBroadphase();
+    UpdateNarrowphase();
+    Resolve(deltaTime);
+    Publish();
+    m_Profiler.EndStep();
+}
+
+void PhysicsWorld::Integrate(float deltaTime)
+{
+    PhysicsProfiler::ScopedPhase phase(m_Profiler, PhysicsPhase::Integrate);
+
+    if (m_CollidersDirty)
+    {
+        m_Colliders.clear();
+        for (const ObjectEntry& entry : m_Objects)
+        {
+            m_Colliders.push_back(entry.Collider);
+        }
+        m_CollidersDirty = false;
+    }
+
+    for (ICollider* collider : m_Colliders)
+    {
+        //~ Update Collider
+        collider->Update(deltaTime);
+        m_ContinuousCollision.Track(collider);
+    }
+
+    //~ Update Rigid Bodies (every simulated body, batched over the pool)
+    m_Profiler.GetCurrent().BodiesIntegrated = RigidBodyPool::Get()->IntegrateAll(deltaTime, m_IntegrationType, m_Workers.get());
+
+    //~ Bodies flagged for CCD are swept from where they started and stopped at the first impact
+    m_ContinuousCollision.Resolve(*m_Broadphase);
+
+    //~ From the velocity the bodies leave the step with, before the broadphase reads the bounds
+    for (ICollider* collider : m_Colliders)
+    {
+        collider->UpdateSpeculativeDistance(deltaTime, m_SpeculativeMargin);
+    }
+}
+
+void PhysicsWorld::UpdateBroadphase()
+{
+    PhysicsProfiler::ScopedPhase phase(m_Profiler, PhysicsPhase::Broadphase);
+
+    m_Broadphase->Update();
+    m_Broadphase->FindOverlappingPairs(m_CandidatePairs);
+
+    //~ Jointed bodies do not collide with each other unless the constraint asks for it
+    GatherConstraints();
+    if (!m_JointedPairs.empty())
+    {
+        std::erase_if(m_CandidatePairs, [this](const ColliderPair& pair) { return IsJointed(pair.A, pair.B); });
+    }
+
+    //~ The broadphase's pair order depends on its history (tree shape, fat bounds), which a
+    //~ restored state does not bring back; the solver order has to come from the bodies alone
+    if (m_Deterministic)
+    {
+        auto slotOf = [](const ICollider* collider) { return collider->GetRigidBody()->GetSlot(); };
+        for (ColliderPair& pair : m_CandidatePairs)
+        {
+            if (slotOf(pair.B) < slotOf(pair.A)) std::swap(pair.A, pair.B);
+        }
+        std::sort(m_CandidatePairs.begin(), m_CandidatePairs.end(), [&slotOf](const ColliderPair& a, const ColliderPair& b)
+        {
+            if (slotOf(a.A) != slotOf(b.A)) return slotOf(a.A) < slotOf(b.A);
+            return slotOf(a.B) < slotOf(b.B);
+        });
+    }
+
+    PhysicsStepProfile& profile = m_Profiler.GetCurrent();
+    profile.CandidatePairs = static_cast<uint32_t>(m_CandidatePairs.size());
+    profile.Constraints = static_cast<uint32_t>(m_ActiveConstraints.size());
+}
+
+void PhysicsWorld::UpdateNarrowphase()
+{
+    PhysicsProfiler::ScopedPhase phase(m_Profiler, PhysicsPhase::Narrowphase);
+
+    //~ Only on overlapping bounds, and not between two resting colliders. Pairs are tested in
+    //~ parallel into per pair slots, then merged in pair order.
+    const uint32_t pairCount = static_cast<uint32_t>(m_CandidatePairs.size());
+    m_PairManifolds.resize(pairCount);
+    m_PairResults.resize(pairCount);
+    m_ThreadAxesTested.assign(m_Workers->GetThreadCount(), 0);
+
+    m_Workers->ParallelFor(pairCount, 64, [&](uint32_t begin, uint32_t end, uint32_t thread)
+    {
+        const uint64_t axesBefore = CubeCollider::GetAxesTested();
+
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const ColliderPair& pair = m_CandidatePairs[i];
+            if (IslandManager::IsResting(pair.A) && IslandManager::IsResting(pair.B))
+            {
+                m_PairResults[i] = PairResult::Resting;
+                continue;
+            }
+
+            ContactManifold& manifold = m_PairManifolds[i];
+            manifold.SeparatingAxis = m_SeparatingAxes.Find(pair.A, pair.B);
+            //~ Triggers report exact overlaps, solid pairs look ahead as far as both colliders move
+            const bool trigger = pair.A->GetColliderState() == ColliderState::Trigger ||
+                pair.B->GetColliderState() == ColliderState::Trigger;
+            manifold.SpeculativeMargin = trigger ? 0.0f
+                : pair.A->GetSpeculativeDistance() + pair.B->GetSpeculativeDistance();
+
+            const bool touching = pair.A->GenerateManifold(pair.B, manifold);
+            m_PairResults[i] = touching ? PairResult::Touching : PairResult::Separated;
+        }
+
+        m_ThreadAxesTested[thread] += CubeCollider::GetAxesTested() - axesBefore;
+    });
+
+    PhysicsStepProfile& profile = m_Profiler.GetCurrent();
+    m_ActiveManifolds.clear();
+    for (uint32_t i = 0; i < pairCount; ++i)
+    {
+        const ColliderPair& pair = m_CandidatePairs[i];
+        switch (m_PairResults[i])
+        {
+        case PairResult::Resting:
+            m_ContactManifolds.Keep(pair.A, pair.B);
+            m_TriggerPairs.Keep(pair.A, pair.B);
+            break;
+        case PairResult::Touching:
+            m_TriggerPairs.Add(pair.A, pair.B);
+            m_ActiveManifolds.push_back(&m_ContactManifolds.Update(m_PairManifolds[i]));
+            m_SeparatingAxes.Store(pair.A, pair.B, ContactManifold::NoAxis);
+            ++profile.PairsTested;
+            if (pair.A->GetColliderState() != ColliderState::Trigger && pair.B->GetColliderState() != ColliderState::Trigger)
+            {
+                ++profile.TouchingPairs;
+                profile.Contacts += m_ActiveManifolds.back()->PointCount;
+            }
+            break;
+        case PairResult::Separated:
+            m_SeparatingAxes.Store(pair.A, pair.B, m_PairManifolds[i].SeparatingAxis);
+            ++profile.PairsTested;
+            break;
+        }
+    }
+    m_ContactManifolds.Prune();
+    m_SeparatingAxes.Prune();
+
+    for (const uint64_t axes : m_ThreadAxesTested)
+    {
+        profile.SATAxesTested += axes;
+    }
+}
+
+void PhysicsWorld::Resolve(float deltaTime)
+{
+    PhysicsProfiler::ScopedPhase phase(m_Profiler, PhysicsPhase::Solve);
+
+    //~ Warm started from last step's impulses. Islands share no dynamic body, so solving them
+    //~ on different threads gives the same result.
+    m_Islands.BuildIslands(m_ActiveManifolds, m_ActiveConstraints);
+    m_ContactSolvers.resize(m_Workers->GetThreadCount());
+    for (ContactSolver& solver : m_ContactSolvers)
+    {
+        solver.ResetIterationsRun();
+    }
+
+    const auto& islands = m_Islands.GetContactIslands();
+    const auto& constraintIslands = m_Islands.GetConstraintIslands();
+    m_Workers->ParallelFor(m_Islands.GetContactIslandCount(), 4, [&](uint32_t begin, uint32_t end, uint32_t thread)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            m_ContactSolvers[thread].Solve(islands[i], constraintIslands[i], deltaTime);
+        }
+    });
+
+    //~ Put islands that came to rest to sleep
+    m_Islands.UpdateSleeping(deltaTime);
+
+    PhysicsStepProfile& profile = m_Profiler.GetCurrent();
+    profile.Islands = m_Islands.GetContactIslandCount();
+    for (const ContactSolver& solver : m_ContactSolvers)
+    {
+        profile.SolverIterations += solver.GetIterationsRun();
+    }
+}
+
+void PhysicsWorld::Publish()
+{
+    PhysicsProfiler::ScopedPhase phase(m_Profiler, PhysicsPhase::Publish);
+
+    //~ Hand the finished step to the renderer
+    RigidBodyPool::Get()->PublishTransforms();
+
+    //~ Trigger events are diffed against the previous step and their callbacks run only now
+    m_TriggerPairs.Flush();
+    m_TriggerPairs.Dispatch();
+
+    //~ And to the scene queries, readers still holding the previous snapshot keep it alive
+    m_QueryWorld.store(QueryWorld::Build(m_Colliders));
+}
+
+void PhysicsWorld::GatherConstraints()
+{
+    auto isResting = [](const RigidBody* body) { return !body || !body->HasFiniteMass() || body->GetRestingState(); };
+
+    m_ActiveConstraints.clear();
+    m_JointedPairs.clear();
+    for (Constraint* constraint : m_Constraints)
+    {
+        const RigidBody* bodyA = constraint->GetBodyA();
+        const RigidBody* bodyB = constraint->GetBodyB();
+        if (!constraint->IsEnabled() || !bodyA->IsSimulated() || (bodyB && !bodyB->IsSimulated())) continue;
+
+        if (bodyB && !constraint->GetCollideConnected()) m_JointedPairs.push_back(GetBodyPairKey(bodyA, bodyB));
+
+        //~ Both ends asleep (or static), nothing for the joint to do until something wakes them
+        if (isResting(bodyA) && isResting(bodyB)) continue;
+        m_ActiveConstraints.push_back(constraint);
+    }
+    std::sort(m_JointedPairs.begin(), m_JointedPairs.end());
+}
+
+bool PhysicsWorld::IsJointed(const ICollider* a, const ICollider* b) const
+{
+    const uint64_t key = GetBodyPairKey(a->GetRigidBody(), b->GetRigidBody());
+    return std::binary_search(m_JointedPairs.begin(), m_JointedPairs.end(), key);
+}
+
+uint64_t PhysicsWorld::GetBodyPairKey(const RigidBody* a, const RigidBody* b)
+{
+    const uint64_t slotA = a->GetSlot();
+    const uint64_t slotB = b->GetSlot();
+    return slotA < slotB ? (slotA << 32) | slotB : (slotB << 32) | slotA;
+}
+
+bool PhysicsWorld::Raycast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+    RaycastHit& outHit, uint32_t layerMask) const
+{
+    const std::shared_ptr<const QueryWorld> world = m_QueryWorld.load();
+    return world && world->Raycast(origin, direction, maxDistance, outHit, layerMask);
+}
+
+size_t PhysicsWorld::RaycastAll(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+    std::vector<RaycastHit>& outHits, uint32_t layerMask) const
+{
+    outHits.clear();
+    const std::shared_ptr<const QueryWorld> world = m_QueryWorld.load();
+    return world ? world->RaycastAll(origin, direction, maxDistance, outHits, layerMask) : 0;
+}
+
+bool PhysicsWorld::SphereCast(const DirectX::XMVECTOR& origin, float radius, const DirectX::XMVECTOR& direction,
+    float maxDistance, RaycastHit& outHit, uint32_t layerMask) const
+{
+    const std::shared_ptr<const QueryWorld> world = m_QueryWorld.load();
+    return world && world->SphereCast(origin, radius, direction, maxDistance, outHit, layerMask);
+}
+
+size_t PhysicsWorld::OverlapBox(const DirectX::XMVECTOR& center, const DirectX::XMVECTOR& halfExtents,
+    const DirectX::XMVECTOR& orientation, std::vector<ICollider*>& outColliders, uint32_t layerMask) const
+{
+    outColliders.clear();
+    const std::shared_ptr<const QueryWorld> world = m_QueryWorld.load();
+    return world ? world->OverlapBox(center, halfExtents, orientation, outColliders, layerMask) : 0;
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RigidBody/IntegrationType.h"
+#include "Collision/ICollider.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/ContinuousCollision.h"
+#include "Broadphase/IBroadphase.h"
+#include "Broadphase/DynamicTreeBroadphase.h"
+#include "Broadphase/CollisionMatrix.h"
+#include "CollisionResolver/ContactManifoldCache.h"
+#include "CollisionResolver/SeparatingAxisCache.h"
+#include "CollisionResolver/TriggerPairCache.h"
+#include "CollisionResolver/ContactSolver.h"
+#include "Island/IslandManager.h"
+#include "Query/QueryWorld.h"
+#include "Profiling/PhysicsProfiler.h"
+#include "Threading/WorkerPool.h"
+
+class Constraint;
+class StateReader;
+
+
+// The simulated set of colliders and constraints and the step that advances them: integration
+// (with continuous collision), broadphase, narrowphase, islands and the solver, then the
+// transform snapshot, trigger events and query world. It knows nothing about frames or
+// rendering; the PhysicsSystem drives it from the frame clock and the benchmark drives it
+// directly, so both run the same pipeline.
+// Objects are added under a caller chosen key and walked in key order, so a step does not
+// depend on the order they were added in.
+// The bodies live in the process wide RigidBodyPool: integration, islands, the transform
+// snapshot and SaveState cover every body in it, not just the ones added here. So only one
+// world may exist at a time (asserted in debug builds); tear one down before creating the next.
+class PhysicsWorld
+{
+public:
+    PhysicsWorld();
+    ~PhysicsWorld();
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld(PhysicsWorld&&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(PhysicsWorld&&) = delete;
+
+    //~ The collider and its body join the simulation. False for a null collider or a key already in use.
+    bool AddObject(uint64_t key, ICollider* collider);
+    bool RemoveObject(uint64_t key);
+    void Clear();
+    size_t GetObjectCount() const { return m_Objects.size(); }
+
+    //~ Joints between bodies, solved along with the contacts. The caller owns the constraint and
+    //~ keeps it alive until it is removed again (or Clear); it is skipped while either of its
+    //~ bodies is not simulated.
+    bool AddConstraint(Constraint* constraint);
+    bool RemoveConstraint(const Constraint* constraint);
+    const std::vector<Constraint*>& GetConstraints() const { return m_Constraints; }
+
+    //~ One step of 'deltaTime' seconds
+    void Step(float deltaTime);
+
+    void SetIntegration(IntegrationType type) { m_IntegrationType = type; }
+    void SetBroadphase(BroadphaseType type);
+
+    //~ Layer vs layer filter applied by the broadphase
+    void SetLayerCollision(uint8_t layerA, uint8_t layerB, bool collides);
+    void SetCollisionMatrix(const CollisionMatrix& matrix);
+    bool GetLayerCollision(uint8_t layerA, uint8_t layerB) const { return m_CollisionMatrix.ShouldCollide(layerA, layerB); }
+    const CollisionMatrix& GetCollisionMatrix() const { return m_CollisionMatrix; }
+
+    //~ Threads used by the step (including the calling one), 0 = every hardware thread.
+    //~ The result of a step does not depend on this.
+    void SetThreadCount(uint32_t count);
+    uint32_t GetThreadCount() const { return m_Workers->GetThreadCount(); }
+
+    //~ Pairs are solved in a fixed order (by body slot) rather than the broadphase's
+    void SetDeterministic(bool enabled) { m_Deterministic = enabled; }
+    bool IsDeterministic() const { return m_Deterministic; }
+
+    //~ Speculative contacts: moving colliders get contact points up to 'margin' plus one step of
+    //~ travel before they touch, and the solver lets such a pair close only its gap. A pair that
+    //~ would close its gap within the step bounces (restitution) from the speed it had before the
+    //~ solve, which turns it around up to one step of travel short of the surface. 0 turns it off.
+    void SetSpeculativeMargin(float margin) { m_SpeculativeMargin = (std::max)(margin, 0.0f); }
+    float GetSpeculativeMargin() const { return m_SpeculativeMargin; }
+
+    //~ Rollback: bodies, sleeping islands, cached contacts and constraint impulses (warm starting)
+    //~ and trigger pairs in one flat buffer. A state restores only while the same objects and
+    //~ constraints are in the world (and simulated) as when it was saved; anything else returns
+    //~ false and leaves the world as it was.
+    void SaveState(std::vector<uint8_t>& outState) const;
+    bool RestoreState(const std::vector<uint8_t>& state);
+
+    //~ Scene queries against the last completed step, safe to call from any thread (also while
+    //~ a step runs). 'layerMask' selects colliders by ICollider::GetLayerMask. See QueryWorld.
+    bool Raycast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+        RaycastHit& outHit, uint32_t layerMask = ICollider::AllLayers) const;
+    size_t RaycastAll(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+        std::vector<RaycastHit>& outHits, uint32_t layerMask = ICollider::AllLayers) const;
+    bool SphereCast(const DirectX::XMVECTOR& origin, float radius, const DirectX::XMVECTOR& direction,
+        float maxDistance, RaycastHit& outHit, uint32_t layerMask = ICollider::AllLayers) const;
+    size_t OverlapBox(const DirectX::XMVECTOR& center, const DirectX::XMVECTOR& halfExtents,
+        const DirectX::XMVECTOR& orientation, std::vector<ICollider*>& outColliders,
+        uint32_t layerMask = ICollider::AllLayers) const;
+
+    //~ Trigger enter / stay / exit events of the last step; SetTriggerTarget callbacks have already run
+    const std::vector<TriggerEvent>& GetTriggerEvents() const { return m_TriggerPairs.GetEvents(); }
+
+    //~ Holding on to the snapshot keeps several queries consistent with each other
+    std::shared_ptr<const QueryWorld> GetQueryWorld() const { return m_QueryWorld.load(); }
+
+    //~ Phase timings and counters of the last PhysicsProfiler::Capacity steps, on by default.
+    //~ Read them from the thread that runs the steps.
+    PhysicsProfiler& GetProfiler() { return m_Profiler; }
+    const PhysicsProfiler& GetProfiler() const { return m_Profiler; }
+
+private:
+    //~ The phases of Step, each one timed by the profiler
+    void Integrate(float deltaTime);
+    void UpdateBroadphase();
+    void UpdateNarrowphase();
+    void Resolve(float deltaTime);
+    void Publish();
+
+    //~ RestoreState parses the whole state (without restoring it) before it writes anything
+    bool CheckState(StateReader reader) const;
+    bool ReadObjectKeys(StateReader& reader) const;
+    static size_t GetConstraintStateSize(const Constraint* constraint);
+
+    //~ Constraints worth solving this step, and the body pairs they keep from colliding
+    void GatherConstraints();
+    bool IsJointed(const ICollider* a, const ICollider* b) const;
+    static uint64_t GetBodyPairKey(const RigidBody* a, const RigidBody* b);
+
+    struct ObjectEntry
+    {
+        uint64_t Key;
+        RigidBody* Body;
+        ICollider* Collider;
+    };
+
+    //~ First entry with a key not below 'key'
+    std::vector<ObjectEntry>::iterator FindObject(uint64_t key);
+
+    enum class PairResult : uint8_t
+    {
+        Separated,
+        Touching,
+        Resting,    //~ both asleep or static, not tested
+    };
+
+private:
+    IntegrationType m_IntegrationType{ IntegrationType::SemiImplicitEuler };
+    bool m_Deterministic{ false };
+    float m_SpeculativeMargin{ 0.05f };
+
+    //~ Sorted by key. The step walks the colliders as one dense array, rebuilt after objects come or go.
+    std::vector<ObjectEntry> m_Objects{};
+    std::vector<ICollider*> m_Colliders{};
+    bool m_CollidersDirty{ false };
+
+    //~ Broadphase
+    BroadphaseType m_BroadphaseType{ BroadphaseType::DynamicTree };
+    CollisionMatrix m_CollisionMatrix{};
+    std::unique_ptr<IBroadphase> m_Broadphase{ std::make_unique<DynamicTreeBroadphase>() };
+    std::vector<ColliderPair> m_CandidatePairs{};
+    ContinuousCollision m_ContinuousCollision{};
+
+    //~ Narrowphase / Solver
+    std::vector<ContactManifold> m_PairManifolds{};
+    std::vector<PairResult> m_PairResults{};
+    std::vector<uint64_t> m_ThreadAxesTested{};     //~ SAT axes per worker thread, this step
+    ContactManifoldCache m_ContactManifolds{};
+    SeparatingAxisCache m_SeparatingAxes{};         //~ written only in the serial merge
+    TriggerPairCache m_TriggerPairs{};
+    std::vector<ContactManifold*> m_ActiveManifolds{};
+    std::vector<ContactSolver> m_ContactSolvers{};  //~ one per thread
+    IslandManager m_Islands{};
+
+    //~ Constraints, in the order they were added
+    std::vector<Constraint*> m_Constraints{};
+    std::vector<Constraint*> m_ActiveConstraints{};
+    std::vector<uint64_t> m_JointedPairs{};         //~ sorted, lower body slot in the high half
+
+    //~ Queries
+    std::atomic<std::shared_ptr<const QueryWorld>> m_QueryWorld{};
+
+    PhysicsProfiler m_Profiler{};
+    std::unique_ptr<WorkerPool> m_Workers{ std::make_unique<WorkerPool>() };
+
+    static std::atomic<uint32_t> s_LiveWorlds;
+};
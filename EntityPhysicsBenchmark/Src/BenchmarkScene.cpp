@@ -0,0 +1,213 @@
+#include "BenchmarkScene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+
+BenchmarkScene BenchmarkScene::RandomBoxes(size_t count, unsigned int seed)
+{
+    BenchmarkScene scene{};
+    scene.m_Boxes.reserve(count);
+
+    // Keep the density constant (roughly one box per 8 cubic units)
+    const float side = 2.0f * std::cbrt(static_cast<float>(count));
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-0.5f * side, 0.5f * side);
+    std::uniform_real_distribution<float> angle(-DirectX::XM_PI, DirectX::XM_PI);
+    std::uniform_real_distribution<float> size(0.25f, 0.75f);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        BenchmarkBox box{};
+        box.Body = std::make_unique<RigidBody>();
+        box.Body->SetTranslation(position(rng), position(rng), position(rng));
+        box.Body->SetRotation(angle(rng), angle(rng), angle(rng));
+
+        box.Collider = std::make_unique<CubeCollider>(box.Body.get());
+        box.Collider->SetScale(DirectX::XMVectorSet(size(rng), size(rng), size(rng), 0.0f));
+        box.Collider->SetColliderState(ColliderState::Dynamic);
+
+        scene.m_Boxes.push_back(std::move(box));
+    }
+    return scene;
+}
+
+void BenchmarkScene::MakeStatic(float fraction)
+{
+    const size_t staticCount = static_cast<size_t>(fraction * static_cast<float>(m_Boxes.size()));
+    for (size_t i = 0; i < m_Boxes.size(); ++i)
+    {
+        m_Boxes[i].Collider->SetColliderState(i < staticCount ? ColliderState::Static : ColliderState::Dynamic);
+    }
+}
+
+void BenchmarkScene::Jitter(float amount, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> delta(-amount, amount);
+
+    for (BenchmarkBox& box : m_Boxes)
+    {
+        if (box.Collider->GetColliderState() == ColliderState::Static) continue;
+        box.Body->AddTranslation(delta(rng), delta(rng), delta(rng));
+    }
+}
+
+BenchmarkScene BenchmarkScene::Create(SceneType type, size_t count, unsigned int seed)
+{
+    BenchmarkScene scene{};
+    switch (type)
+    {
+    case SceneType::Pyramids:    scene.BuildPyramids(count); break;
+    case SceneType::RandomPile:  scene.BuildRandomPile(count, seed); break;
+    case SceneType::SparseField: scene.BuildSparseField(count, seed); break;
+    case SceneType::TriggerGrid: scene.BuildTriggerGrid(count, seed); break;
+    }
+    return scene;
+}
+
+const char* BenchmarkScene::GetName(SceneType type)
+{
+    switch (type)
+    {
+    case SceneType::Pyramids:    return "Pyramids";
+    case SceneType::RandomPile:  return "RandomPile";
+    case SceneType::SparseField: return "SparseField";
+    case SceneType::TriggerGrid: return "TriggerGrid";
+    }
+    return "Unknown";
+}
+
+BenchmarkBox& BenchmarkScene::AddBox(float x, float y, float z, const DirectX::XMVECTOR& halfExtents, ColliderState state)
+{
+    BenchmarkBox box{};
+    box.Body = std::make_unique<RigidBody>();
+    box.Body->SetTranslation(x, y, z);
+
+    box.Collider = std::make_unique<CubeCollider>(box.Body.get());
+    box.Collider->SetScale(halfExtents);
+    box.Collider->SetColliderState(state);
+
+    //~ Only dynamic boxes move, the rest are level geometry
+    if (state == ColliderState::Dynamic)
+    {
+        box.Body->SetSimulated(true);
+        box.Body->SetAcceleration(DirectX::XMVectorSet(0.0f, -9.8f, 0.0f, 0.0f));
+    }
+    else box.Body->SetInverseMass(0.0f);
+
+    m_Boxes.push_back(std::move(box));
+    return m_Boxes.back();
+}
+
+// Top face at y = 0
+void BenchmarkScene::AddGround(float halfWidth)
+{
+    AddBox(0.0f, -0.5f, 0.0f, DirectX::XMVectorSet(halfWidth, 0.5f, halfWidth, 0.0f), ColliderState::Static);
+}
+
+void BenchmarkScene::BuildPyramids(size_t count)
+{
+    constexpr size_t baseWidth = 10;
+    constexpr size_t stackHeight = 10;
+    constexpr size_t boxesPerPyramid = baseWidth * (baseWidth + 1) / 2 + stackHeight;
+    constexpr float spacing = 14.0f;
+
+    const size_t pyramids = (std::max)(size_t{ 1 }, (count + boxesPerPyramid - 1) / boxesPerPyramid);
+    const size_t perRow = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(pyramids))));
+    const float offset = 0.5f * spacing * static_cast<float>(perRow - 1);
+    AddGround(offset + spacing);
+
+    const DirectX::XMVECTOR halfExtents = DirectX::XMVectorSet(0.5f, 0.5f, 0.5f, 0.0f);
+    for (size_t pyramid = 0; pyramid < pyramids; ++pyramid)
+    {
+        const float centerX = spacing * static_cast<float>(pyramid % perRow) - offset;
+        const float centerZ = spacing * static_cast<float>(pyramid / perRow) - offset;
+
+        //~ Small gaps between the rows so the pyramid settles instead of starting interpenetrated
+        for (size_t row = 0; row < baseWidth; ++row)
+        {
+            const size_t width = baseWidth - row;
+            for (size_t column = 0; column < width; ++column)
+            {
+                const float x = centerX + static_cast<float>(column) - 0.5f * static_cast<float>(width - 1);
+                AddBox(x, 0.5f + 1.01f * static_cast<float>(row), centerZ, halfExtents, ColliderState::Dynamic);
+            }
+        }
+
+        //~ A single column beside the pyramid, the hardest case for the solver to bring to rest
+        for (size_t level = 0; level < stackHeight; ++level)
+        {
+            AddBox(centerX + 6.5f, 0.5f + 1.01f * static_cast<float>(level), centerZ, halfExtents, ColliderState::Dynamic);
+        }
+    }
+}
+
+void BenchmarkScene::BuildRandomPile(size_t count, unsigned int seed)
+{
+    //~ Dropped from a grid of cells a bit larger than the largest box, so nothing starts overlapping
+    constexpr float cell = 1.6f;
+    const size_t perSide = (std::max)(size_t{ 1 }, static_cast<size_t>(std::sqrt(static_cast<float>(count) / 4.0f)));
+    const float offset = 0.5f * cell * static_cast<float>(perSide - 1);
+    AddGround(offset + 20.0f);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    std::uniform_real_distribution<float> angle(-DirectX::XM_PI, DirectX::XM_PI);
+    std::uniform_real_distribution<float> size(0.25f, 0.6f);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t layer = i / (perSide * perSide);
+        const size_t inLayer = i % (perSide * perSide);
+        const float x = cell * static_cast<float>(inLayer % perSide) - offset + jitter(rng);
+        const float z = cell * static_cast<float>(inLayer / perSide) - offset + jitter(rng);
+        const float y = 1.0f + cell * static_cast<float>(layer);
+
+        BenchmarkBox& box = AddBox(x, y, z, DirectX::XMVectorSet(size(rng), size(rng), size(rng), 0.0f), ColliderState::Dynamic);
+        box.Body->SetRotation(angle(rng), angle(rng), angle(rng));
+    }
+}
+
+void BenchmarkScene::BuildSparseField(size_t count, unsigned int seed)
+{
+    const float halfWidth = 3.0f * std::sqrt(static_cast<float>(count));
+    AddGround(halfWidth + 1.0f);
+
+    //~ Resting on the ground from the start, far enough apart to rarely touch each other
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-halfWidth, halfWidth);
+    std::uniform_real_distribution<float> yaw(-DirectX::XM_PI, DirectX::XM_PI);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        BenchmarkBox& box = AddBox(position(rng), 0.5f, position(rng), DirectX::XMVectorSet(0.5f, 0.5f, 0.5f, 0.0f),
+            ColliderState::Dynamic);
+        box.Body->SetRotation(0.0f, yaw(rng), 0.0f);
+    }
+}
+
+void BenchmarkScene::BuildTriggerGrid(size_t count, unsigned int seed)
+{
+    //~ One trigger per falling box, each box drops through the trigger below it onto the ground
+    constexpr float spacing = 3.0f;
+    const size_t perSide = (std::max)(size_t{ 1 }, static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(count)))));
+    const float offset = 0.5f * spacing * static_cast<float>(perSide - 1);
+    AddGround(offset + spacing);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> height(6.0f, 12.0f);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float x = spacing * static_cast<float>(i % perSide) - offset;
+        const float z = spacing * static_cast<float>(i / perSide) - offset;
+
+        AddBox(x, 3.0f, z, DirectX::XMVectorSet(1.0f, 1.0f, 1.0f, 0.0f), ColliderState::Trigger);
+        AddBox(x + jitter(rng), height(rng), z + jitter(rng), DirectX::XMVectorSet(0.4f, 0.4f, 0.4f, 0.0f),
+            ColliderState::Dynamic);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RigidBody/RigidBody.h"
+#include "Collision/Cube/CubeCollider.h"
+
+
+// Owns a set of free-standing bodies/colliders so benchmarks can run without IRender
+struct BenchmarkBox
+{
+    std::unique_ptr<RigidBody> Body;
+    std::unique_ptr<CubeCollider> Collider;
+};
+
+// Simulated scenes, each on a static ground box and under gravity
+enum class SceneType : uint8_t
+{
+    Pyramids,       //~ 2D box pyramids side by side, a tall resting stack per pyramid
+    RandomPile,     //~ randomly sized and turned boxes dropped onto one heap
+    SparseField,    //~ boxes far apart on the ground, per body overhead with few contacts
+    TriggerGrid,    //~ boxes falling through a grid of trigger volumes
+};
+
+class BenchmarkScene
+{
+public:
+    // Random boxes inside a cube sized so every box has a handful of neighbours
+    static BenchmarkScene RandomBoxes(size_t count, unsigned int seed);
+
+    //~ Roughly 'count' boxes (ground and triggers not included) laid out as 'type'
+    static BenchmarkScene Create(SceneType type, size_t count, unsigned int seed);
+    static const char* GetName(SceneType type);
+
+    //~ Turns the first 'fraction' of the boxes into static level geometry
+    void MakeStatic(float fraction);
+
+    //~ Nudges every dynamic box
+    void Jitter(float amount, unsigned int seed);
+
+    std::vector<BenchmarkBox>& GetBoxes() { return m_Boxes; }
+    size_t GetCount() const { return m_Boxes.size(); }
+
+private:
+    BenchmarkBox& AddBox(float x, float y, float z, const DirectX::XMVECTOR& halfExtents, ColliderState state);
+    void AddGround(float halfWidth);
+
+    void BuildPyramids(size_t count);
+    void BuildRandomPile(size_t count, unsigned int seed);
+    void BuildSparseField(size_t count, unsigned int seed);
+    void BuildTriggerGrid(size_t count, unsigned int seed);
+
+private:
+    std::vector<BenchmarkBox> m_Boxes{};
+};
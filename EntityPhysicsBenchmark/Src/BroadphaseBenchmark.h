@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+#include "Broadphase/IBroadphase.h"
+
+
+namespace BroadphaseBenchmark
+{
+    // Prints pair counts and timings of a broadphase, checked against brute force when affordable.
+    // 'staticFraction' of the boxes is turned into static geometry that never moves.
+    // Returns false when the broadphase and brute force disagree on the pair count.
+    bool Run(BroadphaseType type, size_t boxCount, float staticFraction, int frames);
+}
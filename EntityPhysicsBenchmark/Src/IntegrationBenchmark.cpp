@@ -0,0 +1,64 @@
+#include "IntegrationBenchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "RigidBody/RigidBody.h"
+
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const char* GetName(IntegrationType type)
+    {
+        switch (type)
+        {
+        case IntegrationType::SemiImplicitEuler: return "SemiImplicitEuler";
+        case IntegrationType::Euler:             return "Euler";
+        case IntegrationType::Verlet:            return "Verlet";
+        }
+        return "Unknown";
+    }
+}
+
+void IntegrationBenchmark::Run(IntegrationType type, size_t bodyCount, int frames)
+{
+    constexpr float dt = 1.0f / 60.0f;
+
+    std::vector<std::unique_ptr<RigidBody>> bodies;
+    bodies.reserve(bodyCount);
+    for (size_t i = 0; i < bodyCount; ++i)
+    {
+        auto body = std::make_unique<RigidBody>();
+        body->SetTranslation(static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f);
+        body->SetVelocity(DirectX::XMVectorSet(1.0f, 0.0f, 0.5f, 0.0f));
+        body->SetAcceleration(DirectX::XMVectorSet(0.0f, -9.81f, 0.0f, 0.0f));
+        body->SetSimulated(true);
+        bodies.push_back(std::move(body));
+    }
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        for (const auto& body : bodies) body->Integrate(dt, type);
+    }
+    const double perBodyMs = ElapsedMs(start) / frames;
+
+    start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        RigidBodyPool::Get()->IntegrateAll(dt, type);
+    }
+    const double batchedMs = ElapsedMs(start) / frames;
+
+    std::printf("[Integrate] %s bodies=%zu per-body=%.3fms batched=%.3fms (avg of %d frames)\n",
+        GetName(type), bodyCount, perBodyMs, batchedMs, frames);
+}
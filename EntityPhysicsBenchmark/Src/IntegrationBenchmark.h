@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+
+#include "RigidBody/IntegrationType.h"
+
+
+namespace IntegrationBenchmark
+{
+    // Prints the cost of RigidBodyPool::IntegrateAll against integrating each body on its own
+    void Run(IntegrationType type, size_t bodyCount, int frames);
+}
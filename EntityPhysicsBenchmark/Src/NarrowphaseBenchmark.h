@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+
+
+namespace NarrowphaseBenchmark
+{
+    // Prints how many broadphase pairs per second the narrowphase turns into manifolds, next to
+    // the same pairs dispatched by casting each collider to its concrete type (the reference).
+    void Run(size_t boxCount, int frames);
+}
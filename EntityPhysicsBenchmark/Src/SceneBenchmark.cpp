@@ -0,0 +1,152 @@
+#include "SceneBenchmark.h"
+
+#include <algorithm>
+
+#include "World/PhysicsWorld.h"
+
+
+namespace
+{
+    size_t CountSleeping(const std::vector<BenchmarkBox>& boxes)
+    {
+        return static_cast<size_t>(std::count_if(boxes.begin(), boxes.end(), [](const BenchmarkBox& box)
+        {
+            return box.Collider->GetColliderState() == ColliderState::Dynamic && box.Body->GetRestingState();
+        }));
+    }
+}
+
+SceneBenchmarkResult SceneBenchmark::Run(SceneType type, size_t boxCount, int frames, uint32_t threads)
+{
+    constexpr float dt = 1.0f / 60.0f;
+
+    BenchmarkScene scene = BenchmarkScene::Create(type, boxCount, 1337u);
+    std::vector<BenchmarkBox>& boxes = scene.GetBoxes();
+
+    //~ The step the PhysicsSystem runs, with its default settings
+    PhysicsWorld world{};
+    world.SetThreadCount(threads);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        world.AddObject(i, boxes[i].Collider.get());
+    }
+
+    SceneBenchmarkResult result{};
+    result.Scene = type;
+    result.Colliders = scene.GetCount();
+    result.Threads = world.GetThreadCount();
+    result.Frames = frames;
+    for (const BenchmarkBox& box : boxes)
+    {
+        if (box.Collider->GetColliderState() == ColliderState::Dynamic) ++result.DynamicBodies;
+    }
+
+    double stepMs = 0.0;
+    double contactPoints = 0.0;
+    size_t candidatePairs = 0;
+    size_t touchingPairs = 0;
+
+    //~ Timings and counters come from the world's own profiler, one record per step
+    const PhysicsProfiler& profiler = world.GetProfiler();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        world.Step(dt);
+
+        const PhysicsStepProfile& profile = *profiler.GetLatest();
+        result.IntegrateMs += profile.GetPhaseMs(PhysicsPhase::Integrate);
+        result.BroadphaseMs += profile.GetPhaseMs(PhysicsPhase::Broadphase);
+        result.NarrowphaseMs += profile.GetPhaseMs(PhysicsPhase::Narrowphase);
+        result.ResolveMs += profile.GetPhaseMs(PhysicsPhase::Solve);
+        result.PublishMs += profile.GetPhaseMs(PhysicsPhase::Publish);
+        result.MaxStepMs = (std::max)(result.MaxStepMs, static_cast<double>(profile.TotalMs));
+        stepMs += profile.TotalMs;
+
+        candidatePairs += profile.CandidatePairs;
+        touchingPairs += profile.TouchingPairs;
+        contactPoints += profile.Contacts;
+        result.TriggerEvents += world.GetTriggerEvents().size();
+
+        if (result.SettledFrame < 0 && CountSleeping(boxes) == result.DynamicBodies) result.SettledFrame = frame + 1;
+    }
+
+    result.ContactsPerSecond = stepMs > 0.0 ? contactPoints / (stepMs * 1e-3) : 0.0;
+
+    if (frames > 0)
+    {
+        result.IntegrateMs /= frames;
+        result.BroadphaseMs /= frames;
+        result.NarrowphaseMs /= frames;
+        result.ResolveMs /= frames;
+        result.PublishMs /= frames;
+        result.StepMs = stepMs / frames;
+        result.CandidatePairs = static_cast<double>(candidatePairs) / frames;
+        result.TouchingPairs = static_cast<double>(touchingPairs) / frames;
+        result.ContactPoints = contactPoints / frames;
+    }
+
+    result.SleepingBodies = CountSleeping(boxes);
+    return result;
+}
+
+int SceneBenchmark::Settle(SceneType type, size_t boxCount, int maxFrames)
+{
+    BenchmarkScene scene = BenchmarkScene::Create(type, boxCount, 1337u);
+    std::vector<BenchmarkBox>& boxes = scene.GetBoxes();
+
+    PhysicsWorld world{};
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        world.AddObject(i, boxes[i].Collider.get());
+    }
+
+    const size_t dynamicBodies = static_cast<size_t>(std::count_if(boxes.begin(), boxes.end(),
+        [](const BenchmarkBox& box) { return box.Collider->GetColliderState() == ColliderState::Dynamic; }));
+
+    for (int frame = 1; frame <= maxFrames; ++frame)
+    {
+        world.Step(1.0f / 60.0f);
+        if (CountSleeping(boxes) == dynamicBodies) return frame;
+    }
+    return -1;
+}
+
+void SceneBenchmark::Print(const SceneBenchmarkResult& result)
+{
+    std::printf("[Scene %s] bodies=%zu threads=%u integrate=%.3fms broadphase=%.3fms narrowphase=%.3fms resolve=%.3fms publish=%.3fms "
+        "step=%.3fms (max %.3fms) pairs=%.0f touching=%.0f contacts=%.0f %.2f Mcontacts/s triggerEvents=%zu sleeping=%zu "
+        "settled=%d%s (avg of %d frames)\n",
+        BenchmarkScene::GetName(result.Scene), result.DynamicBodies, result.Threads, result.IntegrateMs,
+        result.BroadphaseMs, result.NarrowphaseMs, result.ResolveMs, result.PublishMs, result.StepMs, result.MaxStepMs,
+        result.CandidatePairs, result.TouchingPairs, result.ContactPoints, result.ContactsPerSecond * 1e-6,
+        result.TriggerEvents, result.SleepingBodies, result.SettledFrame, result.IsAtRest() ? "" : " STILL MOVING",
+        result.Frames);
+}
+
+void SceneBenchmark::WriteJson(const std::vector<SceneBenchmarkResult>& results, std::FILE* file)
+{
+    std::fprintf(file, "{\n  \"benchmark\": \"EntityPhysics\",\n  \"results\": [");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const SceneBenchmarkResult& result = results[i];
+        std::fprintf(file, "%s\n    {\n", i == 0 ? "" : ",");
+        std::fprintf(file, "      \"scene\": \"%s\",\n", BenchmarkScene::GetName(result.Scene));
+        std::fprintf(file, "      \"dynamicBodies\": %zu,\n", result.DynamicBodies);
+        std::fprintf(file, "      \"colliders\": %zu,\n", result.Colliders);
+        std::fprintf(file, "      \"threads\": %u,\n", result.Threads);
+        std::fprintf(file, "      \"frames\": %d,\n", result.Frames);
+        std::fprintf(file, "      \"ms\": { \"integrate\": %.4f, \"broadphase\": %.4f, \"narrowphase\": %.4f, "
+            "\"resolve\": %.4f, \"publish\": %.4f, \"step\": %.4f, \"maxStep\": %.4f },\n",
+            result.IntegrateMs, result.BroadphaseMs, result.NarrowphaseMs, result.ResolveMs, result.PublishMs,
+            result.StepMs, result.MaxStepMs);
+        std::fprintf(file, "      \"pairs\": { \"candidate\": %.1f, \"touching\": %.1f },\n",
+            result.CandidatePairs, result.TouchingPairs);
+        std::fprintf(file, "      \"contacts\": %.1f,\n", result.ContactPoints);
+        std::fprintf(file, "      \"contactsPerSecond\": %.0f,\n", result.ContactsPerSecond);
+        std::fprintf(file, "      \"triggerEvents\": %zu,\n", result.TriggerEvents);
+        std::fprintf(file, "      \"sleepingBodies\": %zu,\n", result.SleepingBodies);
+        std::fprintf(file, "      \"settledFrame\": %d,\n", result.SettledFrame);
+        std::fprintf(file, "      \"atRest\": %s\n", result.IsAtRest() ? "true" : "false");
+        std::fprintf(file, "    }");
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+}
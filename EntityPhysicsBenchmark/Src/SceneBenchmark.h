@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "BenchmarkScene.h"
+
+
+// Timings and counters of one simulated scene. Times are milliseconds per step, counts are
+// per step averages unless noted otherwise.
+struct SceneBenchmarkResult
+{
+    SceneType Scene{ SceneType::Pyramids };
+    size_t DynamicBodies{ 0 };
+    size_t Colliders{ 0 };
+    uint32_t Threads{ 0 };
+    int Frames{ 0 };
+
+    //~ The PhysicsProfiler phases
+    double IntegrateMs{ 0.0 };      //~ collider updates, body integration and continuous collision
+    double BroadphaseMs{ 0.0 };
+    double NarrowphaseMs{ 0.0 };    //~ manifolds, contact and trigger caches
+    double ResolveMs{ 0.0 };        //~ islands, contact and constraint solving, sleeping
+    double PublishMs{ 0.0 };        //~ transforms, trigger events and the query world
+    double StepMs{ 0.0 };
+    double MaxStepMs{ 0.0 };
+
+    double CandidatePairs{ 0.0 };
+    double TouchingPairs{ 0.0 };
+    double ContactPoints{ 0.0 };
+    double ContactsPerSecond{ 0.0 };    //~ contact points solved per second of step time
+
+    size_t TriggerEvents{ 0 };      //~ enter / stay / exit over the whole run
+    size_t SleepingBodies{ 0 };     //~ at the end of the run
+    int SettledFrame{ -1 };         //~ first frame every dynamic body slept, -1 if that never happened
+
+    //~ Timings of a scene that is still moving at the end measure a collapsing heap, not the scene
+    bool IsAtRest() const { return SleepingBodies == DynamicBodies; }
+};
+
+namespace SceneBenchmark
+{
+    // Steps the scene 'frames' times at 60Hz through a PhysicsWorld, the step the PhysicsSystem
+    // runs, on 'threads' threads (0 for every hardware thread). Phase times and counters are
+    // the world's PhysicsProfiler records, SettledFrame and SleepingBodies whether it came to rest.
+    SceneBenchmarkResult Run(SceneType type, size_t boxCount, int frames, uint32_t threads);
+
+    void Print(const SceneBenchmarkResult& result);
+
+    // Steps the scene until every dynamic body sleeps, at most 'maxFrames' times. Returns the
+    // frames it took, -1 when something was still moving. Stacks that never come to rest
+    // jitter, drift and keep the whole island awake.
+    int Settle(SceneType type, size_t boxCount, int maxFrames);
+
+    // One JSON document with every result, for tracking the numbers over time
+    void WriteJson(const std::vector<SceneBenchmarkResult>& results, std::FILE* file);
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Src/BroadphaseBenchmark.h"
+#include "Src/IntegrationBenchmark.h"
+#include "Src/NarrowphaseBenchmark.h"
+#include "Src/SceneBenchmark.h"
+
+
+namespace
+{
+    constexpr std::array<SceneType, 4> Scenes{
+        SceneType::Pyramids, SceneType::RandomPile, SceneType::SparseField, SceneType::TriggerGrid };
+
+    struct Options
+    {
+        const char* JsonPath{ nullptr };    //~ "-" for stdout
+        const char* Scene{ nullptr };       //~ every scene when null
+        size_t Boxes{ 0 };                  //~ 1000 and 5000 when 0
+        int Frames{ 300 };
+        uint32_t Threads{ 0 };
+    };
+
+    void PrintUsage()
+    {
+        std::printf("Usage: EntityPhysicsBenchmark [--json <file|->] [--scene <name>] [--boxes <n>] [--frames <n>] [--threads <n>]\n"
+            "  Without --json the component benchmarks run first and everything is printed as text.\n"
+            "  With --json only the scenes run and their results are written as one JSON document.\n"
+            "  The exit code is 1 when a broadphase pair count differs from brute force or a pyramid\n"
+            "  with its box stack does not come to rest, in the settle check or (runs of at least\n"
+            "  300 frames) in the Pyramids scene.\n"
+            "  Scenes: Pyramids, RandomPile, SparseField, TriggerGrid\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* option = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (!value) return false;
+
+            if (std::strcmp(option, "--json") == 0) outOptions.JsonPath = value;
+            else if (std::strcmp(option, "--scene") == 0) outOptions.Scene = value;
+            else if (std::strcmp(option, "--boxes") == 0) outOptions.Boxes = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(option, "--frames") == 0) outOptions.Frames = std::atoi(value);
+            else if (std::strcmp(option, "--threads") == 0) outOptions.Threads = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else return false;
+            ++i;
+        }
+        return outOptions.Frames > 0;
+    }
+
+    //~ Frames the Pyramids scene gets to fall asleep, shorter runs are not held to it
+    constexpr int SettleFrames = 300;
+
+    //~ False when a Pyramids run long enough to settle ended with bodies still moving
+    bool PyramidsAtRest(const std::vector<SceneBenchmarkResult>& results, int frames)
+    {
+        if (frames < SettleFrames) return true;
+
+        bool atRest = true;
+        for (const SceneBenchmarkResult& result : results)
+        {
+            if (result.Scene != SceneType::Pyramids || result.IsAtRest()) continue;
+            std::fprintf(stderr, "Pyramids with %zu bodies still moving after %d frames (%zu asleep)\n",
+                result.DynamicBodies, result.Frames, result.SleepingBodies);
+            atRest = false;
+        }
+        return atRest;
+    }
+
+    bool IsScene(const char* name)
+    {
+        return std::any_of(Scenes.begin(), Scenes.end(),
+            [name](SceneType scene) { return std::strcmp(name, BenchmarkScene::GetName(scene)) == 0; });
+    }
+
+    //~ One pyramid and its ten box stack must fall asleep, stacks that never settle are a solver bug
+    bool RunSettleCheck()
+    {
+        constexpr int maxFrames = 600;
+        const int frames = SceneBenchmark::Settle(SceneType::Pyramids, 65, maxFrames);
+        if (frames < 0)
+        {
+            std::printf("[Settle Pyramids] still moving after %d frames\n", maxFrames);
+            return false;
+        }
+        std::printf("[Settle Pyramids] asleep after %d frames\n", frames);
+        return true;
+    }
+
+    //~ False when a broadphase disagreed with brute force
+    bool RunComponentBenchmarks()
+    {
+        bool pairsMatch = true;
+        constexpr std::array<size_t, 3> boxCounts{ 1000, 10000, 50000 };
+        constexpr std::array<BroadphaseType, 2> broadphases{ BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree };
+
+        //~ Everything moving, then a level-like mix of static ground pieces and few dynamic bodies
+        constexpr std::array<float, 2> staticFractions{ 0.0f, 0.9f };
+
+        for (const float staticFraction : staticFractions)
+        {
+            for (const size_t boxCount : boxCounts)
+            {
+                for (const BroadphaseType type : broadphases)
+                {
+                    if (!BroadphaseBenchmark::Run(type, boxCount, staticFraction, 60)) pairsMatch = false;
+                }
+            }
+        }
+
+        constexpr std::array<IntegrationType, 3> integrators{
+            IntegrationType::SemiImplicitEuler, IntegrationType::Euler, IntegrationType::Verlet };
+        for (const IntegrationType type : integrators)
+        {
+            IntegrationBenchmark::Run(type, 10000, 60);
+        }
+
+        NarrowphaseBenchmark::Run(10000, 60);
+        return pairsMatch;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options{};
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+    if (options.Scene && !IsScene(options.Scene))
+    {
+        std::fprintf(stderr, "No scene called %s\n", options.Scene);
+        return 1;
+    }
+
+    const bool json = options.JsonPath != nullptr;
+    bool componentsPassed = true;
+    if (!json)
+    {
+        std::printf("EntityPhysics Benchmark\n");
+        componentsPassed = RunComponentBenchmarks();
+        if (!RunSettleCheck()) componentsPassed = false;
+    }
+
+    std::vector<size_t> boxCounts{ 1000, 5000 };
+    if (options.Boxes > 0) boxCounts = { options.Boxes };
+
+    std::vector<SceneBenchmarkResult> results;
+    for (const SceneType scene : Scenes)
+    {
+        if (options.Scene && std::strcmp(options.Scene, BenchmarkScene::GetName(scene)) != 0) continue;
+
+        for (const size_t boxCount : boxCounts)
+        {
+            results.push_back(SceneBenchmark::Run(scene, boxCount, options.Frames, options.Threads));
+            if (!json) SceneBenchmark::Print(results.back());
+        }
+    }
+
+    const bool scenesPassed = PyramidsAtRest(results, options.Frames);
+    if (!json) return componentsPassed && scenesPassed ? 0 : 1;
+
+    std::FILE* file = std::strcmp(options.JsonPath, "-") == 0 ? stdout : std::fopen(options.JsonPath, "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "Cannot write %s\n", options.JsonPath);
+        return 1;
+    }
+    SceneBenchmark::WriteJson(results, file);
+    if (file != stdout) std::fclose(file);
+    return scenesPassed ? 0 : 1;
+}
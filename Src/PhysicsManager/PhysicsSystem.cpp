@@ -1,16 +1,73 @@
 #include "PhysicsSystem.h"
-#include <ranges>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 #include "Utils/Logger/Logger.h"
 
 bool PhysicsSystem::OnInit(const SweetLoader& sweetLoader)
 {
+	if (!sweetLoader.Contains("Physics")) return true;
+
+	const SweetLoader& physics = sweetLoader["Physics"];
+	if (physics.Contains("FixedTimeStep")) SetFixedTimeStep(physics["FixedTimeStep"].AsBool());
+	if (physics.Contains("StepRate")) SetStepRate(physics["StepRate"].AsFloat());
+	if (physics.Contains("MaxSubSteps")) SetMaxSubSteps(static_cast<uint32_t>(physics["MaxSubSteps"].AsInt()));
+	if (physics.Contains("Deterministic")) SetDeterministic(physics["Deterministic"].AsBool());
+	if (physics.Contains("Profiling")) SetProfiling(physics["Profiling"].AsBool());
+	if (physics.Contains("SpeculativeMargin")) SetSpeculativeMargin(physics["SpeculativeMargin"].AsFloat());
+
+	if (physics.Contains("CollisionMatrix"))
+	{
+		CollisionMatrix matrix = m_World.GetCollisionMatrix();
+		for (const auto& [key, row] : physics["CollisionMatrix"])
+		{
+			const unsigned long layer = std::strtoul(key.c_str(), nullptr, 10);
+			if (layer >= CollisionMatrix::LayerCount)
+			{
+				LOG_ERROR("CollisionMatrix: no layer " + key);
+				continue;
+			}
+			matrix.SetRow(static_cast<uint8_t>(layer),
+				static_cast<uint32_t>(std::strtoul(row.GetValue().c_str(), nullptr, 0)));
+		}
+		m_World.SetCollisionMatrix(matrix);
+	}
 	return true;
 }
 
 bool PhysicsSystem::OnFrameUpdate(float deltaTime)
 {
-	Update(deltaTime);
+	TransformSnapshot& snapshot = RigidBodyPool::Get()->GetSnapshot();
+	if (!m_FixedTimeStep && !m_World.IsDeterministic())
+	{
+		m_World.Step(deltaTime);
+		m_InterpolationAlpha = 1.0f;
+		snapshot.SetInterpolationAlpha(m_InterpolationAlpha);
+		return true;
+	}
+
+	const float step = 1.0f / m_StepRate;
+	m_Accumulator += deltaTime;
+
+	uint32_t subSteps = 0;
+	while (m_Accumulator >= step && subSteps < m_MaxSubSteps)
+	{
+		m_World.Step(step);
+		m_Accumulator -= step;
+		++subSteps;
+	}
+
+	//~ Could not keep up (or the frame stalled), drop the backlog instead of
+	//~ spending even longer catching up next frame
+	if (m_Accumulator >= step)
+	{
+		m_Accumulator = std::fmod(m_Accumulator, step);
+	}
+
+	m_InterpolationAlpha = m_Accumulator / step;
+	snapshot.SetInterpolationAlpha(m_InterpolationAlpha);
 	return true;
 }
 
@@ -21,6 +78,26 @@ bool PhysicsSystem::OnFrameEnd()
 
 bool PhysicsSystem::OnExit(SweetLoader& sweetLoader)
 {
+	SweetLoader& physics = sweetLoader.GetOrCreate("Physics");
+	physics.GetOrCreate("FixedTimeStep") = m_FixedTimeStep ? "true" : "false";
+	physics.GetOrCreate("StepRate") = std::to_string(m_StepRate);
+	physics.GetOrCreate("MaxSubSteps") = std::to_string(m_MaxSubSteps);
+	physics.GetOrCreate("Deterministic") = m_World.IsDeterministic() ? "true" : "false";
+	physics.GetOrCreate("Profiling") = IsProfiling() ? "true" : "false";
+	physics.GetOrCreate("SpeculativeMargin") = std::to_string(GetSpeculativeMargin());
+
+	//~ Only rows that filter something, plus rows the file already had
+	const bool hadMatrix = physics.Contains("CollisionMatrix");
+	for (uint8_t layer = 0; layer < CollisionMatrix::LayerCount; ++layer)
+	{
+		const uint32_t mask = GetCollisionMatrix().GetMask(layer);
+		const std::string key = std::to_string(layer);
+		if (mask == CollisionMatrix::AllLayers && !(hadMatrix && physics["CollisionMatrix"].Contains(key))) continue;
+
+		char text[16];
+		std::snprintf(text, sizeof(text), "0x%08X", mask);
+		physics.GetOrCreate("CollisionMatrix").GetOrCreate(key) = text;
+	}
 	return true;
 }
 
@@ -31,80 +108,74 @@ std::string PhysicsSystem::GetSystemName()
 
 bool PhysicsSystem::AddObject(IRender* renderObj)
 {
-	ID id = renderObj->GetAssignedID();
-	if (m_RenderedObjects.contains(id)) return false;
-	m_RenderedObjects[id] = renderObj;
-	return true;
+	const PhysicsHandle handle = renderObj->GetPhysicsHandle();
+	if (!PhysicsObjectPool::Get()->GetRigidBody(handle)) return false;
+	return m_World.AddObject(renderObj->GetAssignedID(), PhysicsObjectPool::Get()->GetCollider(handle));
 }
 
 bool PhysicsSystem::RemoveObject(const IRender* renderObj)
 {
-	ID id = renderObj->GetAssignedID();
-
-	if (m_RenderedObjects.contains(id)) return RemoveObject(id);
-	return false;
+	return RemoveObject(renderObj->GetAssignedID());
 }
 
 bool PhysicsSystem::RemoveObject(ID renderObjID)
 {
-	if (m_RenderedObjects.contains(renderObjID))
-	{
-		m_RenderedObjects.erase(renderObjID);
-		return true;
-	}
-	return false;
+	return m_World.RemoveObject(renderObjID);
 }
 
 void PhysicsSystem::Clear()
 {
-	m_RenderedObjects.clear();
+	m_World.Clear();
 }
 
-void PhysicsSystem::SetIntegration(IntegrationType type)
+bool PhysicsSystem::RestoreState(const std::vector<uint8_t>& state)
 {
-	m_IntegrationType = type;
+	if (m_World.RestoreState(state)) return true;
+
+	LOG_ERROR("PhysicsSystem: state buffer is corrupt or was saved with other objects or constraints");
+	return false;
 }
 
-void PhysicsSystem::Update(float deltaTime)
+void PhysicsSystem::Step()
 {
-	std::vector<ICollider*> colliders;
+	m_World.Step(1.0f / m_StepRate);
+}
 
-	for (auto& obj: m_RenderedObjects | std::views::values)
-	{
-		ICollider* collider = obj->GetCubeCollider();
-		if (!collider) continue;
+void PhysicsSystem::SetFixedTimeStep(bool enabled)
+{
+	m_FixedTimeStep = enabled;
+	m_Accumulator = 0.0f;
+}
 
-		//~ Update Collider and cache
-		collider->Update(deltaTime);
-		colliders.push_back(collider);
+void PhysicsSystem::SetStepRate(float stepsPerSecond)
+{
+	if (stepsPerSecond <= 0.0f)
+	{
+		LOG_WARNING("Ignoring non positive physics step rate");
+		return;
+	}
+	m_StepRate = stepsPerSecond;
+}
 
-		//~ Update Rigid Body
-		RigidBody* body = collider->GetRigidBody();
-		if (!body) continue;
+void PhysicsSystem::SetMaxSubSteps(uint32_t count)
+{
+	m_MaxSubSteps = (std::max)(count, 1u);
+}
 
-		body->Integrate(deltaTime, m_IntegrationType);
+void PhysicsSystem::LogProfile(size_t steps) const
+{
+	const PhysicsProfiler& profiler = m_World.GetProfiler();
+	steps = (std::min)(steps, profiler.GetRecordCount());
+	if (steps == 0)
+	{
+		LOG_WARNING("PhysicsSystem: no profiled steps to log");
+		return;
 	}
 
-	// === Collision Detection ===
-	std::vector<Contact> contacts;
-	for (size_t i = 0; i < colliders.size(); ++i)
+	for (size_t i = profiler.GetRecordCount() - steps; i < profiler.GetRecordCount(); ++i)
 	{
-		for (size_t j = i + 1; j < colliders.size(); ++j)
-		{
-			ICollider* colliderA = colliders[i];
-			ICollider* colliderB = colliders[j];
-
-			if (!colliderA || !colliderB) continue;
-
-			Contact contact;
-			if (colliderA->CheckCollision(colliderB, contact))
-			{
-				colliderA->RegisterCollision(colliderB);
-				contacts.push_back(contact);
-			}
-		}
+		LOG_PRINT(PhysicsProfiler::ToString(profiler.GetRecord(i)));
 	}
-
-	// === Contact Resolution ===
-	CollisionResolver::ResolveContacts(contacts, deltaTime);
+	LOG_INFO("Physics average over " + std::to_string(steps) + " steps, "
+		+ PhysicsProfiler::ToString(profiler.GetAverage(steps)));
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+
 #include "EntityPhysics.h"
 #include "RenderManager/IRender.h"
 #include "SystemManager/ISystem.h"
@@ -26,12 +28,112 @@ public:
 	bool RemoveObject(ID renderObjID);
 	void Clear();
 
-	void SetIntegration(IntegrationType type);
+	//~ Joints between bodies, solved along with the contacts. The caller owns the constraint and
+	//~ keeps it alive until it is removed again (or Clear); it is skipped while either of its
+	//~ bodies is not in the system.
+	bool AddConstraint(Constraint* constraint) { return m_World.AddConstraint(constraint); }
+	bool RemoveConstraint(const Constraint* constraint) { return m_World.RemoveConstraint(constraint); }
+	const std::vector<Constraint*>& GetConstraints() const { return m_World.GetConstraints(); }
 
-private:
-	void Update(float deltaTime);
+	void SetIntegration(IntegrationType type) { m_World.SetIntegration(type); }
+	void SetBroadphase(BroadphaseType type) { m_World.SetBroadphase(type); }
+
+	//~ Layer vs layer filter applied by the broadphase, loaded from "Physics" / "CollisionMatrix"
+	//~ in the config as { "<layer>": "<hex mask of the layers it collides with>" }
+	void SetLayerCollision(uint8_t layerA, uint8_t layerB, bool collides) { m_World.SetLayerCollision(layerA, layerB, collides); }
+	bool GetLayerCollision(uint8_t layerA, uint8_t layerB) const { return m_World.GetLayerCollision(layerA, layerB); }
+	const CollisionMatrix& GetCollisionMatrix() const { return m_World.GetCollisionMatrix(); }
+
+	//~ Threads used by the step (including the calling one), 0 = every hardware thread.
+	//~ The result of a step does not depend on this.
+	void SetThreadCount(uint32_t count) { m_World.SetThreadCount(count); }
+
+	//~ Fixed step: the frame time is banked and spent in steps of 1 / stepRate, at most
+	//~ maxSubSteps per frame. Variable step feeds the frame time straight into one step.
+	void SetFixedTimeStep(bool enabled);
+	void SetStepRate(float stepsPerSecond);
+	void SetMaxSubSteps(uint32_t count);
+	bool IsFixedTimeStep() const { return m_FixedTimeStep; }
+	float GetStepRate() const { return m_StepRate; }
+	uint32_t GetMaxSubSteps() const { return m_MaxSubSteps; }
+
+	//~ Same inputs, same results bit for bit (within one build): pairs are solved in a fixed
+	//~ order (by body slot) rather than the broadphase's, and only fixed steps are taken
+	void SetDeterministic(bool enabled) { m_World.SetDeterministic(enabled); }
+	bool IsDeterministic() const { return m_World.IsDeterministic(); }
+
+	//~ Speculative contacts: moving colliders get contact points up to 'margin' plus one step of
+	//~ travel before they touch, and the solver lets such a pair close only its gap, so fast
+	//~ bodies stop at the surface instead of sinking in and being pushed back out. A pair about to
+	//~ close its gap within the step bounces already, so a bouncy body turns around up to one step
+	//~ of travel short of the surface. 0 turns it off.
+	void SetSpeculativeMargin(float margin) { m_World.SetSpeculativeMargin(margin); }
+	float GetSpeculativeMargin() const { return m_World.GetSpeculativeMargin(); }
+
+	//~ Rollback: bodies, sleeping islands, cached contacts and constraint impulses (warm starting)
+	//~ and trigger pairs in one flat buffer, a few array copies each way. A state restores only
+	//~ while the same objects and constraints are in the system as when it was saved; anything
+	//~ else returns false and leaves the system as it was.
+	void SaveState(std::vector<uint8_t>& outState) const { m_World.SaveState(outState); }
+	bool RestoreState(const std::vector<uint8_t>& state);
+
+	//~ One step of 1 / StepRate outside the frame clock, to re-simulate after RestoreState
+	void Step();
+
+	//~ How far the frame is into the next step (0..1), used to blend the rendered poses
+	float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
+	//~ Scene queries against the last completed step, safe to call from any thread (also while
+	//~ a step runs). 'layerMask' selects colliders by ICollider::GetLayerMask. See QueryWorld.
+	bool Raycast(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+		RaycastHit& outHit, uint32_t layerMask = ICollider::AllLayers) const
+	{
+		return m_World.Raycast(origin, direction, maxDistance, outHit, layerMask);
+	}
+	size_t RaycastAll(const DirectX::XMVECTOR& origin, const DirectX::XMVECTOR& direction, float maxDistance,
+		std::vector<RaycastHit>& outHits, uint32_t layerMask = ICollider::AllLayers) const
+	{
+		return m_World.RaycastAll(origin, direction, maxDistance, outHits, layerMask);
+	}
+	bool SphereCast(const DirectX::XMVECTOR& origin, float radius, const DirectX::XMVECTOR& direction,
+		float maxDistance, RaycastHit& outHit, uint32_t layerMask = ICollider::AllLayers) const
+	{
+		return m_World.SphereCast(origin, radius, direction, maxDistance, outHit, layerMask);
+	}
+	size_t OverlapBox(const DirectX::XMVECTOR& center, const DirectX::XMVECTOR& halfExtents,
+		const DirectX::XMVECTOR& orientation, std::vector<ICollider*>& outColliders,
+		uint32_t layerMask = ICollider::AllLayers) const
+	{
+		return m_World.OverlapBox(center, halfExtents, orientation, outColliders, layerMask);
+	}
+
+	//~ Trigger enter / stay / exit events of the last step; SetTriggerTarget callbacks have already run
+	const std::vector<TriggerEvent>& GetTriggerEvents() const { return m_World.GetTriggerEvents(); }
+
+	//~ Holding on to the snapshot keeps several queries consistent with each other
+	std::shared_ptr<const QueryWorld> GetQueryWorld() const { return m_World.GetQueryWorld(); }
+
+	//~ Phase timings and counters of the last PhysicsProfiler::Capacity steps, on by default
+	//~ ("Physics" / "Profiling" in the config). Read them from the thread that runs the frames.
+	void SetProfiling(bool enabled) { m_World.GetProfiler().SetEnabled(enabled); }
+	bool IsProfiling() const { return m_World.GetProfiler().IsEnabled(); }
+	const PhysicsProfiler& GetProfiler() const { return m_World.GetProfiler(); }
+
+	//~ Writes the newest 'steps' records, then their average, through the logger
+	void LogProfile(size_t steps = 60) const;
+
+	//~ The simulation itself, what every step runs
+	PhysicsWorld& GetWorld() { return m_World; }
+	const PhysicsWorld& GetWorld() const { return m_World; }
 
 private:
-	IntegrationType m_IntegrationType{ IntegrationType::SemiImplicitEuler };
-	std::unordered_map<ID, IRender*> m_RenderedObjects{};
+	//~ Stepping
+	bool m_FixedTimeStep{ true };
+	float m_StepRate{ 60.0f };
+	uint32_t m_MaxSubSteps{ 5 };
+	float m_Accumulator{ 0.0f };
+	float m_InterpolationAlpha{ 1.0f };
+
+	//~ Objects are kept under their render ID
+	PhysicsWorld m_World{};
 };
@@ -1,11 +1,16 @@
 #include "IRender.h"
 
 IRender::IRender()
+	: m_PhysicsHandle(PhysicsObjectPool::Get()->Create(ColliderType::Cube))
 {
-	m_CubeCollider = std::make_unique<CubeCollider>(&m_RigidBody);
 	m_bDirty = true;
 }
 
+IRender::~IRender()
+{
+	PhysicsObjectPool::Get()->Destroy(m_PhysicsHandle);
+}
+
 bool IRender::Build(ID3D11Device* device, ID3D11DeviceContext* deviceContext)
 {
 	if (!m_bCommonDataInitialized)
@@ -33,7 +38,7 @@ bool IRender::Render(ID3D11DeviceContext* deviceContext)
 
 	if (m_LightEnabled)
 	{
-		m_LightManager.Update(deviceContext, m_RigidBody.GetPosition());
+		m_LightManager.Update(deviceContext, GetRigidBody()->GetPosition());
 		m_LightManager.Bind(deviceContext);
 	}
 	m_ShaderResources.Render(deviceContext);
@@ -76,12 +81,24 @@ void IRender::RemoveLight(ILightSource* lightSource) const
 
 CubeCollider* IRender::GetCubeCollider() const
 {
-	return m_CubeCollider.get();
+	ICollider* collider = GetCollider();
+	if (!collider || collider->GetColliderType() != ColliderType::Cube) return nullptr;
+	return static_cast<CubeCollider*>(collider);
+}
+
+ICollider* IRender::GetCollider() const
+{
+	return PhysicsObjectPool::Get()->GetCollider(m_PhysicsHandle);
+}
+
+void IRender::SetColliderType(ColliderType type)
+{
+	PhysicsObjectPool::Get()->SetColliderType(m_PhysicsHandle, type);
 }
 
-RigidBody* IRender::GetRigidBody()
+RigidBody* IRender::GetRigidBody() const
 {
-	return &m_RigidBody;
+	return PhysicsObjectPool::Get()->GetRigidBody(m_PhysicsHandle);
 }
 
 void IRender::SetScale(float x, float y, float z)
@@ -251,7 +268,7 @@ DirectX::XMMATRIX IRender::GetNormalTransform() const
 	using namespace DirectX;
 
 	XMMATRIX scaleMat = XMMatrixScaling(m_Scale.x, m_Scale.y, m_Scale.z);
-	XMMATRIX rotMat = m_RigidBody.GetOrientation().ToRotationMatrix();
+	XMMATRIX rotMat = GetRigidBody()->GetRenderTransform().ToRotationMatrix();
 
 	XMMATRIX worldMat = scaleMat * rotMat;
 	XMMATRIX normalMat = XMMatrixTranspose(XMMatrixInverse(nullptr, worldMat));
@@ -7,10 +7,9 @@
 #include <memory>
 #include <d3d11.h>
 
-#include "Collision/Cube/CubeCollider.h"
 #include "Components/ShaderResource/ShaderResource.h"
 #include "Light/LightManager.h"
-#include "RigidBody/RigidBody.h"
+#include "PhysicsObject/PhysicsObjectPool.h"
 
 
 typedef struct CAMERA_INFORMATION_CPU_DESC
@@ -61,7 +60,7 @@ class IRender: public PrimaryID
 {
 public:
 	IRender();
-	virtual ~IRender()					= default;
+	virtual ~IRender();
 	IRender(const IRender&)				= delete;
 	IRender(IRender&&)					= delete;
 	IRender& operator=(const IRender&)	= delete;
@@ -81,9 +80,14 @@ public:
 	void AddLight(ILightSource* lightSource) const;
 	void RemoveLight(ILightSource* lightSource) const;
 
-	//~ TODO: no time to think or create skeleton class for now (sorry my ego who wanted to code it dynamically)
+	//~ Body and collider live in the PhysicsObjectPool, this object only keeps their handle
+	PhysicsHandle GetPhysicsHandle() const { return m_PhysicsHandle; }
 	CubeCollider* GetCubeCollider() const;
-	RigidBody* GetRigidBody();
+	ICollider* GetCollider() const;
+	RigidBody* GetRigidBody() const;
+
+	//~ Swaps the collider shape, keeping its state and scale. Call before adding to the PhysicsSystem.
+	void SetColliderType(ColliderType type);
 
 	// ---- Scale ----
 	void SetScale(float x, float y, float z);
@@ -134,8 +138,7 @@ protected:
 	//~ Body Specifics
 	bool m_bTransparent{ false };
 	bool m_bDirty{ false };
-	RigidBody m_RigidBody{};
-	std::unique_ptr<CubeCollider> m_CubeCollider{ nullptr };
+	PhysicsHandle m_PhysicsHandle{};
 
 	//~ Light and Shaders
 	bool m_LightEnabled{ true };
@@ -19,11 +19,12 @@ void IModel::SetWorldMatrixData(const CAMERA_INFORMATION_DESC& cameraInfo)
 {
 	// Get transform components
 	DirectX::XMFLOAT3 scale = GetScale();
-	DirectX::XMFLOAT3 translation = m_RigidBody.GetTranslation();
+	const BodyTransform transform = GetRigidBody()->GetRenderTransform();
+	DirectX::XMFLOAT3 translation = transform.Position;
 
 	// Build transformation matrix
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
-	DirectX::XMMATRIX R = m_RigidBody.GetOrientation().ToRotationMatrix();
+	DirectX::XMMATRIX R = transform.ToRotationMatrix();
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(translation.x, translation.y, translation.z);
 
 	DirectX::XMMATRIX worldMatrix = DirectX::XMMatrixTranspose(S * R * T);
@@ -142,6 +142,9 @@ bool RenderQueueSingleton::Update(UINT width, UINT height)
     m_ScreenHeight = height;
     m_ScreenWidth = width;
 
+    //~ Take the latest physics step, every render below reads this snapshot
+    RigidBodyPool::Get()->GetSnapshot().AcquireLatest();
+
     //~ Update Objects on Space
     CAMERA_INFORMATION_CPU_DESC cb{};
     cb.ViewMatrix = XMMatrixTranspose(m_CameraController->GetViewMatrix());
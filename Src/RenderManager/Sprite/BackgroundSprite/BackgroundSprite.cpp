@@ -13,7 +13,8 @@ BackgroundSprite::BackgroundSprite()
 void BackgroundSprite::SetWorldMatrixData(const CAMERA_INFORMATION_DESC& cameraInfo)
 {
 	// Optional scale/rotation in clip-space
-	DirectX::XMMATRIX R = DirectX::XMMatrixRotationZ(m_RigidBody.GetYaw());
+	const BodyTransform transform = GetRigidBody()->GetRenderTransform();
+	DirectX::XMMATRIX R = DirectX::XMMatrixRotationZ(RigidBody::QuaternionToEuler(transform.ToQuaternion()).y);
 
 	// Translation not needed if vertices are in NDC
 	DirectX::XMMATRIX worldMatrix = DirectX::XMMatrixTranspose(R);
@@ -58,8 +59,8 @@ bool BackgroundSprite::Render(ID3D11DeviceContext* deviceContext)
 
 void BackgroundSprite::UpdateVertexBuffer(ID3D11DeviceContext* deviceContext)
 {
-	float posX = m_RigidBody.GetTranslation().x;
-	float posY = m_RigidBody.GetTranslation().y;
+	float posX = GetRigidBody()->GetTranslation().x;
+	float posY = GetRigidBody()->GetTranslation().y;
 
 	if (!m_bDirty && posX == m_LastX && posY == m_LastY)
 	{
@@ -87,8 +88,8 @@ void BackgroundSprite::UpdateVertexBuffer(ID3D11DeviceContext* deviceContext)
 	float bottomPixels = -halfScreenHeight * m_DownPercent;
 
 	// World space position offset
-	float centerX = m_RigidBody.GetTranslation().x;
-	float centerY = m_RigidBody.GetTranslation().y;
+	float centerX = GetRigidBody()->GetTranslation().x;
+	float centerY = GetRigidBody()->GetTranslation().y;
 
 	// Final positions in pixels
 	float left = centerX + leftPixels;
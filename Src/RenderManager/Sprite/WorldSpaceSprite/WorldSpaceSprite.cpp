@@ -50,11 +50,12 @@ void WorldSpaceSprite::SetWorldMatrixData(const CAMERA_INFORMATION_DESC& cameraI
 {
 	// Get transform components
 	DirectX::XMFLOAT3 scale = GetScale();
-	DirectX::XMFLOAT3 translation = m_RigidBody.GetTranslation();
+	const BodyTransform transform = GetRigidBody()->GetRenderTransform();
+	DirectX::XMFLOAT3 translation = transform.Position;
 
 	// Build transformation matrix
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
-	DirectX::XMMATRIX R = DirectX::XMMatrixRotationZ(m_RigidBody.GetYaw());
+	DirectX::XMMATRIX R = DirectX::XMMatrixRotationZ(RigidBody::QuaternionToEuler(transform.ToQuaternion()).y);
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(translation.x, translation.y, translation.z);
 
 	DirectX::XMMATRIX worldMatrix = DirectX::XMMatrixTranspose(S * R * T);